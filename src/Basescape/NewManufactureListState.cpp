@@ -188,35 +188,7 @@ void NewManufactureListState::lstProdClickRight(Action *)
 	{
 		// display either category or requirements
 		_showRequirements = !_showRequirements;
-		auto baseFunc = _base->getProvidedBaseFunc({});
-
-		for (size_t row = 0; row < _lstManufacture->getTexts(); ++row)
-		{
-			RuleManufacture *info = _game->getMod()->getManufacture(_displayedStrings[row]);
-			if (info)
-			{
-				if (_showRequirements)
-				{
-					std::ostringstream ss;
-					int count = 0;
-					std::vector<std::string> missed = _game->getMod()->getBaseFunctionNames(~baseFunc & info->getRequireBaseFunc());
-					for (const auto& name : missed)
-					{
-						if (count > 0)
-						{
-							ss << ", ";
-						}
-						ss << tr(name);
-						count++;
-					}
-					_lstManufacture->setCellText(row, 1, ss.str().c_str());
-				}
-				else
-				{
-					_lstManufacture->setCellText(row, 1, tr(info->getCategory()));
-				}
-			}
-		}
+		updateProductionList();
 	}
 	else
 	{
@@ -364,9 +336,9 @@ void NewManufactureListState::fillProductionList(bool refreshCategories)
 	ManufacturingFilterType basicFilter = (ManufacturingFilterType)(_cbxFilter->getSelected());
 	_game->getSavedGame()->getAvailableProductions(_possibleProductions, _game->getMod(), _base, basicFilter);
 	_displayedStrings.clear();
+	_displayedSupplies.clear();
 
 	ItemContainer * itemContainer (_base->getStorageItems());
-	int row = 0;
 	bool hasUnseen = false;
 	for (const auto* manuf : _possibleProductions)
 	{
@@ -435,29 +407,15 @@ void NewManufactureListState::fillProductionList(bool refreshCategories)
 				}
 			}
 
-			_lstManufacture->addRow(3, tr(manuf->getName()).c_str(), tr(manuf->getCategory()).c_str(), ss.str().c_str());
 			_displayedStrings.push_back(manuf->getName().c_str());
-
-			// colors
-			if (basicFilter == MANU_FILTER_FACILITY_REQUIRED)
+			_displayedSupplies.push_back(ss.str());
+			if (isNew && !isHidden && basicFilter != MANU_FILTER_FACILITY_REQUIRED)
 			{
-				_lstManufacture->setRowColor(row, _colorFacilityRequired);
+				hasUnseen = true;
 			}
-			else
-			{
-				if (isHidden)
-				{
-					_lstManufacture->setRowColor(row, _colorHidden);
-				}
-				else if (isNew)
-				{
-					_lstManufacture->setRowColor(row, _colorNew);
-					hasUnseen = true;
-				}
-			}
-			row++;
 		}
 	}
+	updateProductionList();
 
 	std::string label = tr("STR_SHOW_ONLY_NEW");
 	_btnShowOnlyNew->setText((hasUnseen ? "* " : "") + label);
@@ -498,4 +456,54 @@ void NewManufactureListState::fillProductionList(bool refreshCategories)
 	}
 }
 
+/**
+ * Updates the rows of the list of possible productions.
+ * Mods can have thousands of them, so only the visible rows are created.
+ */
+void NewManufactureListState::updateProductionList()
+{
+	ManufacturingFilterType basicFilter = (ManufacturingFilterType)(_cbxFilter->getSelected());
+	auto baseFunc = _base->getProvidedBaseFunc({});
+	_lstManufacture->setVirtualRows(_displayedStrings.size(), [this, basicFilter, baseFunc](size_t row, TextListRow &out)
+	{
+		RuleManufacture *info = _game->getMod()->getManufacture(_displayedStrings[row]);
+		std::string second = tr(info->getCategory());
+		if (_showRequirements)
+		{
+			std::ostringstream ss;
+			int count = 0;
+			std::vector<std::string> missed = _game->getMod()->getBaseFunctionNames(~baseFunc & info->getRequireBaseFunc());
+			for (const auto& name : missed)
+			{
+				if (count > 0)
+				{
+					ss << ", ";
+				}
+				ss << tr(name);
+				count++;
+			}
+			second = ss.str();
+		}
+		out.cells = { tr(info->getName()), second, _displayedSupplies[row] };
+
+		// colors
+		if (basicFilter == MANU_FILTER_FACILITY_REQUIRED)
+		{
+			out.color = _colorFacilityRequired;
+		}
+		else
+		{
+			int status = _game->getSavedGame()->getManufactureRuleStatus(info->getName());
+			if (status == RuleManufacture::MANU_STATUS_HIDDEN)
+			{
+				out.color = _colorHidden;
+			}
+			else if (status == RuleManufacture::MANU_STATUS_NEW)
+			{
+				out.color = _colorNew;
+			}
+		}
+	});
+}
+
 }
@@ -52,7 +52,7 @@ private:
 	ComboBox *_cbxFilter;
 	std::vector<RuleManufacture *> _possibleProductions;
 	std::vector<std::string> _catStrings;
-	std::vector<std::string> _displayedStrings;
+	std::vector<std::string> _displayedStrings, _displayedSupplies;
 	Uint8 _colorNormal, _colorNew;
 	Uint8 _colorHidden, _colorFacilityRequired;
 
@@ -80,6 +80,8 @@ public:
 	void btnMarkAllAsSeenClick(Action *action);
 	/// Fills the list of possible productions.
 	void fillProductionList(bool refreshCategories);
+	/// Updates the rows of the list of possible productions.
+	void updateProductionList();
 };
 
 }
@@ -271,7 +271,6 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 	}
 	auto researchRuleIt = _projects.begin();
 	RuleResearch* rule = nullptr;
-	int row = 0;
 	bool hasUnseen = false;
 	while (researchRuleIt != _projects.end())
 	{
@@ -315,7 +314,6 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 		//  - for now, handling "requires" via zero-cost helpers (e.g. STR_LEADER_PLUS)... is enough
 		if (rule->getRequirements().empty())
 		{
-			_lstResearch->addRow(1, tr(rule->getName()).c_str());
 			if (markAllAsSeen)
 			{
 				// mark all (new) research items as normal
@@ -323,10 +321,8 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 			}
 			else if (_game->getSavedGame()->isResearchRuleStatusNew(rule->getName()))
 			{
-				_lstResearch->setRowColor(row, _colorNew);
 				hasUnseen = true;
 			}
-			row++;
 			++researchRuleIt;
 		}
 		else
@@ -335,6 +331,16 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 		}
 	}
 
+	// mods can have thousands of topics, only create the visible rows
+	_lstResearch->setVirtualRows(_projects.size(), [this](size_t row, TextListRow &out)
+	{
+		out.cells = { tr(_projects[row]->getName()) };
+		if (_game->getSavedGame()->isResearchRuleStatusNew(_projects[row]->getName()))
+		{
+			out.color = _colorNew;
+		}
+	});
+
 	std::string label = tr("STR_SHOW_ONLY_NEW");
 	_btnShowOnlyNew->setText((hasUnseen ? "* " : "") + label);
 	if (_lstScroll > 0)
@@ -659,11 +659,18 @@ void PurchaseState::updateList()
 			}
 		}
 
-		std::string name = _items[i].name;
+		_rows.push_back(i);
+	}
+
+	// large mods can have thousands of items, only create the visible rows
+	_lstItems->setVirtualRows(_rows.size(), [this](size_t row, TextListRow &out)
+	{
+		const TransferRow &item = _items[_rows[row]];
+		std::string name = item.name;
 		bool ammo = false;
-		if (_items[i].type == TRANSFER_ITEM)
+		if (item.type == TRANSFER_ITEM)
 		{
-			RuleItem *rule = (RuleItem*)_items[i].rule;
+			RuleItem *rule = (RuleItem*)item.rule;
 			ammo = (rule->getBattleType() == BT_AMMO || (rule->getBattleType() == BT_NONE && rule->getClipSize() > 0));
 			if (ammo)
 			{
@@ -671,19 +678,18 @@ void PurchaseState::updateList()
 			}
 		}
 		std::ostringstream ssQty, ssAmount;
-		ssQty << _items[i].qtySrc;
-		ssAmount << _items[i].amount;
-		_lstItems->addRow(4, name.c_str(), Unicode::formatFunding(_items[i].cost).c_str(), ssQty.str().c_str(), ssAmount.str().c_str());
-		_rows.push_back(i);
-		if (_items[i].amount > 0)
+		ssQty << item.qtySrc;
+		ssAmount << item.amount;
+		out.cells = { name, Unicode::formatFunding(item.cost), ssQty.str(), ssAmount.str() };
+		if (item.amount > 0)
 		{
-			_lstItems->setRowColor(_rows.size() - 1, _lstItems->getSecondaryColor());
+			out.color = _lstItems->getSecondaryColor();
 		}
 		else if (ammo)
 		{
-			_lstItems->setRowColor(_rows.size() - 1, _ammoColor);
+			out.color = _ammoColor;
 		}
-	}
+	});
 }
 
 /**
@@ -529,11 +529,18 @@ void SellState::updateList()
 			}
 		}
 
-		std::string name = _items[i].name;
+		_rows.push_back(i);
+	}
+
+	// large mods can have thousands of items, only create the visible rows
+	_lstItems->setVirtualRows(_rows.size(), [this, sellPriceCoefficient](size_t row, TextListRow &out)
+	{
+		const TransferRow &item = _items[_rows[row]];
+		std::string name = item.name;
 		bool ammo = false;
-		if (_items[i].type == TRANSFER_ITEM)
+		if (item.type == TRANSFER_ITEM)
 		{
-			RuleItem *rule = (RuleItem*)_items[i].rule;
+			RuleItem *rule = (RuleItem*)item.rule;
 			ammo = (rule->getBattleType() == BT_AMMO || (rule->getBattleType() == BT_NONE && rule->getClipSize() > 0));
 			if (ammo)
 			{
@@ -541,21 +548,20 @@ void SellState::updateList()
 			}
 		}
 		std::ostringstream ssQty, ssAmount;
-		ssQty << _items[i].qtySrc - _items[i].amount;
-		ssAmount << _items[i].amount;
-		int64_t adjustedCost = _items[i].cost;
+		ssQty << item.qtySrc - item.amount;
+		ssAmount << item.amount;
+		int64_t adjustedCost = item.cost;
 		adjustedCost = adjustedCost * sellPriceCoefficient / 100;
-		_lstItems->addRow(4, name.c_str(), ssQty.str().c_str(), ssAmount.str().c_str(), Unicode::formatFunding(adjustedCost).c_str());
-		_rows.push_back(i);
-		if (_items[i].amount > 0)
+		out.cells = { name, ssQty.str(), ssAmount.str(), Unicode::formatFunding(adjustedCost) };
+		if (item.amount > 0)
 		{
-			_lstItems->setRowColor(_rows.size() - 1, _lstItems->getSecondaryColor());
+			out.color = _lstItems->getSecondaryColor();
 		}
 		else if (ammo)
 		{
-			_lstItems->setRowColor(_rows.size() - 1, _ammoColor);
+			out.color = _ammoColor;
 		}
-	}
+	});
 }
 
 /**
@@ -459,14 +459,16 @@ void StoresState::sortList(ItemSort sort)
  */
 void StoresState::updateList()
 {
-	for (const auto& item : _itemList)
+	// large mods can have thousands of items, only create the visible rows
+	_lstStores->setVirtualRows(_itemList.size(), [this](size_t row, TextListRow &out)
 	{
+		const auto& item = _itemList[row];
 		std::ostringstream ss, ss2, ss3;
 		ss << item.quantity;
 		ss2 << item.size;
 		ss3 << item.spaceUsed;
-		_lstStores->addRow(4, item.name.c_str(), ss.str().c_str(), ss2.str().c_str(), ss3.str().c_str());
-	}
+		out.cells = { item.name, ss.str(), ss2.str(), ss3.str() };
+	});
 }
 
 /**
@@ -449,11 +449,18 @@ void TransferItemsState::updateList()
 			}
 		}
 
-		std::string name = _items[i].name;
+		_rows.push_back(i);
+	}
+
+	// large mods can have thousands of items, only create the visible rows
+	_lstItems->setVirtualRows(_rows.size(), [this](size_t row, TextListRow &out)
+	{
+		const TransferRow &item = _items[_rows[row]];
+		std::string name = item.name;
 		bool ammo = false;
-		if (_items[i].type == TRANSFER_ITEM)
+		if (item.type == TRANSFER_ITEM)
 		{
-			RuleItem *rule = (RuleItem*)_items[i].rule;
+			RuleItem *rule = (RuleItem*)item.rule;
 			ammo = (rule->getBattleType() == BT_AMMO || (rule->getBattleType() == BT_NONE && rule->getClipSize() > 0));
 			if (ammo)
 			{
@@ -461,20 +468,19 @@ void TransferItemsState::updateList()
 			}
 		}
 		std::ostringstream ssQtySrc, ssQtyDst, ssAmount;
-		ssQtySrc << _items[i].qtySrc - _items[i].amount;
-		ssQtyDst << _items[i].qtyDst;
-		ssAmount << _items[i].amount;
-		_lstItems->addRow(4, name.c_str(), ssQtySrc.str().c_str(), ssAmount.str().c_str(), ssQtyDst.str().c_str());
-		_rows.push_back(i);
-		if (_items[i].amount > 0)
+		ssQtySrc << item.qtySrc - item.amount;
+		ssQtyDst << item.qtyDst;
+		ssAmount << item.amount;
+		out.cells = { name, ssQtySrc.str(), ssAmount.str(), ssQtyDst.str() };
+		if (item.amount > 0)
 		{
-			_lstItems->setRowColor(_rows.size() - 1, _lstItems->getSecondaryColor());
+			out.color = _lstItems->getSecondaryColor();
 		}
 		else if (ammo)
 		{
-			_lstItems->setRowColor(_rows.size() - 1, _ammoColor);
+			out.color = _ammoColor;
 		}
-	}
+	});
 }
 
 /**
@@ -86,6 +86,85 @@ void AIModule::reset()
 	_ambushTUs = 0;
 }
 
+/**
+ * Indexes a node list by tile and registers the lookup with the AI,
+ * see findNode().
+ * @param ai The AI looking up nodes.
+ * @param nodes The node list, which has to stay unchanged while this is in scope.
+ */
+AIModule::NodeIndex::NodeIndex(AIModule *ai, const std::vector<PathfindingNode*> &nodes) :
+	_ai(ai), _field(ai->_save->getTileFields(), ai->_save->getMapSizeXYZ())
+{
+	for (int i = 0; i < (int)nodes.size(); ++i)
+	{
+		int index = _ai->_save->getTileIndex(nodes[i]->getPosition());
+		if (!_field->contains(index))
+		{
+			(*_field)[index] = i;
+		}
+	}
+	_ai->_nodeIndices.push_back(std::make_pair(&nodes, &*_field));
+}
+
+/**
+ * Unregisters the lookup.
+ */
+AIModule::NodeIndex::~NodeIndex()
+{
+	for (auto it = _ai->_nodeIndices.rbegin(); it != _ai->_nodeIndices.rend(); ++it)
+	{
+		if (it->second == &*_field)
+		{
+			_ai->_nodeIndices.erase(std::next(it).base());
+			break;
+		}
+	}
+}
+
+/**
+ * Gets the tile lookup registered for a node list.
+ * @param nodeVector The node list.
+ * @return The lookup from tile index to position in the list, or null if the list isn't indexed.
+ */
+const TileField<int> *AIModule::getNodeIndex(const std::vector<PathfindingNode*> &nodeVector) const
+{
+	for (auto it = _nodeIndices.rbegin(); it != _nodeIndices.rend(); ++it)
+	{
+		if (it->first == &nodeVector)
+		{
+			return it->second;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Finds the node of a position in a node list,
+ * using the tile lookup when the list is indexed.
+ * @param pos The position.
+ * @param nodeVector The node list.
+ * @return The first node for that position, or null if there is none.
+ */
+PathfindingNode *AIModule::findNode(Position pos, const std::vector<PathfindingNode*> &nodeVector) const
+{
+	const TileField<int> *nodeIndex = getNodeIndex(nodeVector);
+	if (nodeIndex)
+	{
+		if (!_save->getTile(pos))
+			return 0;
+		const int *nodeNumber = nodeIndex->find(_save->getTileIndex(pos));
+		return nodeNumber ? nodeVector[*nodeNumber] : 0;
+	}
+	for (auto pn : nodeVector)
+	{
+		if (pos == pn->getPosition())
+		{
+			return pn;
+		}
+	}
+	return 0;
+}
+
 /**
  * Loads the AI state from a YAML file.
  * @param node YAML node.
@@ -2521,7 +2600,7 @@ bool AIModule::psiAction()
 				// they must be player units
 				bu->getOriginalFaction() == _targetFaction &&
 				(!LOSRequired ||
-				std::find(_unit->getVisibleUnits()->begin(), _unit->getVisibleUnits()->end(), bu) != _unit->getVisibleUnits()->end()))
+				_unit->hasUnitInView(bu)))
 			{
 				BattleUnit *victim = bu;
 				if (item->getRules()->isOutOfRange(_unit->distance3dToUnitSq(victim)))
@@ -2999,6 +3078,7 @@ void AIModule::brutalThink(BattleAction* action)
 	if (Options::strafe && wantToRun())
 		bam = BAM_RUN;
 	_allPathFindingNodes = _save->getPathfinding()->findReachablePathFindingNodes(_unit, BattleActionCost(), dummy, true, NULL, NULL, false, false, bam);
+	NodeIndex allPathFindingNodesIndex(this, _allPathFindingNodes);
 	BattleUnit* unitToFaceTo = NULL;
 
 	float shortestDist = FLT_MAX;
@@ -3011,7 +3091,7 @@ void AIModule::brutalThink(BattleAction* action)
 	float closestDistanceofFurthestPosition = FLT_MAX;
 	bool sweepMode = _unit->getAggressiveness() > 3 || _unit->isLeeroyJenkins();
 	float targetDistanceTofurthestReach = FLT_MAX;
-	std::map<Position, int, PositionComparator> enemyReachable;
+	TileFieldLease<int> enemyReachable(_save->getTileFields(), _save->getMapSizeXYZ());
 	bool immobileEnemies = false;
 	for (BattleUnit* target : *(_save->getUnits()))
 	{
@@ -3102,7 +3182,7 @@ void AIModule::brutalThink(BattleAction* action)
 		{
 			for (auto& reachablePosOfTarget : getReachableBy(target, _ranOutOfTUs, false, true))
 			{
-				enemyReachable[reachablePosOfTarget.first] += reachablePosOfTarget.second;
+				(*enemyReachable)[reachablePosOfTarget.first] += reachablePosOfTarget.second;
 			}
 		}
 		BattleUnit* LoFCheckUnitForPath = NULL;
@@ -3340,9 +3420,9 @@ void AIModule::brutalThink(BattleAction* action)
 	float tuToSaveForHide = 0.5;
 	bool shouldSaveEnergy = _unit->getEnergy() + getEnergyRecovery(_unit) < _unit->getBaseStats()->stamina;
 	bool saveDistance = true;
-	for (auto& reachable : enemyReachable)
+	for (int reachable : enemyReachable->getIndices())
 	{
-		if (hasTileSight(myPos, reachable.first))
+		if (hasTileSight(myPos, _save->getTileCoords(reachable)))
 		{
 			saveDistance = false;
 			break;
@@ -3414,6 +3494,7 @@ void AIModule::brutalThink(BattleAction* action)
 		BattleActionCost reserved = BattleActionCost(_unit);
 		Position travelTarget = furthestToGoTowards(targetPosition, reserved, _allPathFindingNodes);
 		std::vector<PathfindingNode*> targetNodes = _save->getPathfinding()->findReachablePathFindingNodes(_unit, BattleActionCost(), dummy, true, NULL, &travelTarget, false, false, bam);
+		NodeIndex targetNodesIndex(this, targetNodes);
 		if (_traceAI)
 		{
 			Log(LOG_INFO) << "travelTarget: " << travelTarget << " targetPositon: " << targetPosition << " peak-mode: " << peakMode << " sweep-mode: " << sweepMode << " furthest-enemy: " << furthestPositionEnemyCanReach << " targetDistanceTofurthestReach: " << targetDistanceTofurthestReach << " need to turn: " << justNeedToTurn << " need to turn to peek: " << justNeedToTurnToPeek <<" tuToSaveForHide: " << tuToSaveForHide << " peakPosition: " << peakPosition;
@@ -3651,9 +3732,10 @@ void AIModule::brutalThink(BattleAction* action)
 				}
 				if (!sweepMode && validCover)
 				{
-					for (auto& reachable : enemyReachable)
+					for (int reachable : enemyReachable->getIndices())
 					{
-						if (reachable.second > discoverThreat)
+						int threat = enemyReachable->get(reachable);
+						if (threat > discoverThreat)
 						{
 							for (int x = 0; x < _unit->getArmor()->getSize(); ++x)
 							{
@@ -3662,8 +3744,8 @@ void AIModule::brutalThink(BattleAction* action)
 									Position compPos = pos;
 									compPos.x += x;
 									compPos.y += y;
-									if (hasTileSight(compPos, reachable.first))
-										discoverThreat = reachable.second;
+									if (hasTileSight(compPos, _save->getTileCoords(reachable)))
+										discoverThreat = threat;
 								}
 							}
 						}
@@ -4168,7 +4250,7 @@ bool AIModule::brutalSelectSpottedUnitForSniper()
 	return _aggroTarget != 0;
 }
 
-int AIModule::tuCostToReachPosition(Position pos, const std::vector<PathfindingNode *> nodeVector, BattleUnit *actor, bool forceExactPosition)
+int AIModule::tuCostToReachPosition(Position pos, const std::vector<PathfindingNode *> &nodeVector, BattleUnit *actor, bool forceExactPosition)
 {
 	float closestDistToTarget = 3;
 	int tuCostToClosestNode = 10000;
@@ -4177,6 +4259,45 @@ int AIModule::tuCostToReachPosition(Position pos, const std::vector<PathfindingN
 		return tuCostToClosestNode;
 	if (actor == NULL)
 		actor = _unit;
+	const TileField<int> *nodeIndex = getNodeIndex(nodeVector);
+	if (nodeIndex)
+	{
+		const int *exact = nodeIndex->find(_save->getTileIndex(pos));
+		if (exact)
+			return nodeVector[*exact]->getTUCost(false).time;
+		if (forceExactPosition)
+			return tuCostToClosestNode;
+		// only nodes on the same layer and closer than closestDistToTarget count, so just look at the tiles around us
+		// and try them in the order the scan of the list would settle on: closest first, then the earliest in the list
+		std::pair<float, int> candidates[24];
+		int candidateCount = 0;
+		for (int x = -2; x <= 2; ++x)
+		{
+			for (int y = -2; y <= 2; ++y)
+			{
+				Position nodePos = pos + Position(x, y, 0);
+				Tile *tile = _save->getTile(nodePos);
+				if (!tile)
+					continue;
+				const int *nodeNumber = nodeIndex->find(_save->getTileIndex(nodePos));
+				if (!nodeNumber)
+					continue;
+				if (!posTile->hasNoFloor() && tile->hasNoFloor() && actor->getMovementType() != MT_FLY)
+					continue;
+				float currDist = Position::distance(pos, nodePos);
+				if (currDist < closestDistToTarget)
+					candidates[candidateCount++] = std::make_pair(currDist, *nodeNumber);
+			}
+		}
+		std::sort(candidates, candidates + candidateCount);
+		for (int i = 0; i < candidateCount; ++i)
+		{
+			PathfindingNode *pn = nodeVector[candidates[i].second];
+			if (hasTileSight(pn->getPosition(), pos))
+				return pn->getTUCost(false).time;
+		}
+		return tuCostToClosestNode;
+	}
 	for (auto pn : nodeVector)
 	{
 		if (pos == pn->getPosition())
@@ -4201,7 +4322,7 @@ int AIModule::tuCostToReachPosition(Position pos, const std::vector<PathfindingN
 	return tuCostToClosestNode;
 }
 
-Position AIModule::furthestToGoTowards(Position target, BattleActionCost reserved, std::vector<PathfindingNode *> nodeVector, bool encircleTileMode, Tile *encircleTile)
+Position AIModule::furthestToGoTowards(Position target, BattleActionCost reserved, const std::vector<PathfindingNode *> &nodeVector, bool encircleTileMode, Tile *encircleTile)
 {
 	//consider time-units we already spent
 	reserved.Time = _unit->getTimeUnits() - reserved.Time;
@@ -4211,39 +4332,38 @@ Position AIModule::furthestToGoTowards(Position target, BattleActionCost reserve
 	{
 		reserved.Time -= _unit->getKneelUpCost();
 	}
-	PathfindingNode *targetNode = NULL;
-	int closestDistToTarget = 255;
-	for (auto pn : nodeVector)
+	PathfindingNode *targetNode = findNode(target, nodeVector);
+	if (targetNode == NULL)
 	{
-		if (target == pn->getPosition())
-		{
-			targetNode = pn;
-			break;
-		}
-		// If we want to get close to the target it must be on the same layer
-		if (target.z != pn->getPosition().z)
+		// the target itself is out of reach, so go for the closest node to it
+		int closestDistToTarget = 255;
+		for (auto pn : nodeVector)
 		{
-			if (target.z > pn->getPosition().z)
+			// If we want to get close to the target it must be on the same layer
+			if (target.z != pn->getPosition().z)
 			{
-				Tile *targetTile = _save->getTile(target);
-				Tile *tileAbovePathNode = _save->getAboveTile(_save->getTile(pn->getPosition()));
-				if (!targetTile->hasNoFloor() && !tileAbovePathNode->hasNoFloor())
-					continue;
+				if (target.z > pn->getPosition().z)
+				{
+					Tile *targetTile = _save->getTile(target);
+					Tile *tileAbovePathNode = _save->getAboveTile(_save->getTile(pn->getPosition()));
+					if (!targetTile->hasNoFloor() && !tileAbovePathNode->hasNoFloor())
+						continue;
+				}
+				if (target.z < pn->getPosition().z)
+				{
+					Tile *tileAbovetargetTile = _save->getAboveTile(_save->getTile(target));
+					Tile *pathNodeTile = _save->getTile(pn->getPosition());
+					if (!tileAbovetargetTile->hasNoFloor() && !pathNodeTile->hasNoFloor())
+						continue;
+				}
 			}
-			if (target.z < pn->getPosition().z)
+			int currDist = Position::distance(target, pn->getPosition());
+			if (currDist < closestDistToTarget)
 			{
-				Tile *tileAbovetargetTile = _save->getAboveTile(_save->getTile(target));
-				Tile *pathNodeTile = _save->getTile(pn->getPosition());
-				if (!tileAbovetargetTile->hasNoFloor() && !pathNodeTile->hasNoFloor())
-					continue;
+				closestDistToTarget = currDist;
+				targetNode = pn;
 			}
 		}
-		int currDist = Position::distance(target, pn->getPosition());
-		if (currDist < closestDistToTarget)
-		{
-			closestDistToTarget = currDist;
-			targetNode = pn;
-		}
 	}
 	if (targetNode != NULL)
 	{
@@ -4300,41 +4420,40 @@ Position AIModule::furthestToGoTowards(Position target, BattleActionCost reserve
 	return _unit->getPosition();
 }
 
-Position AIModule::closestToGoTowards(Position target, std::vector<PathfindingNode *> nodeVector, Position myPos, bool peakMode)
+Position AIModule::closestToGoTowards(Position target, const std::vector<PathfindingNode *> &nodeVector, Position myPos, bool peakMode)
 {
-	PathfindingNode *targetNode = NULL;
-	float closestDistToTarget = 255;
-	for (auto pn : nodeVector)
+	PathfindingNode *targetNode = findNode(target, nodeVector);
+	if (targetNode == NULL)
 	{
-		if (target == pn->getPosition())
-		{
-			targetNode = pn;
-			break;
-		}
-		// If we want to get close to the target it must be on the same layer
-		if (target.z != pn->getPosition().z)
+		// the target itself is out of reach, so go for the closest node to it
+		float closestDistToTarget = 255;
+		for (auto pn : nodeVector)
 		{
-			if (target.z > pn->getPosition().z)
+			// If we want to get close to the target it must be on the same layer
+			if (target.z != pn->getPosition().z)
 			{
-				Tile *targetTile = _save->getTile(target);
-				Tile *tileAbovePathNode = _save->getAboveTile(_save->getTile(pn->getPosition()));
-				if (!targetTile->hasNoFloor() && !tileAbovePathNode->hasNoFloor())
-					continue;
+				if (target.z > pn->getPosition().z)
+				{
+					Tile *targetTile = _save->getTile(target);
+					Tile *tileAbovePathNode = _save->getAboveTile(_save->getTile(pn->getPosition()));
+					if (!targetTile->hasNoFloor() && !tileAbovePathNode->hasNoFloor())
+						continue;
+				}
+				if (target.z < pn->getPosition().z)
+				{
+					Tile *tileAbovetargetTile = _save->getAboveTile(_save->getTile(target));
+					Tile *pathNodeTile = _save->getTile(pn->getPosition());
+					if (!tileAbovetargetTile->hasNoFloor() && !pathNodeTile->hasNoFloor())
+						continue;
+				}
 			}
-			if (target.z < pn->getPosition().z)
+			float currDist = Position::distance(target, pn->getPosition());
+			if (currDist < closestDistToTarget)
 			{
-				Tile *tileAbovetargetTile = _save->getAboveTile(_save->getTile(target));
-				Tile *pathNodeTile = _save->getTile(pn->getPosition());
-				if (!tileAbovetargetTile->hasNoFloor() && !pathNodeTile->hasNoFloor())
-					continue;
+				closestDistToTarget = currDist;
+				targetNode = pn;
 			}
 		}
-		float currDist = Position::distance(target, pn->getPosition());
-		if (currDist < closestDistToTarget)
-		{
-			closestDistToTarget = currDist;
-			targetNode = pn;
-		}
 	}
 	if (targetNode != NULL)
 	{
@@ -4360,15 +4479,7 @@ Position AIModule::closestToGoTowards(Position target, std::vector<PathfindingNo
 
 bool AIModule::isPathToPositionSave(Position target, bool &saveForProxies)
 {
-	PathfindingNode *targetNode = NULL;
-	for (auto pn : _allPathFindingNodes)
-	{
-		if (target == pn->getPosition())
-		{
-			targetNode = pn;
-			break;
-		}
-	}
+	PathfindingNode *targetNode = findNode(target, _allPathFindingNodes);
 	if (targetNode != NULL)
 	{
 		while (targetNode->getPrevNode() != NULL)
@@ -4497,7 +4608,7 @@ bool AIModule::brutalPsiAction()
 				// they must be armed
 				(*i)->getMainHandWeapon() &&
 				(!LOSRequired ||
-				 std::find(_unit->getVisibleUnits()->begin(), _unit->getVisibleUnits()->end(), *i) != _unit->getVisibleUnits()->end()) &&
+				 _unit->hasUnitInView(*i)) &&
 				brutalValidTarget(*i, true, true)
 				)
 			{
@@ -5972,6 +6083,7 @@ bool AIModule::IsEnemyExposedEnough()
 		Log(LOG_INFO) << "startPos: " << startPosition;
 	}
 	std::vector<PathfindingNode *> enemySimulationNodes = _save->getPathfinding()->findReachablePathFindingNodes(_unit, BattleActionCost(), dummy, true, NULL, &startPosition);
+	NodeIndex enemySimulationNodesIndex(this, enemySimulationNodes);
 	for (BattleUnit *enemy : *(_save->getUnits()))
 	{
 		if (!isEnemy(enemy))
@@ -6102,7 +6214,7 @@ float AIModule::getCoverValue(Tile* tile, BattleUnit* bu, int coverQuality)
 	return cover;
 }
 
-float AIModule::highestCoverInRange(const std::vector<PathfindingNode *> nodeVector)
+float AIModule::highestCoverInRange(const std::vector<PathfindingNode *> &nodeVector)
 {
 	float highestCover = 0;
 	for (auto pn : nodeVector)
@@ -6144,7 +6256,7 @@ int AIModule::getEnergyRecovery(BattleUnit* unit)
 	return recovery;
 }
 
-std::map<Position, int, PositionComparator> AIModule::getReachableBy(BattleUnit* unit, bool& ranOutOfTUs, bool forceRecalc, bool useMaxTUs)
+const std::vector<std::pair<int, int> > &AIModule::getReachableBy(BattleUnit* unit, bool& ranOutOfTUs, bool forceRecalc, bool useMaxTUs)
 {
 	Position startPosition = _save->getTileCoords(unit->getTileLastSpotted(_unit->getFaction()));
 	if (_unit->isCheatOnMovement() || unit->getFaction() == _unit->getFaction())
@@ -6155,13 +6267,24 @@ std::map<Position, int, PositionComparator> AIModule::getReachableBy(BattleUnit*
 		return unit->getReachablePositions();
 	}
 	std::vector<PathfindingNode*> reachable = _save->getPathfinding()->findReachablePathFindingNodes(unit, BattleActionCost(), ranOutOfTUs, false, NULL, &startPosition, false, useMaxTUs);
-	std::map<Position, int, PositionComparator> tuAtPositionMap;
+	std::vector<std::pair<int, int> > tuAtPosition;
+	tuAtPosition.reserve(reachable.size());
+	// a tile can be reached by more than one node, keep one entry per tile
+	TileFieldLease<int> entryOfTile(_save->getTileFields(), _save->getMapSizeXYZ());
 	int TUs = unit->getTimeUnits();
 	if (useMaxTUs)
 		TUs = getMaxTU(unit);
 	for (std::vector<PathfindingNode*>::const_iterator it = reachable.begin(); it != reachable.end(); ++it)
 	{
-		tuAtPositionMap[(*it)->getPosition()] = TUs - (*it)->getTUCost(false).time;
+		int index = _save->getTileIndex((*it)->getPosition());
+		int tuLeft = TUs - (*it)->getTUCost(false).time;
+		if (const int *entry = entryOfTile->find(index))
+		{
+			tuAtPosition[*entry].second = tuLeft;
+			continue;
+		}
+		(*entryOfTile)[index] = tuAtPosition.size();
+		tuAtPosition.push_back(std::make_pair(index, tuLeft));
 		//if (_traceAI && unit->getFaction() == _unit->getFaction() && unit->getFaction() == FACTION_PLAYER)
 		//{
 		//	Tile* tile = _save->getTile((*it)->getPosition());
@@ -6173,23 +6296,9 @@ std::map<Position, int, PositionComparator> AIModule::getReachableBy(BattleUnit*
 		//}
 	}
 	unit->setPositionOfUpdate(startPosition);
-	unit->setReachablePositions(tuAtPositionMap);
+	unit->setReachablePositions(std::move(tuAtPosition));
 	unit->setRanOutOfTUs(ranOutOfTUs);
-	return tuAtPositionMap;
-}
-
-std::map<Position, int, PositionComparator> AIModule::getSmokeFearMap()
-{
-	std::map<Position, int, PositionComparator> smokeFearMap;
-	for (int i = 0; i < _save->getMapSizeXYZ(); i++)
-	{
-		Tile* tile = _save->getTile(i);
-		if (tile && tile->getSmoke() > 0)
-		{
-			smokeFearMap[tile->getPosition()] = tile->getSmoke();
-		}
-	}
-	return smokeFearMap;
+	return unit->getReachablePositions();
 }
 
 bool AIModule::hasTileSight(Position from, Position to)
@@ -6223,17 +6332,9 @@ bool AIModule::hasTileSight(Position from, Position to)
 	return result;
 }
 
-int AIModule::requiredWayPointCount(Position to, const std::vector<PathfindingNode*> nodeVector)
+int AIModule::requiredWayPointCount(Position to, const std::vector<PathfindingNode*> &nodeVector)
 {
-	PathfindingNode* targetNode = NULL;
-	for (auto pn : nodeVector)
-	{
-		if (to == pn->getPosition())
-		{
-			targetNode = pn;
-			break;
-		}
-	}
+	PathfindingNode* targetNode = findNode(to, nodeVector);
 	int lastDirection = -1;
 	int directionChanges = 1;
 	if (targetNode != NULL)
@@ -6260,17 +6361,9 @@ int AIModule::requiredWayPointCount(Position to, const std::vector<PathfindingNo
 	return directionChanges;
 }
 
-std::vector<Position> AIModule::getPositionsOnPathTo(Position target, const std::vector<PathfindingNode*> nodeVector)
+std::vector<Position> AIModule::getPositionsOnPathTo(Position target, const std::vector<PathfindingNode*> &nodeVector)
 {
-	PathfindingNode* targetNode = NULL;
-	for (auto pn : nodeVector)
-	{
-		if (target == pn->getPosition())
-		{
-			targetNode = pn;
-			break;
-		}
-	}
+	PathfindingNode* targetNode = findNode(target, nodeVector);
 	std::vector<Position> positions;
 	if (targetNode != NULL)
 	{
@@ -21,6 +21,7 @@
 #include "BattlescapeGame.h"
 #include "Position.h"
 #include "Pathfinding.h"
+#include "TileField.h"
 #include "../Savegame/BattleUnit.h"
 #include <vector>
 
@@ -56,6 +57,7 @@ private:
 	bool _foundBaseModuleToDestroy;
 	std::vector<int> _reachable, _reachableWithAttack, _wasHitBy;
 	std::vector<PathfindingNode*> _allPathFindingNodes;
+	std::vector<std::pair<const std::vector<PathfindingNode*>*, const TileField<int>*> > _nodeIndices;
 	Position _positionAtStartOfTurn;
 	int _tuCostToReachClosestPositionToBreakLos;
 	int _energyCostToReachClosestPositionToBreakLos;
@@ -71,6 +73,26 @@ private:
 	int selectNearestTargetLeeroy(bool canRun);
 	void meleeActionLeeroy(bool canRun);
 	void dont_think(BattleAction *action);
+
+	/**
+	 * Maps the tiles of a node list to the positions in that list, so the brutal AI
+	 * helpers can look up nodes by tile instead of searching the list.
+	 * The lookup is registered with the AI for as long as this is in scope.
+	 */
+	class NodeIndex
+	{
+		AIModule *_ai;
+		TileFieldLease<int> _field;
+	public:
+		/// Indexes a node list and registers the lookup.
+		NodeIndex(AIModule *ai, const std::vector<PathfindingNode*> &nodes);
+		/// Unregisters the lookup.
+		~NodeIndex();
+	};
+	/// Gets the registered lookup for a node list, if there is one.
+	const TileField<int> *getNodeIndex(const std::vector<PathfindingNode*> &nodeVector) const;
+	/// Finds the node of a position in a node list.
+	PathfindingNode *findNode(Position pos, const std::vector<PathfindingNode*> &nodeVector) const;
 public:
 	/// Creates a new AIModule linked to the game and a certain unit.
 	AIModule(SavedBattleGame *save, BattleUnit *unit, Node *node);
@@ -158,11 +180,11 @@ public:
 	/// Like selectSpottedUnitForSniper but works for everyone
 	bool brutalSelectSpottedUnitForSniper();
 	/// look up in _allPathFindingNodes how many time-units we need to get to a specific position
-	int tuCostToReachPosition(Position pos, const std::vector<PathfindingNode *> nodeVector, BattleUnit* actor = NULL, bool forceExactPosition = false);
+	int tuCostToReachPosition(Position pos, const std::vector<PathfindingNode *> &nodeVector, BattleUnit* actor = NULL, bool forceExactPosition = false);
 	/// find the cloest Position to our target we can reach while reserving for a BattleAction
-	Position furthestToGoTowards(Position target, BattleActionCost reserve, const std::vector<PathfindingNode *> nodeVector, bool encircleTileMode = false, Tile *encircleTile = NULL);
+	Position furthestToGoTowards(Position target, BattleActionCost reserve, const std::vector<PathfindingNode *> &nodeVector, bool encircleTileMode = false, Tile *encircleTile = NULL);
 	/// find the closest Position that isn't our current position which is on the way to a target
-	Position closestToGoTowards(Position target, const std::vector<PathfindingNode *> nodeVector, Position myPos, bool peakMode = false);
+	Position closestToGoTowards(Position target, const std::vector<PathfindingNode *> &nodeVector, Position myPos, bool peakMode = false);
 	/// checks if the path to a position is save
 	bool isPathToPositionSave(Position target, bool &saveForProxies);
 	/// Performs a psionic attack but allow multiple per turn and take success-chance into consideration
@@ -226,21 +248,19 @@ public:
 	/// Get the cover-value of a tile
 	float getCoverValue(Tile *tile, BattleUnit *bu, int coverQuality = 1);
 	/// checks whethere there's any cover in range
-	float highestCoverInRange(const std::vector<PathfindingNode *> nodeVector);
+	float highestCoverInRange(const std::vector<PathfindingNode *> &nodeVector);
 	/// runs a very minimalist pathfinding just to see whether the unit could move
 	bool isAnyMovementPossible();
 	/// returns how much energy the unit can recover each turn
 	int getEnergyRecovery(BattleUnit* unit);
-	/// returns reachable tile-Ids by a particular unit
-	std::map<Position, int, PositionComparator> getReachableBy(BattleUnit* unit, bool& ranOutOfTUs, bool forceRecalc = false, bool useMaxTUs = false);
+	/// returns reachable tile-Ids by a particular unit, with the time-units left there
+	const std::vector<std::pair<int, int> > &getReachableBy(BattleUnit* unit, bool& ranOutOfTUs, bool forceRecalc = false, bool useMaxTUs = false);
 	/// checks whether it would be possible to see one tile from another
 	bool hasTileSight(Position from, Position to);
 	/// returns the amount of blaster-waypoints to reach a target-positon
-	int requiredWayPointCount(Position to, const std::vector<PathfindingNode*> nodeVector);
+	int requiredWayPointCount(Position to, const std::vector<PathfindingNode*> &nodeVector);
 	/// returns a vector of all positions we'd have to walk towards a specific location
-	std::vector<Position> getPositionsOnPathTo(Position target, const std::vector<PathfindingNode*> nodeVector);
-	/// returns fear of smoke
-	std::map<Position, int, PositionComparator> getSmokeFearMap();
+	std::vector<Position> getPositionsOnPathTo(Position target, const std::vector<PathfindingNode*> &nodeVector);
 	/// returns how urgent it is to get rid of a grenade
 	float grenadeRiddingUrgency();
 	/// returns which side of the unit is facing the given position
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleObjectPool.h"
+#include <new>
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Blocks are grouped in size classes of this many bytes.
+const size_t SizeStep = 16;
+/// Blocks bigger than this always come from the heap.
+const size_t MaxPooledSize = 1024;
+/// Most position buffers kept around.
+const size_t MaxBuffers = 16;
+
+std::vector<void*> freeBlocks[MaxPooledSize / SizeStep];
+std::vector<std::vector<Position> > freeBuffers;
+Uint64 heapAllocations = 0;
+Uint64 reuses = 0;
+Sint64 live = 0;
+
+/**
+ * Gets the size class of a block.
+ * @param size Size of the block in bytes.
+ * @return Index of the free list, or -1 if too big to pool.
+ */
+int sizeClass(size_t size)
+{
+	if (size == 0 || size > MaxPooledSize)
+	{
+		return -1;
+	}
+	return (int)((size - 1) / SizeStep);
+}
+
+}
+
+/**
+ * Gets a block of memory, reusing a freed one of the same size class if possible.
+ * @param size Size of the block in bytes.
+ * @return Pointer to the block.
+ */
+void *BattleObjectPool::allocate(size_t size)
+{
+	++live;
+	int index = sizeClass(size);
+	if (index != -1 && !freeBlocks[index].empty())
+	{
+		void *p = freeBlocks[index].back();
+		freeBlocks[index].pop_back();
+		++reuses;
+		return p;
+	}
+	++heapAllocations;
+	return ::operator new(index == -1 ? size : (index + 1) * SizeStep);
+}
+
+/**
+ * Takes back a block of memory for reuse.
+ * @param p Pointer to the block.
+ * @param size Size the block was allocated with.
+ */
+void BattleObjectPool::deallocate(void *p, size_t size)
+{
+	if (!p)
+	{
+		return;
+	}
+	--live;
+	int index = sizeClass(size);
+	if (index == -1)
+	{
+		::operator delete(p);
+	}
+	else
+	{
+		freeBlocks[index].push_back(p);
+	}
+}
+
+/**
+ * Hands out an empty position buffer. If an earlier buffer was
+ * given back, its memory is reused so the buffer doesn't have to grow again.
+ * @param buffer Buffer to replace.
+ */
+void BattleObjectPool::acquireBuffer(std::vector<Position> &buffer)
+{
+	if (!freeBuffers.empty())
+	{
+		buffer.swap(freeBuffers.back());
+		freeBuffers.pop_back();
+	}
+	buffer.clear();
+}
+
+/**
+ * Takes back a position buffer for reuse, leaving it empty.
+ * @param buffer Buffer to take.
+ */
+void BattleObjectPool::releaseBuffer(std::vector<Position> &buffer)
+{
+	if (buffer.capacity() != 0 && freeBuffers.size() < MaxBuffers)
+	{
+		freeBuffers.emplace_back();
+		freeBuffers.back().swap(buffer);
+	}
+	buffer.clear();
+}
+
+/**
+ * Gives all the unused memory back to the heap, at the end of a battle.
+ */
+void BattleObjectPool::trim()
+{
+	for (auto &blocks : freeBlocks)
+	{
+		for (void *p : blocks)
+		{
+			::operator delete(p);
+		}
+		std::vector<void*>().swap(blocks);
+	}
+	std::vector<std::vector<Position> >().swap(freeBuffers);
+}
+
+/**
+ * Gets how many blocks had to be allocated from the heap.
+ * Stays the same during combat once the free lists are warm.
+ * @return Number of heap allocations.
+ */
+Uint64 BattleObjectPool::getHeapAllocations()
+{
+	return heapAllocations;
+}
+
+/**
+ * Gets how many blocks were served from the free lists.
+ * @return Number of reused blocks.
+ */
+Uint64 BattleObjectPool::getReuses()
+{
+	return reuses;
+}
+
+/**
+ * Gets how many blocks are in use.
+ * @return Number of live blocks.
+ */
+Sint64 BattleObjectPool::getLive()
+{
+	return live;
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <vector>
+#include <SDL_types.h>
+#include "Position.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Recycles the memory of the short lived objects of a battle
+ * (battle states, projectiles, explosions) so autofire and AI turns
+ * don't go back to the heap for every shot and step.
+ * Freed blocks are kept in free lists by size, and the position
+ * buffers of projectile trajectories are kept with their capacity.
+ * Only used from the main thread.
+ */
+class BattleObjectPool
+{
+public:
+	/// Gets a block of memory, reusing a freed one of the same size class if possible.
+	static void *allocate(size_t size);
+	/// Takes back a block of memory for reuse.
+	static void deallocate(void *p, size_t size);
+	/// Hands out an empty position buffer that keeps the capacity of an earlier one.
+	static void acquireBuffer(std::vector<Position> &buffer);
+	/// Takes back a position buffer for reuse.
+	static void releaseBuffer(std::vector<Position> &buffer);
+	/// Gives all the unused memory back to the heap.
+	static void trim();
+	/// Gets how many blocks had to be allocated from the heap.
+	static Uint64 getHeapAllocations();
+	/// Gets how many blocks were served from the free lists.
+	static Uint64 getReuses();
+	/// Gets how many blocks are in use.
+	static Sint64 getLive();
+};
+
+}
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleRecorder.h"
+#include <algorithm>
+#include <SDL_rwops.h>
+#include "BattleObjectPool.h"
+#include "BattlescapeGame.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Savegame/BattleItem.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/SaveWriter.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+const char *commandNames[BC_MAX] = { "walk", "updown", "turn", "shoot", "psi", "probe", "item", "kneel", "reserve", "reservekneel", "endturn" };
+
+/**
+ * Writes a position as x,y,z.
+ * @param out Stream to write to.
+ * @param pos The position.
+ */
+void writePosition(std::ostream &out, const Position &pos)
+{
+	out << pos.x << ',' << pos.y << ',' << pos.z;
+}
+
+/**
+ * Mixes a value into a FNV-1a hash.
+ * @param hash Hash so far.
+ * @param value Value to mix in.
+ */
+void hashValue(uint64_t &hash, uint64_t value)
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 0x100000001b3ull;
+	}
+}
+
+}
+
+const std::string BattleRecorder::FOLDER = "recordings";
+
+/**
+ * Creates a recorder for a battle. Nothing is written until the battle starts.
+ * @param game Pointer to the core game.
+ * @param save Pointer to the battle.
+ * @param replay Is the battle a replay of another recording? Replays only log.
+ */
+BattleRecorder::BattleRecorder(Game *game, SavedBattleGame *save, bool replay) : _game(game), _save(save), _file(nullptr), _started(false), _replay(replay)
+{
+	_name = (replay ? "replay_" : "recording_") + CrossPlatform::now();
+}
+
+/**
+ * Creates the recordings folder if needed and deletes the oldest
+ * recordings of a kind, to leave room for a new one.
+ * @param prefix Prefix of the kind of recording.
+ * @return False if the folder can't be created.
+ */
+bool BattleRecorder::prepareFolder(const std::string &prefix)
+{
+	std::string folder = Options::getMasterUserFolder() + FOLDER;
+	if (!CrossPlatform::folderExists(folder) && !CrossPlatform::createFolder(folder))
+	{
+		return false;
+	}
+	std::vector<std::pair<time_t, std::string> > logs;
+	for (const auto& file : CrossPlatform::getFolderContents(folder, "log"))
+	{
+		const std::string &filename = std::get<0>(file);
+		if (!std::get<1>(file) && filename.compare(0, prefix.size(), prefix) == 0)
+		{
+			logs.push_back(std::make_pair(std::get<2>(file), filename.substr(0, filename.size() - 4)));
+		}
+	}
+	std::sort(logs.begin(), logs.end());
+	for (size_t i = 0; i + MAX_RECORDINGS <= logs.size(); ++i)
+	{
+		CrossPlatform::deleteFile(folder + "/" + logs[i].second + ".log");
+		CrossPlatform::deleteFile(folder + "/" + logs[i].second + ".sav");
+	}
+	return true;
+}
+
+/**
+ * Records the state the battle ended in.
+ */
+BattleRecorder::~BattleRecorder()
+{
+	if (_started)
+	{
+		_log << "end turn=" << _save->getTurn() << " hash=" << std::hex << hashState() << std::dec << "\n";
+		flush();
+	}
+	if (_file)
+	{
+		SDL_RWclose(_file);
+	}
+}
+
+/**
+ * Saves the game as the battle starts, so it can be loaded and played again
+ * with the same random numbers, and starts the log.
+ */
+void BattleRecorder::start()
+{
+	if (_started)
+	{
+		return;
+	}
+	_started = true;
+	if (!prepareFolder(_name.substr(0, _name.find('_') + 1)))
+	{
+		Log(LOG_ERROR) << "Failed to create the battle recordings folder " << FOLDER << ", the battle is not recorded.";
+		return;
+	}
+	std::string path = FOLDER + "/" + _name;
+	if (!_replay)
+	{
+		try
+		{
+			_game->getSaveWriter()->save(path + ".sav", _game->getSavedGame()->snapshot(_game->getMod()));
+		}
+		catch (std::exception &e)
+		{
+			Log(LOG_ERROR) << "Failed to save battle recording " << _name << ": " << e.what();
+		}
+	}
+	_file = SDL_RWFromFile((Options::getMasterUserFolder() + path + ".log").c_str(), "wb");
+	if (!_file)
+	{
+		Log(LOG_ERROR) << "Failed to write battle recording " << _name << ": " << SDL_GetError();
+	}
+	_log << "start mission=" << _save->getMissionType() << " turn=" << _save->getTurn() << " side=" << (int)_save->getSide()
+		<< " rng=" << RNG::getSeed() << " hash=" << std::hex << hashState() << std::dec << "\n";
+	flush();
+}
+
+/**
+ * Records a command the player gave, with everything needed to give it again
+ * in a replay. Actions the game derives from it (projectiles, explosions,
+ * reaction fire, the AI) are not recorded, the replay works them out itself.
+ * @param command Kind of command.
+ * @param action The action the command committed.
+ * @param value Extra value of the command, like the direction of an up/down move.
+ */
+void BattleRecorder::recordCommand(BattleCommandType command, const BattleAction &action, int value)
+{
+	if (!_started)
+	{
+		return;
+	}
+	// only these use the item, others can still hold one that was used up since
+	const bool usesItem = command == BC_SHOOT || command == BC_PSI || command == BC_PROBE || command == BC_ITEM;
+	_log << "cmd turn=" << _save->getTurn() << " name=" << getCommandName(command) << " type=" << (int)action.type
+		<< " unit=" << (action.actor ? action.actor->getId() : -1) << " item=" << (usesItem && action.weapon ? action.weapon->getId() : -1)
+		<< " target=";
+	writePosition(_log, action.target);
+	_log << " waypoints=";
+	for (auto i = action.waypoints.begin(); i != action.waypoints.end(); ++i)
+	{
+		if (i != action.waypoints.begin())
+		{
+			_log << ';';
+		}
+		writePosition(_log, *i);
+	}
+	_log << " run=" << action.run << " strafe=" << action.strafe << " sneak=" << action.sneak << " ignore=" << action.ignoreSpottedEnemies
+		<< " value=" << value << " rng=" << RNG::getSeed() << "\n";
+}
+
+/**
+ * Adds time spent in a phase of the current turn.
+ * @param phase Name of the phase.
+ * @param usec Time spent, in microseconds.
+ */
+void BattleRecorder::addPhaseTime(const std::string &phase, int64_t usec)
+{
+	auto &p = _phases[phase];
+	p.first += usec;
+	p.second++;
+}
+
+/**
+ * Records the time spent in each phase during the turn
+ * and the state of the battle at its end.
+ */
+void BattleRecorder::endTurn()
+{
+	if (!_started)
+	{
+		return;
+	}
+	_log << "turn turn=" << _save->getTurn() << " side=" << (int)_save->getSide() << " rng=" << RNG::getSeed()
+		<< " hash=" << std::hex << hashState() << std::dec << "\n";
+	for (const auto &p : _phases)
+	{
+		_log << "phase " << p.first << " calls=" << p.second.second << " usec=" << p.second.first << "\n";
+	}
+	_log << "pool heap=" << BattleObjectPool::getHeapAllocations() << " reused=" << BattleObjectPool::getReuses() << " live=" << BattleObjectPool::getLive() << "\n";
+	_phases.clear();
+	flush();
+}
+
+/**
+ * Hashes the parts of the battle state that the actions change:
+ * turn, side, random seed, units and items. Two runs with the same
+ * starting save and the same actions should hash the same every turn.
+ * @return Hash of the battle state.
+ */
+uint64_t BattleRecorder::hashState() const
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	hashValue(hash, _save->getTurn());
+	hashValue(hash, _save->getSide());
+	hashValue(hash, RNG::getSeed());
+	for (const auto* unit : *_save->getUnits())
+	{
+		Position pos = unit->getPosition();
+		hashValue(hash, unit->getId());
+		hashValue(hash, ((uint64_t)(pos.x & 0xFFFF) << 32) | ((uint64_t)(pos.y & 0xFFFF) << 16) | (uint64_t)(pos.z & 0xFFFF));
+		hashValue(hash, unit->getDirection());
+		hashValue(hash, unit->getStatus());
+		hashValue(hash, unit->getFaction());
+		hashValue(hash, unit->getHealth());
+		hashValue(hash, unit->getStunlevel());
+		hashValue(hash, unit->getTimeUnits());
+		hashValue(hash, unit->getEnergy());
+		hashValue(hash, unit->getMorale());
+	}
+	for (const auto* item : *_save->getItems())
+	{
+		hashValue(hash, item->getId());
+		hashValue(hash, item->getOwner() ? item->getOwner()->getId() : -1);
+		if (item->getTile())
+		{
+			Position pos = item->getTile()->getPosition();
+			hashValue(hash, ((uint64_t)(pos.x & 0xFFFF) << 32) | ((uint64_t)(pos.y & 0xFFFF) << 16) | (uint64_t)(pos.z & 0xFFFF));
+		}
+	}
+	return hash;
+}
+
+/**
+ * Gets the name a command is written with.
+ * @param command Kind of command.
+ * @return Name of the command.
+ */
+const char *BattleRecorder::getCommandName(BattleCommandType command)
+{
+	return command < BC_MAX ? commandNames[command] : "";
+}
+
+/**
+ * Appends the lines logged since the last flush to the recording
+ * file in the user folder.
+ */
+void BattleRecorder::flush()
+{
+	const std::string data = _log.str();
+	_log.str("");
+	if (_file && !data.empty() && SDL_RWwrite(_file, data.c_str(), data.size(), 1) != 1)
+	{
+		Log(LOG_ERROR) << "Failed to write battle recording " << _name << ": " << SDL_GetError();
+	}
+}
+
+}
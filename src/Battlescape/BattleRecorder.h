@@ -0,0 +1,137 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+#include <stdint.h>
+#include "Position.h"
+
+struct SDL_RWops;
+
+namespace OpenXcom
+{
+
+class Game;
+class SavedBattleGame;
+struct BattleAction;
+
+/**
+ * The commands a player can give in battle that a recording can replay.
+ */
+enum BattleCommandType { BC_WALK, BC_UPDOWN, BC_TURN, BC_SHOOT, BC_PSI, BC_PROBE, BC_ITEM, BC_KNEEL, BC_RESERVE, BC_RESERVE_KNEEL, BC_END_TURN, BC_MAX };
+
+/**
+ * A player command as written to a recording.
+ */
+struct BattleCommand
+{
+	BattleCommandType command = BC_MAX;
+	int turn = 0;
+	int type = 0;
+	int unit = -1;
+	int item = -1;
+	Position target;
+	std::list<Position> waypoints;
+	bool run = false, strafe = false, sneak = false, ignoreSpottedEnemies = false;
+	int value = -1;
+	uint64_t rng = 0;
+};
+
+/**
+ * Records a battle for profiling and for comparing runs: a save of the
+ * battle as it started (which includes the RNG seed), every command
+ * the player gave, how long the AI and end of turn processing took
+ * and a hash of the battle state after every turn. Only the last
+ * MAX_RECORDINGS recordings of each kind are kept in FOLDER.
+ */
+class BattleRecorder
+{
+private:
+	Game *_game;
+	SavedBattleGame *_save;
+	std::string _name;
+	std::ostringstream _log;
+	SDL_RWops *_file;
+	bool _started, _replay;
+	std::map<std::string, std::pair<int64_t, int> > _phases;
+
+	/// Appends the new log lines to the recording file.
+	void flush();
+	/// Creates the recordings folder and deletes the oldest recordings.
+	static bool prepareFolder(const std::string &prefix);
+public:
+	/// Subfolder of the user folder the recordings go in, so they stay out of the saves list.
+	static const std::string FOLDER;
+	/// Recordings of each kind kept, older ones are deleted.
+	static const size_t MAX_RECORDINGS = 10;
+
+	/**
+	 * Adds the time spent in its scope to a phase of the recorder, if there is one.
+	 */
+	class PhaseTimer
+	{
+	private:
+		BattleRecorder *_recorder;
+		const char *_phase;
+		std::chrono::steady_clock::time_point _start;
+	public:
+		/// Starts timing a phase.
+		PhaseTimer(BattleRecorder *recorder, const char *phase) : _recorder(recorder), _phase(phase)
+		{
+			if (_recorder)
+				_start = std::chrono::steady_clock::now();
+		}
+		/// Adds the elapsed time to the phase.
+		~PhaseTimer()
+		{
+			stop();
+		}
+		/// Adds the elapsed time to the phase now, instead of at the end of the scope.
+		void stop()
+		{
+			if (_recorder)
+				_recorder->addPhaseTime(_phase, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count());
+			_recorder = nullptr;
+		}
+		PhaseTimer(const PhaseTimer&) = delete;
+		PhaseTimer &operator=(const PhaseTimer&) = delete;
+	};
+
+	/// Creates a recorder for a battle.
+	BattleRecorder(Game *game, SavedBattleGame *save, bool replay);
+	/// Writes the final state and cleans up the recorder.
+	~BattleRecorder();
+	/// Saves the starting state of the battle, once.
+	void start();
+	/// Records a command the player gave.
+	void recordCommand(BattleCommandType command, const BattleAction &action, int value = -1);
+	/// Adds time spent in a phase of the current turn.
+	void addPhaseTime(const std::string &phase, int64_t usec);
+	/// Records the end of a turn.
+	void endTurn();
+	/// Hashes the state of the battle.
+	uint64_t hashState() const;
+	/// Gets the name of a command.
+	static const char *getCommandName(BattleCommandType command);
+};
+
+}
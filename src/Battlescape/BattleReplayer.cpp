@@ -0,0 +1,168 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleReplayer.h"
+#include <sstream>
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "BattleRecorder.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Reads a position written as x,y,z.
+ * @param text The text.
+ * @return The position.
+ */
+Position readPosition(const std::string &text)
+{
+	Position pos;
+	char comma;
+	std::istringstream in(text);
+	in >> pos.x >> comma >> pos.y >> comma >> pos.z;
+	return pos;
+}
+
+}
+
+/**
+ * Loads the commands of a recording from its log in the recordings folder.
+ * Lines other than commands (turn hashes, timings) are skipped.
+ * @param name Name of the recording, without extension.
+ */
+BattleReplayer::BattleReplayer(const std::string &name) : _name(name), _next(0), _diverged(false)
+{
+	try
+	{
+		auto file = CrossPlatform::readFile(Options::getMasterUserFolder() + BattleRecorder::FOLDER + "/" + name + ".log");
+		std::string line;
+		while (std::getline(*file, line))
+		{
+			std::istringstream in(line);
+			std::string token;
+			if (!(in >> token) || token != "cmd")
+			{
+				continue;
+			}
+			BattleCommand command;
+			while (in >> token)
+			{
+				size_t eq = token.find('=');
+				if (eq == std::string::npos)
+				{
+					continue;
+				}
+				std::string key = token.substr(0, eq), value = token.substr(eq + 1);
+				if (key == "turn")
+					command.turn = std::stoi(value);
+				else if (key == "name")
+				{
+					for (int i = 0; i < BC_MAX; ++i)
+					{
+						if (value == BattleRecorder::getCommandName((BattleCommandType)i))
+						{
+							command.command = (BattleCommandType)i;
+						}
+					}
+				}
+				else if (key == "type")
+					command.type = std::stoi(value);
+				else if (key == "unit")
+					command.unit = std::stoi(value);
+				else if (key == "item")
+					command.item = std::stoi(value);
+				else if (key == "target")
+					command.target = readPosition(value);
+				else if (key == "waypoints")
+				{
+					std::istringstream points(value);
+					std::string point;
+					while (std::getline(points, point, ';'))
+					{
+						command.waypoints.push_back(readPosition(point));
+					}
+				}
+				else if (key == "run")
+					command.run = value == "1";
+				else if (key == "strafe")
+					command.strafe = value == "1";
+				else if (key == "sneak")
+					command.sneak = value == "1";
+				else if (key == "ignore")
+					command.ignoreSpottedEnemies = value == "1";
+				else if (key == "value")
+					command.value = std::stoi(value);
+				else if (key == "rng")
+					command.rng = std::stoull(value);
+			}
+			if (command.command != BC_MAX)
+			{
+				_commands.push_back(command);
+			}
+		}
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_ERROR) << "Failed to read battle recording " << name << ": " << e.what();
+	}
+	Log(LOG_INFO) << "Replaying " << _commands.size() << " commands of battle recording " << name;
+}
+
+/**
+ * Cleans up the replayer.
+ */
+BattleReplayer::~BattleReplayer()
+{
+}
+
+/**
+ * Gets the next command to give, if it was given this turn.
+ * Warns once when the random seed no longer matches the recording,
+ * from there on the replay is playing a different battle.
+ * @param turn Current turn of the battle.
+ * @param seed Current random seed.
+ * @return The command, or null when the replay is over.
+ */
+const BattleCommand *BattleReplayer::next(int turn, uint64_t seed)
+{
+	if (_next >= _commands.size())
+	{
+		Log(LOG_INFO) << "Replay of " << _name << " finished";
+		return nullptr;
+	}
+	const BattleCommand *command = &_commands[_next];
+	if (command->turn != turn)
+	{
+		Log(LOG_ERROR) << "Replay of " << _name << " diverged: command " << _next << " was given on turn " << command->turn << ", the replay is on turn " << turn;
+		return nullptr;
+	}
+	if (command->rng != seed && !_diverged)
+	{
+		Log(LOG_WARNING) << "Replay of " << _name << " diverged from the recorded random seed at command " << _next;
+		_diverged = true;
+	}
+	++_next;
+	return command;
+}
+
+}
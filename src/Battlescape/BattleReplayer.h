@@ -0,0 +1,48 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "BattleRecorder.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Reads back the player commands of a battle recording, so the
+ * battle can be played again from its save without any input.
+ */
+class BattleReplayer
+{
+private:
+	std::string _name;
+	std::vector<BattleCommand> _commands;
+	size_t _next;
+	bool _diverged;
+public:
+	/// Loads the commands of a recording.
+	BattleReplayer(const std::string &name);
+	/// Cleans up the replayer.
+	~BattleReplayer();
+	/// Gets the next command to give this turn.
+	const BattleCommand *next(int turn, uint64_t seed);
+};
+
+}
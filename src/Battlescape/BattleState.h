@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "BattlescapeGame.h"
+#include "BattleObjectPool.h"
 
 namespace OpenXcom
 {
@@ -38,6 +39,10 @@ public:
 	BattleState(BattlescapeGame *parent);
 	/// Cleans up the BattleState.
 	virtual ~BattleState();
+	/// Allocates a state from the battle object pool.
+	static void *operator new(size_t size) { return BattleObjectPool::allocate(size); }
+	/// Gives a state back to the battle object pool.
+	static void operator delete(void *p, size_t size) { BattleObjectPool::deallocate(p, size); }
 	/// Initializes the state.
 	virtual void init();
 	/// Called when the state gets popped out.
@@ -19,6 +19,8 @@
 #include <sstream>
 #include "BattlescapeGame.h"
 #include "BattlescapeState.h"
+#include "BattleRecorder.h"
+#include "BattleReplayer.h"
 #include "Map.h"
 #include "Camera.h"
 #include "NextTurnState.h"
@@ -177,12 +179,21 @@ bool BattleActionCost::spendTU(std::string *message)
  */
 BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parentState) : _save(save), _parentState(parentState), _nextUnitToSelect(NULL),
 	_playerPanicHandled(true), _AIActionCounter(0), _playedAggroSound(false),
-	_endTurnRequested(false), _endConfirmationHandled(false), _allEnemiesNeutralized(false)
+	_endTurnRequested(false), _endConfirmationHandled(false), _allEnemiesNeutralized(false), _recorder(nullptr), _replayer(nullptr)
 {
 	if (_save->isPreview())
 	{
 		_allEnemiesNeutralized = true; // just in case
 	}
+	else if (!Options::getReplayBattle().empty())
+	{
+		_replayer = new BattleReplayer(Options::getReplayBattle());
+		_recorder = new BattleRecorder(_parentState->getGame(), _save, true);
+	}
+	else if (Options::recordBattles)
+	{
+		_recorder = new BattleRecorder(_parentState->getGame(), _save, false);
+	}
 
 	_currentAction.actor = 0;
 	_currentAction.targeting = false;
@@ -208,6 +219,9 @@ BattlescapeGame::~BattlescapeGame()
 		delete bs;
 	}
 	cleanupDeleted();
+	delete _recorder;
+	delete _replayer;
+	BattleObjectPool::trim();
 }
 
 /**
@@ -234,7 +248,10 @@ void BattlescapeGame::think()
 				if (_save->getSelectedUnit())
 				{
 					if (!handlePanickingUnit(_save->getSelectedUnit()))
+					{
+						BattleRecorder::PhaseTimer timer(_recorder, "ai");
 						handleAI(_save->getSelectedUnit());
+					}
 				}
 				else
 				{
@@ -262,6 +279,10 @@ void BattlescapeGame::think()
 				_playerPanicHandled = handlePanickingPlayer();
 				_save->getBattleState()->updateSoldierInfo();
 			}
+			else if (_replayer && !_endTurnRequested)
+			{
+				replayNextCommand();
+			}
 		}
 	}
 }
@@ -271,6 +292,10 @@ void BattlescapeGame::think()
  */
 void BattlescapeGame::init()
 {
+	if (_recorder)
+	{
+		_recorder->start();
+	}
 	if (_save->getSide() == FACTION_PLAYER && _save->getTurn() > 1)
 	{
 		_playerPanicHandled = false;
@@ -543,6 +568,7 @@ bool BattlescapeGame::kneel(BattleUnit *bu)
  */
 void BattlescapeGame::endTurn()
 {
+	BattleRecorder::PhaseTimer timer(_recorder, "endTurn");
 	_debugPlay = _save->getDebugMode() && _parentState->getGame()->isCtrlPressed() && (_save->getSide() != FACTION_NEUTRAL);
 	_currentAction.type = BA_NONE;
 	_currentAction.skillRules = nullptr;
@@ -733,6 +759,13 @@ void BattlescapeGame::endTurn()
 		_parentState->getGame()->pushState(new NextTurnState(_save, _parentState));
 	}
 	_endTurnRequested = false;
+
+	// the turn is over, close it in the recording including the time spent ending it
+	if (_recorder)
+	{
+		timer.stop();
+		_recorder->endTurn();
+	}
 }
 
 
@@ -1066,6 +1099,7 @@ void BattlescapeGame::handleNonTargetAction()
 		}
 		else if (_currentAction.type == BA_PRIME && _currentAction.value > -1)
 		{
+			recordCommand(BC_ITEM, _currentAction, _currentAction.value);
 			if (_currentAction.spendTU(&error))
 			{
 				_parentState->warning(_currentAction.weapon->getRules()->getPrimeActionMessage());
@@ -1081,6 +1115,7 @@ void BattlescapeGame::handleNonTargetAction()
 		}
 		else if (_currentAction.type == BA_UNPRIME)
 		{
+			recordCommand(BC_ITEM, _currentAction, _currentAction.value);
 			if (_currentAction.spendTU(&error))
 			{
 				_parentState->warning(_currentAction.weapon->getRules()->getUnprimeActionMessage());
@@ -1096,10 +1131,12 @@ void BattlescapeGame::handleNonTargetAction()
 		}
 		else if (_currentAction.type == BA_USE)
 		{
+			recordCommand(BC_ITEM, _currentAction, _currentAction.value);
 			getTileEngine()->updateGameStateAfterScript(BattleActionAttack::GetBeforeShoot(_currentAction), TileEngine::invalid);
 		}
 		else if (_currentAction.type == BA_HIT)
 		{
+			recordCommand(BC_ITEM, _currentAction, _currentAction.value);
 			if (_currentAction.haveTU(&error))
 			{
 				statePushBack(new MeleeAttackBState(this, _currentAction));
@@ -1825,6 +1862,7 @@ void BattlescapeGame::primaryAction(Position pos)
 				getMap()->getWaypoints()->clear();
 				_parentState->getGame()->getCursor()->setVisible(false);
 				_currentAction.cameraPosition = getMap()->getCamera()->getMapOffset();
+				recordCommand(BC_SHOOT, _currentAction);
 				_states.push_back(new ProjectileFlyBState(this, _currentAction));
 				statePushFront(new UnitTurnBState(this, _currentAction));
 				_currentAction.sprayTargeting = false;
@@ -1853,9 +1891,10 @@ void BattlescapeGame::primaryAction(Position pos)
 			{
 				if (!_currentAction.weapon->getRules()->isLOSRequired() ||
 					(_currentAction.actor->getFaction() == FACTION_PLAYER && targetUnit->getFaction() != FACTION_HOSTILE) ||
-					std::find(_currentAction.actor->getVisibleUnits()->begin(), _currentAction.actor->getVisibleUnits()->end(), targetUnit) != _currentAction.actor->getVisibleUnits()->end())
+					_currentAction.actor->hasUnitInView(targetUnit))
 				{
 					std::string error;
+					recordCommand(BC_PROBE, _currentAction);
 					if (_currentAction.spendTU(&error))
 					{
 						_parentState->getGame()->getMod()->getSoundByDepth(_save->getDepth(), _currentAction.weapon->getRules()->getHitSound())->play(-1, getMap()->getSoundAngle(pos));
@@ -1921,12 +1960,13 @@ void BattlescapeGame::primaryAction(Position pos)
 					_currentAction.target = pos;
 					if (!_currentAction.weapon->getRules()->isLOSRequired() ||
 						(attackerFaction == FACTION_PLAYER && targetFaction != FACTION_HOSTILE) ||
-						std::find(_currentAction.actor->getVisibleUnits()->begin(), _currentAction.actor->getVisibleUnits()->end(), targetUnit) != _currentAction.actor->getVisibleUnits()->end())
+						_currentAction.actor->hasUnitInView(targetUnit))
 					{
 						// get the sound/animation started
 						getMap()->setCursorType(CT_NONE);
 						_parentState->getGame()->getCursor()->setVisible(false);
 						_currentAction.cameraPosition = getMap()->getCamera()->getMapOffset();
+						recordCommand(BC_PSI, _currentAction);
 						statePushBack(new PsiAttackBState(this, _currentAction));
 					}
 					else
@@ -1960,6 +2000,7 @@ void BattlescapeGame::primaryAction(Position pos)
 
 			_parentState->getGame()->getCursor()->setVisible(false);
 			_currentAction.cameraPosition = getMap()->getCamera()->getMapOffset();
+			recordCommand(BC_SHOOT, _currentAction);
 			_states.push_back(new ProjectileFlyBState(this, _currentAction));
 			statePushFront(new UnitTurnBState(this, _currentAction)); // first of all turn towards the target
 		}
@@ -2040,6 +2081,7 @@ void BattlescapeGame::primaryAction(Position pos)
 				//  -= start walking =-
 				getMap()->setCursorType(CT_NONE);
 				_parentState->getGame()->getCursor()->setVisible(false);
+				recordCommand(BC_WALK, _currentAction);
 				statePushBack(new UnitWalkBState(this, _currentAction));
 				playUnitResponseSound(_currentAction.actor, 1); // "start moving" sound
 			}
@@ -2057,6 +2099,7 @@ void BattlescapeGame::secondaryAction(Position pos)
 	_currentAction.target = pos;
 	_currentAction.actor = _save->getSelectedUnit();
 	_currentAction.strafe = Options::strafe && _save->isCtrlPressed(true) && _save->getSelectedUnit()->getTurretType() > -1;
+	recordCommand(BC_TURN, _currentAction);
 	statePushBack(new UnitTurnBState(this, _currentAction));
 }
 
@@ -2071,6 +2114,7 @@ void BattlescapeGame::launchAction()
 	getMap()->setCursorType(CT_NONE);
 	_parentState->getGame()->getCursor()->setVisible(false);
 	_currentAction.cameraPosition = getMap()->getCamera()->getMapOffset();
+	recordCommand(BC_SHOOT, _currentAction);
 	_states.push_back(new ProjectileFlyBState(this, _currentAction));
 	statePushFront(new UnitTurnBState(this, _currentAction)); // first of all turn towards the target
 }
@@ -2135,6 +2179,7 @@ void BattlescapeGame::psiAttackMessage(BattleActionAttack attack, BattleUnit *vi
  */
 void BattlescapeGame::moveUpDown(BattleUnit *unit, int dir)
 {
+	recordCommand(BC_UPDOWN, _currentAction, dir);
 	_currentAction.target = unit->getPosition();
 	if (dir == Pathfinding::DIR_UP)
 	{
@@ -2209,6 +2254,120 @@ void BattlescapeGame::setTUReserved(BattleActionType tur)
 	_save->setTUReserved(tur);
 }
 
+/**
+ * Records a command the player gave, so a replay can give it again.
+ * Replays don't record their commands, they are the recording's.
+ * @param command Kind of command.
+ * @param action The action the command committed.
+ * @param value Extra value of the command.
+ */
+void BattlescapeGame::recordCommand(BattleCommandType command, const BattleAction &action, int value)
+{
+	if (_recorder && !_replayer)
+	{
+		_recorder->recordCommand(command, action, value);
+	}
+}
+
+/**
+ * Gives the next command of the replayed recording the way the player
+ * gave it, or closes the game once the recording has no more commands
+ * for this turn. The AI and everything else the commands set off
+ * play out by themselves from the same random seed.
+ */
+void BattlescapeGame::replayNextCommand()
+{
+	const BattleCommand *command = _replayer->next(_save->getTurn(), RNG::getSeed());
+	if (!command)
+	{
+		_parentState->getGame()->quit();
+		return;
+	}
+
+	BattleAction action;
+	action.type = (BattleActionType)command->type;
+	for (auto* bu : *_save->getUnits())
+	{
+		if (bu->getId() == command->unit)
+		{
+			action.actor = bu;
+			break;
+		}
+	}
+	for (auto* bi : *_save->getItems())
+	{
+		if (bi->getId() == command->item)
+		{
+			action.weapon = bi;
+			break;
+		}
+	}
+	if ((command->unit != -1 && !action.actor) || (command->item != -1 && !action.weapon))
+	{
+		Log(LOG_ERROR) << "Replay diverged: unit " << command->unit << " or item " << command->item << " is gone";
+		_parentState->getGame()->quit();
+		return;
+	}
+	action.target = command->target;
+	action.waypoints = command->waypoints;
+	action.run = command->run;
+	action.strafe = command->strafe;
+	action.sneak = command->sneak;
+	action.ignoreSpottedEnemies = command->ignoreSpottedEnemies;
+	action.targeting = command->command == BC_SHOOT || command->command == BC_PSI || command->command == BC_PROBE;
+	if (command->command == BC_ITEM)
+	{
+		action.value = command->value;
+	}
+	action.updateTU();
+	_currentAction = action;
+	if (action.actor && action.actor != _save->getSelectedUnit())
+	{
+		_save->setSelectedUnit(action.actor);
+	}
+
+	switch (command->command)
+	{
+	case BC_WALK:
+		_save->getPathfinding()->calculate(_currentAction.actor, _currentAction.target, _currentAction.getMoveType());
+		statePushBack(new UnitWalkBState(this, _currentAction));
+		break;
+	case BC_UPDOWN:
+		moveUpDown(_currentAction.actor, command->value);
+		break;
+	case BC_TURN:
+		statePushBack(new UnitTurnBState(this, _currentAction));
+		break;
+	case BC_SHOOT:
+		_states.push_back(new ProjectileFlyBState(this, _currentAction));
+		statePushFront(new UnitTurnBState(this, _currentAction));
+		break;
+	case BC_PSI:
+		statePushBack(new PsiAttackBState(this, _currentAction));
+		break;
+	case BC_PROBE:
+		_currentAction.spendTU();
+		break;
+	case BC_ITEM:
+		handleNonTargetAction();
+		break;
+	case BC_KNEEL:
+		kneel(_currentAction.actor);
+		break;
+	case BC_RESERVE:
+		setTUReserved((BattleActionType)command->value);
+		break;
+	case BC_RESERVE_KNEEL:
+		setKneelReserved(command->value != 0);
+		break;
+	case BC_END_TURN:
+		requestEndTurn(false);
+		break;
+	default:
+		break;
+	}
+}
+
 /**
  * Drops an item to the floor and affects it with gravity.
  * @param position Position to spawn the item.
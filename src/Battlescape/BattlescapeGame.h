@@ -20,6 +20,7 @@
 #include "Position.h"
 #include "../Mod/RuleItem.h"
 #include "Pathfinding.h"
+#include "BattleRecorder.h"
 #include <string>
 #include <list>
 #include <vector>
@@ -39,6 +40,7 @@ class Mod;
 class InfoboxOKState;
 class SoldierDiary;
 class RuleSkill;
+class BattleReplayer;
 
 struct BattleActionCost : RuleItemUseCost
 {
@@ -165,7 +167,8 @@ private:
 	SavedBattleGame *_save;
 	BattlescapeState *_parentState;
 	BattleUnit *_nextUnitToSelect; 
-	std::list<BattleState*> _states, _deleted;
+	std::list<BattleState*> _states;
+	std::vector<BattleState*> _deleted;
 	bool _playerPanicHandled;
 	int _AIActionCounter;
 	BattleAction _currentAction;
@@ -173,6 +176,8 @@ private:
 	bool _endTurnRequested;
 	bool _endConfirmationHandled;
 	bool _allEnemiesNeutralized;
+	BattleRecorder *_recorder;
+	BattleReplayer *_replayer;
 
 	SingleRun _endTurnProcessed;
 	SingleRun _triggerProcessed;
@@ -188,6 +193,8 @@ private:
 	std::vector<InfoboxOKState*> _infoboxQueue;
 	/// Shows the infoboxes in the queue (if any).
 	void showInfoBoxQueue();
+	/// Gives the next command of the replayed recording.
+	void replayNextCommand();
 public:
 	/// is debug mode enabled in the battlescape?
 	static bool _debugPlay;
@@ -264,6 +271,10 @@ public:
 	void requestEndTurn(bool askForConfirmation);
 	/// Sets the TU reserved type.
 	void setTUReserved(BattleActionType tur);
+	/// Records a command the player gave, if the battle is being recorded.
+	void recordCommand(BattleCommandType command, const BattleAction &action, int value = -1);
+	/// Is the battle a replay of a recording?
+	bool isReplaying() const { return _replayer != nullptr; }
 	/// Sets up the cursor taking into account the action.
 	void setupCursor();
 	/// Gets the map.
@@ -102,7 +102,7 @@ BattlescapeState::BattlescapeState() :
 	_isMouseScrolling(false), _isMouseScrolled(false),
 	_xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0),
 	_totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(0), _mouseOverIcons(false),
-	_autosave(0),
+	_autosave(0), _replayClock(0),
 	_numberOfDirectlyVisibleUnits(0), _numberOfEnemiesTotal(0), _numberOfEnemiesTotalPlusWounded(0)
 {
 	_save = _game->getSavedGame()->getSavedBattle();
@@ -851,8 +851,23 @@ void BattlescapeState::think()
 		{
 			State::think();
 			_battleGame->think();
-			_animTimer->think(this, 0);
-			_gameTimer->think(this, 0);
+			if (_battleGame->isReplaying())
+			{
+				// replays don't wait for real time: every frame is a state update, the clock
+				// only keeps the animation running as often per update as it would while playing
+				_replayClock += std::max(1u, _gameTimer->getInterval());
+				while (_replayClock >= DEFAULT_ANIM_SPEED)
+				{
+					_replayClock -= DEFAULT_ANIM_SPEED;
+					animate();
+				}
+				handleState();
+			}
+			else
+			{
+				_animTimer->think(this, 0);
+				_gameTimer->think(this, 0);
+			}
 			if (popped)
 			{
 				_battleGame->handleNonTargetAction();
@@ -1169,7 +1184,7 @@ void BattlescapeState::btnShowMapClick(Action *)
 {
 	//MiniMapState
 	if (allowButtons())
-		_game->pushState (new MiniMapState (_map->getCamera(), _save));
+		_game->pushState (new MiniMapState (_map->getCamera(), _save, _map->getMiniMapCache()));
 }
 
 void BattlescapeState::toggleKneelButton(BattleUnit* unit)
@@ -1195,6 +1210,9 @@ void BattlescapeState::btnKneelClick(Action *)
 		BattleUnit *bu = _save->getSelectedUnit();
 		if (bu)
 		{
+			BattleAction kneel;
+			kneel.actor = bu;
+			_battleGame->recordCommand(BC_KNEEL, kneel);
 			_battleGame->kneel(bu);
 			toggleKneelButton(bu);
 
@@ -1395,6 +1413,7 @@ void BattlescapeState::btnEndTurnClick(Action *)
 		toggleTouchButtons(true, false);
 
 		_txtTooltip->setText("");
+		_battleGame->recordCommand(BC_END_TURN, BattleAction());
 		_battleGame->requestEndTurn(false);
 	}
 }
@@ -1812,6 +1831,7 @@ void BattlescapeState::btnReserveClick(Action *action)
 			_battleGame->setTUReserved(BA_AIMEDSHOT);
 		else if (_reserve == _btnReserveAuto)
 			_battleGame->setTUReserved(BA_AUTOSHOT);
+		_battleGame->recordCommand(BC_RESERVE, BattleAction(), _battleGame->getReservedAction());
 
 		// update any path preview
 		if (_battleGame->getPathfinding()->isPathPreviewed())
@@ -3214,6 +3234,12 @@ void BattlescapeState::popup(State *state)
  */
 void BattlescapeState::finishBattle(bool abort, int inExitArea)
 {
+	if (_battleGame->isReplaying())
+	{
+		// the replay is over, there's no one to read the debriefing
+		_game->quit();
+		return;
+	}
 	bool isPreview = _save->isPreview();
 
 	while (!_game->isState(this))
@@ -3450,6 +3476,7 @@ void BattlescapeState::btnReserveKneelClick(Action *action)
 		Action a = Action(&ev, 0.0, 0.0, 0, 0);
 		action->getSender()->mousePress(&a, this);
 		_battleGame->setKneelReserved(!_battleGame->getKneelReserved());
+		_battleGame->recordCommand(BC_RESERVE_KNEEL, BattleAction(), _battleGame->getKneelReserved());
 
 		_btnReserveKneel->toggle(_battleGame->getKneelReserved());
 
@@ -3810,7 +3837,11 @@ void BattlescapeState::stopScrolling(Action *action)
  */
 void BattlescapeState::autosave(int currentTurn)
 {
-	_autosave = currentTurn;
+	// replays must leave the player's saves alone
+	if (!_battleGame->isReplaying())
+	{
+		_autosave = currentTurn;
+	}
 }
 
 /**
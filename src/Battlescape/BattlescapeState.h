@@ -90,6 +90,7 @@ private:
 	int _xBeforeMouseScrolling, _yBeforeMouseScrolling;
 	Position _mapOffsetBeforeMouseScrolling;
 	Uint32 _mouseScrollingStartTime;
+	Uint32 _replayClock;
 	int _totalMouseMoveX, _totalMouseMoveY;
 	bool _mouseMovedOverThreshold;
 	bool _mouseOverIcons;
@@ -102,6 +102,7 @@ ConfirmEndMissionState::~ConfirmEndMissionState()
 void ConfirmEndMissionState::btnOkClick(Action *)
 {
 	_game->popState();
+	_parent->recordCommand(BC_END_TURN, BattleAction());
 	_parent->requestEndTurn(false);
 }
 
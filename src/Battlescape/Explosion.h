@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Position.h"
+#include "BattleObjectPool.h"
 
 namespace OpenXcom
 {
@@ -41,6 +42,10 @@ public:
 	Explosion(Position _position, int startFrame, int frameDelay = 0, bool big = false, bool hit = false, int frames = -1);
 	/// Cleans up the Explosion.
 	~Explosion();
+	/// Allocates an explosion from the battle object pool.
+	static void *operator new(size_t size) { return BattleObjectPool::allocate(size); }
+	/// Gives an explosion back to the battle object pool.
+	static void operator delete(void *p, size_t size) { BattleObjectPool::deallocate(p, size); }
 	/// Moves the Explosion on one frame.
 	bool animate();
 	/// Gets the current position in voxel space.
@@ -80,6 +80,18 @@ InfoboxOKState::~InfoboxOKState()
 
 }
 
+/**
+ * Replays have no one to press OK, so the box closes right away.
+ */
+void InfoboxOKState::init()
+{
+	State::init();
+	if (!Options::getReplayBattle().empty())
+	{
+		_game->popState();
+	}
+}
+
 /**
  * Returns to the previous screen.
  * @param action Pointer to an action.
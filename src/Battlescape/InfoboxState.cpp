@@ -19,6 +19,7 @@
 #include "InfoboxState.h"
 #include "../Engine/Game.h"
 #include "../Engine/Timer.h"
+#include "../Engine/Options.h"
 #include "../Interface/Text.h"
 #include "../Interface/Frame.h"
 #include "../Engine/Action.h"
@@ -99,6 +100,12 @@ void InfoboxState::handle(Action *action)
  */
 void InfoboxState::think()
 {
+	// replays don't wait for anyone to read it
+	if (!Options::getReplayBattle().empty())
+	{
+		close();
+		return;
+	}
 	_timer->think(this, 0);
 }
 
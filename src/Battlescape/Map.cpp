@@ -18,6 +18,8 @@
  */
 #include "Map.h"
 #include "Camera.h"
+#include "MiniMapCache.h"
+#include "UnitSpriteCache.h"
 #include "UnitSprite.h"
 #include "ItemSprite.h"
 #include "Pathfinding.h"
@@ -148,6 +150,8 @@ Map::Map(Game *game, int width, int height, int x, int y, int visibleMapHeight)
 	_scrollKeyTimer = new Timer(SCROLL_INTERVAL);
 	_scrollKeyTimer->onTimer((SurfaceHandler)&Map::scrollKey);
 	_camera->setScrollTimer(_scrollMouseTimer, _scrollKeyTimer);
+	_miniMapCache = new MiniMapCache(_save);
+	_unitSpriteCache = new UnitSpriteCache();
 	_obstacleTimer = new Timer(2500);
 	_obstacleTimer->stop();
 	_obstacleTimer->onTimer((SurfaceHandler)&Map::disableObstacles);
@@ -229,6 +233,8 @@ Map::~Map()
 	delete _arrow;
 	delete _message;
 	delete _camera;
+	delete _miniMapCache;
+	delete _unitSpriteCache;
 	delete _txtAccuracy;
 }
 
@@ -705,7 +711,7 @@ void Map::drawTerrain(Surface *surface)
 	int dummy;
 	BattleUnit *movingUnit = _save->getTileEngine()->getMovingUnit();
 	int tileShade, tileColor, obstacleShade;
-	UnitSprite unitSprite(surface, _game->getMod(), _save, _animFrame, _save->getDepth() != 0);
+	UnitSprite unitSprite(surface, _game->getMod(), _save, _animFrame, _save->getDepth() != 0, _unitSpriteCache);
 	ItemSprite itemSprite(surface, _game->getMod(), _save, _animFrame);
 
 	const int halfAnimFrame = (_animFrame / 2) % 4;
@@ -2419,7 +2425,7 @@ Collections::Range<const Particle*> Map::getVaporParticle(const Tile* tile, int
  * Gets a list of explosion sprites on the map.
  * @return A list of explosion sprites.
  */
-std::list<Explosion*> *Map::getExplosions()
+std::vector<Explosion*> *Map::getExplosions()
 {
 	return &_explosions;
 }
@@ -2433,6 +2439,15 @@ Camera *Map::getCamera()
 	return _camera;
 }
 
+/**
+ * Gets the pre-rendered minimap terrain, kept for the whole battle.
+ * @return Pointer to the minimap cache.
+ */
+MiniMapCache *Map::getMiniMapCache()
+{
+	return _miniMapCache;
+}
+
 /**
  * Timers only work on surfaces so we have to pass this on to the camera object.
  */
@@ -39,6 +39,8 @@ class Timer;
 class Text;
 class Tile;
 class UnitSprite;
+class MiniMapCache;
+class UnitSpriteCache;
 
 enum CursorType { CT_NONE, CT_NORMAL, CT_AIM, CT_PSI, CT_WAYPOINT, CT_THROW };
 enum TilePart : int;
@@ -90,12 +92,14 @@ private:
 	Projectile *_projectile;
 	bool _followProjectile;
 	bool _projectileInFOV;
-	std::list<Explosion *> _explosions;
+	std::vector<Explosion*> _explosions;
 	std::vector<std::vector<Particle>> _vaporParticlesInit;
 	std::vector<std::vector<Particle>> _vaporParticles;
 	bool _explosionInFOV, _launch;
 	BattlescapeMessage *_message;
 	Camera *_camera;
+	MiniMapCache *_miniMapCache;
+	UnitSpriteCache *_unitSpriteCache;
 	int _visibleMapHeight;
 	std::vector<Position> _waypoints;
 	bool _unitDying, _smoothCamera, _smoothingEngaged, _flashScreen;
@@ -163,10 +167,12 @@ public:
 	/// Get all vapor for tile.
 	Collections::Range<const Particle*> getVaporParticle(const Tile* tile, int topLayer) const;
 	/// Gets explosion set.
-	std::list<Explosion*> *getExplosions();
+	std::vector<Explosion*> *getExplosions();
 
 	/// Gets the pointer to the camera.
 	Camera *getCamera();
+	/// Gets the pre-rendered minimap terrain.
+	MiniMapCache *getMiniMapCache();
 	/// Mouse-scrolls the camera.
 	void scrollMouse();
 	/// Keyboard-scrolls the camera.
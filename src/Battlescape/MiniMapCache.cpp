@@ -0,0 +1,154 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MiniMapCache.h"
+#include <algorithm>
+#include "../Engine/Surface.h"
+#include "../Engine/SurfaceSet.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty cache, the levels are drawn on first use.
+ * @param save Pointer to the battle.
+ */
+MiniMapCache::MiniMapCache(SavedBattleGame *save) : _save(save), _sizeX(0), _sizeY(0)
+{
+}
+
+/**
+ * Deletes the pre-rendered levels.
+ */
+MiniMapCache::~MiniMapCache()
+{
+	clear();
+}
+
+/**
+ * Drops all the pre-rendered levels.
+ */
+void MiniMapCache::clear()
+{
+	for (auto* level : _levels)
+	{
+		delete level;
+	}
+	_levels.clear();
+	_checked.clear();
+	_cells.clear();
+}
+
+/**
+ * Makes every level check its tiles for changes when it's next drawn,
+ * the battle might have changed them since.
+ */
+void MiniMapCache::invalidate()
+{
+	std::fill(_checked.begin(), _checked.end(), false);
+}
+
+/**
+ * Redraws the cells of a level that changed since they were last
+ * drawn, if it wasn't checked since the last invalidate(), and gets
+ * the terrain image of the level.
+ * The image has the cell of tile (x, y) at (x * CELL_WIDTH, y * CELL_HEIGHT),
+ * places without terrain are left transparent.
+ * @param set Minimap sprites (SCANG.DAT).
+ * @param z Level.
+ * @return Terrain image of the level.
+ */
+Surface *MiniMapCache::getLevel(SurfaceSet *set, int z)
+{
+	if (_sizeX != _save->getMapSizeX() || _sizeY != _save->getMapSizeY() || (int)_levels.size() != _save->getMapSizeZ())
+	{
+		clear();
+		_sizeX = _save->getMapSizeX();
+		_sizeY = _save->getMapSizeY();
+		_levels.resize(_save->getMapSizeZ(), nullptr);
+		_checked.resize(_save->getMapSizeZ(), false);
+		Cell empty;
+		std::fill(std::begin(empty.frames), std::end(empty.frames), 0);
+		empty.shade = -1;
+		_cells.assign(_save->getMapSizeXYZ(), empty);
+	}
+	Surface *level = _levels[z];
+	if (!level)
+	{
+		level = new Surface(_sizeX * CELL_WIDTH, _sizeY * CELL_HEIGHT);
+		_levels[z] = level;
+	}
+	if (_checked[z])
+	{
+		return level;
+	}
+	_checked[z] = true;
+
+	bool locked = false;
+	for (int y = 0; y < _sizeY; ++y)
+	{
+		for (int x = 0; x < _sizeX; ++x)
+		{
+			Position pos(x, y, z);
+			Tile *tile = _save->getTile(pos);
+			Cell now;
+			now.shade = 16;
+			if (tile->isDiscovered(O_FLOOR))
+			{
+				now.shade = std::min(tile->getShade(), 7); //vanilla
+			}
+			for (int i = O_FLOOR; i < O_MAX; i++)
+			{
+				MapData *data = tile->getMapData((TilePart)i);
+				now.frames[i] = (data && data->getMiniMapIndex()) ? data->getMiniMapIndex() + 35 : 0;
+			}
+			Cell &cached = _cells[_save->getTileIndex(pos)];
+			if (cached.shade == now.shade && std::equal(std::begin(now.frames), std::end(now.frames), std::begin(cached.frames)))
+			{
+				continue;
+			}
+			cached = now;
+
+			if (!locked)
+			{
+				level->lock();
+				locked = true;
+			}
+			int px = x * CELL_WIDTH;
+			int py = y * CELL_HEIGHT;
+			level->drawRect(px, py, CELL_WIDTH, CELL_HEIGHT, 0);
+			for (int i = O_FLOOR; i < O_MAX; i++)
+			{
+				Surface *s = now.frames[i] ? set->getFrame(now.frames[i]) : nullptr;
+				if (s)
+				{
+					s->blitNShade(level, px, py, now.shade);
+				}
+			}
+		}
+	}
+	if (locked)
+	{
+		level->unlock();
+	}
+	return level;
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "../Mod/MapData.h"
+
+namespace OpenXcom
+{
+
+class Surface;
+class SurfaceSet;
+class SavedBattleGame;
+
+/**
+ * Keeps the terrain of every minimap level pre-rendered, so the minimap
+ * only has to blit it instead of drawing every tile part of every level.
+ * Each cell remembers what it was drawn from and is redrawn only when
+ * that changes (terrain destroyed, tile discovered, lighting changed).
+ * The battle doesn't move on while the minimap is open, so the tiles
+ * are only checked once each time it opens.
+ * Kept by the battlescape map for the whole battle.
+ */
+class MiniMapCache
+{
+private:
+	/// What a cell of a level was drawn from.
+	struct Cell
+	{
+		int frames[O_MAX];
+		int shade; // -1 = not drawn yet
+	};
+	SavedBattleGame *_save;
+	int _sizeX, _sizeY;
+	std::vector<Surface*> _levels;
+	std::vector<bool> _checked;
+	std::vector<Cell> _cells;
+
+	/// Drops all the pre-rendered levels.
+	void clear();
+public:
+	static const int CELL_WIDTH = 4;
+	static const int CELL_HEIGHT = 4;
+	/// Creates an empty cache.
+	MiniMapCache(SavedBattleGame *save);
+	/// Cleans up the cache.
+	~MiniMapCache();
+	MiniMapCache(const MiniMapCache&) = delete;
+	MiniMapCache &operator=(const MiniMapCache&) = delete;
+
+	/// Makes every level check its tiles for changes when it's next drawn.
+	void invalidate();
+	/// Brings a level up to date if needed and gets its terrain image.
+	Surface *getLevel(SurfaceSet *set, int z);
+};
+
+}
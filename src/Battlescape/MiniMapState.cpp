@@ -25,6 +25,7 @@
 #include "../Engine/Palette.h"
 #include "../Interface/Text.h"
 #include "MiniMapView.h"
+#include "MiniMapCache.h"
 #include "Camera.h"
 #include "../Engine/Timer.h"
 #include "../Engine/Action.h"
@@ -38,8 +39,9 @@ namespace OpenXcom
  * @param game Pointer to the core game.
  * @param camera The Battlescape camera.
  * @param battleGame The Battlescape save.
+ * @param cache Pre-rendered minimap terrain.
  */
-MiniMapState::MiniMapState (Camera * camera, SavedBattleGame * battleGame)
+MiniMapState::MiniMapState (Camera * camera, SavedBattleGame * battleGame, MiniMapCache * cache)
 {
 	if (Options::maximizeInfoScreens)
 	{
@@ -48,8 +50,11 @@ MiniMapState::MiniMapState (Camera * camera, SavedBattleGame * battleGame)
 		_game->getScreen()->resetDisplay(false);
 	}
 
+	// the battle went on since the minimap was last open
+	cache->invalidate();
+
 	_bg = new Surface(320, 200);
-	_miniMapView = new MiniMapView(221, 148, 48, 16, _game, camera, battleGame);
+	_miniMapView = new MiniMapView(221, 148, 48, 16, _game, camera, battleGame, cache);
 	_btnLvlUp = new BattlescapeButton(18, 20, 24, 62);
 	_btnLvlDwn = new BattlescapeButton(18, 20, 24, 88);
 	_btnOk = new BattlescapeButton(32, 32, 275, 145);
@@ -26,6 +26,7 @@ class Camera;
 class BattlescapeButton;
 class Text;
 class MiniMapView;
+class MiniMapCache;
 class Timer;
 class SavedBattleGame;
 
@@ -43,7 +44,7 @@ class MiniMapState : public State
 	void animate();
 public:
 	/// Creates the MiniMapState.
-	MiniMapState (Camera * camera, SavedBattleGame * battleGame);
+	MiniMapState (Camera * camera, SavedBattleGame * battleGame, MiniMapCache * cache);
 	/// Cleans up the MiniMapState.
 	~MiniMapState();
 	/// Handler for the OK button.
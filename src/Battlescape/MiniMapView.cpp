@@ -19,6 +19,7 @@
 #include "../fmath.h"
 #include "MiniMapView.h"
 #include "MiniMapState.h"
+#include "MiniMapCache.h"
 #include "Pathfinding.h"
 #include "../Savegame/Tile.h"
 #include "../Savegame/BattleItem.h"
@@ -37,8 +38,8 @@
 
 namespace OpenXcom
 {
-const int CELL_WIDTH = 4;
-const int CELL_HEIGHT = 4;
+const int CELL_WIDTH = MiniMapCache::CELL_WIDTH;
+const int CELL_HEIGHT = MiniMapCache::CELL_HEIGHT;
 const int MAX_FRAME = 2;
 
 /**
@@ -50,8 +51,9 @@ const int MAX_FRAME = 2;
  * @param game Pointer to the core game.
  * @param camera The Battlescape camera.
  * @param battleGame Pointer to the SavedBattleGame.
+ * @param cache Pre-rendered minimap terrain.
  */
-MiniMapView::MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame) : InteractiveSurface(w, h, x, y), _game(game), _camera(camera), _battleGame(battleGame), _frame(0), _isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _mouseScrollX(0), _mouseScrollY(0), _mouseScrollingStartTime(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false)
+MiniMapView::MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame, MiniMapCache * cache) : InteractiveSurface(w, h, x, y), _game(game), _camera(camera), _battleGame(battleGame), _cache(cache), _frame(0), _isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _mouseScrollX(0), _mouseScrollY(0), _mouseScrollingStartTime(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false)
 {
 	_set = _game->getMod()->getSurfaceSet("SCANG.DAT");
 	_emptySpaceIndex = _game->getMod()->getInterface("minimap")->getElement("emptySpace")->color;
@@ -80,6 +82,10 @@ void MiniMapView::draw()
 	}
 	for (int lvl = 0; lvl <= _camera->getCenterPosition().z; lvl++)
 	{
+		// terrain comes pre-rendered, only the changed cells get redrawn
+		Surface *terrain = _cache->getLevel(_set, lvl);
+		terrain->blitNShade(this, -_startX * CELL_WIDTH, -_startY * CELL_HEIGHT, 0);
+
 		int py = _startY;
 		for (int y = 0; y < getHeight(); y += CELL_HEIGHT)
 		{
@@ -97,25 +103,6 @@ void MiniMapView::draw()
 					px++;
 					continue;
 				}
-				for (int i = O_FLOOR; i < O_MAX; i++)
-				{
-					MapData *data = t->getMapData((TilePart)i);
-
-					if (data && data->getMiniMapIndex())
-					{
-						Surface *s = _set->getFrame(data->getMiniMapIndex() + 35);
-						if (s)
-						{
-							int shade = 16;
-							if (t->isDiscovered(O_FLOOR))
-							{
-								shade = t->getShade();
-								if (shade > 7) shade = 7; //vanilla
-							}
-							s->blitNShade(this, x, y, shade);
-						}
-					}
-				}
 				// alive units
 				if (t->getUnit() && (t->getUnit()->getVisible() || _battleGame->getBughuntMode() || _battleGame->getDebugMode()))
 				{
@@ -27,6 +27,7 @@ class Game;
 class Camera;
 class SavedBattleGame;
 class SurfaceSet;
+class MiniMapCache;
 
 /**
  * MiniMapView is the class used to display the map in the MiniMapState.
@@ -36,6 +37,7 @@ class MiniMapView : public InteractiveSurface
 	Game * _game;
 	Camera * _camera;
 	SavedBattleGame * _battleGame;
+	MiniMapCache * _cache;
 	int _frame;
 	SurfaceSet * _set;
 	int _emptySpaceIndex;
@@ -58,7 +60,7 @@ class MiniMapView : public InteractiveSurface
 	void mouseIn(Action *action, State *state) override;
 public:
 	/// Creates the MiniMapView.
-	MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame);
+	MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame, MiniMapCache * cache);
 	/// Draws the minimap.
 	void draw() override;
 	/// Changes the displayed minimap level.
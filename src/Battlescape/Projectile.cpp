@@ -47,6 +47,8 @@ namespace OpenXcom
  */
 Projectile::Projectile(Mod *mod, SavedBattleGame *save, BattleAction action, Position origin, Position targetVoxel, BattleItem *ammo) : _mod(mod), _save(save), _action(action), _origin(origin), _targetVoxel(targetVoxel), _position(0), _distance(0.0f), _bulletSprite(-1), _reversed(false), _vaporColor(-1), _vaporDensity(-1), _vaporProbability(5)
 {
+	// reuse the memory of an earlier trajectory
+	BattleObjectPool::acquireBuffer(_trajectory);
 	// this is the number of pixels the sprite will move between frames
 	_speed = Options::battleFireSpeed;
 	if (_action.weapon)
@@ -97,7 +99,7 @@ Projectile::Projectile(Mod *mod, SavedBattleGame *save, BattleAction action, Pos
  */
 Projectile::~Projectile()
 {
-
+	BattleObjectPool::releaseBuffer(_trajectory);
 }
 
 /**
@@ -20,6 +20,7 @@
 #include <vector>
 #include "Position.h"
 #include "BattlescapeGame.h"
+#include "BattleObjectPool.h"
 
 namespace OpenXcom
 {
@@ -71,6 +72,10 @@ public:
 	Projectile(Mod *mod, SavedBattleGame *save, BattleAction action, Position origin, Position target, BattleItem *ammo);
 	/// Cleans up the Projectile.
 	~Projectile();
+	/// Allocates a projectile from the battle object pool.
+	static void *operator new(size_t size) { return BattleObjectPool::allocate(size); }
+	/// Gives a projectile back to the battle object pool.
+	static void operator delete(void *p, size_t size) { BattleObjectPool::deallocate(p, size); }
 	/// Calculates the trajectory for a straight path.
 	int calculateTrajectory(double accuracy);
 	int calculateTrajectory(double accuracy, const Position& originVoxel, bool excludeUnit = true);
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TerrainPrefetcher.h"
+#include <algorithm>
+#include "../Engine/Logger.h"
+#include "../Mod/Mod.h"
+#include "../Mod/MapDataSet.h"
+#include "../Mod/RuleTerrain.h"
+#include "../Savegame/SavedBattleGame.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an idle terrain prefetcher.
+ * @param mod Pointer to the mod.
+ */
+TerrainPrefetcher::TerrainPrefetcher(Mod *mod) : _mod(mod), _next(0), _cancel(false)
+{
+}
+
+/**
+ * Stops the workers. The sets they loaded stay loaded.
+ */
+TerrainPrefetcher::~TerrainPrefetcher()
+{
+	stop();
+}
+
+/**
+ * Queues all the map data sets of a terrain.
+ * @param terrain Pointer to the terrain, can be null.
+ */
+void TerrainPrefetcher::add(RuleTerrain *terrain)
+{
+	if (terrain)
+	{
+		add(*terrain->getMapDataSets());
+	}
+}
+
+/**
+ * Queues map data sets, skipping the ones already queued
+ * or already loaded (kept from an earlier battle or in use).
+ * Must be called before start().
+ * @param sets The sets.
+ */
+void TerrainPrefetcher::add(const std::vector<MapDataSet*> &sets)
+{
+	for (auto* mds : sets)
+	{
+		if (mds->isLoaded())
+		{
+			continue;
+		}
+		auto it = std::find_if(_queue.begin(), _queue.end(), [&](const std::pair<MapDataSet*, MCDPatch*> &p) { return p.first == mds; });
+		if (it == _queue.end())
+		{
+			// patches are looked up here, mod lookups are not thread-safe
+			_queue.push_back(std::make_pair(mds, _mod->getMCDPatch(mds->getName())));
+		}
+	}
+}
+
+/**
+ * Starts the worker threads, one less than there are cores
+ * (but at least one), and no more than there are sets to load.
+ */
+void TerrainPrefetcher::start()
+{
+	if (!_workers.empty() || _queue.empty())
+	{
+		return;
+	}
+	size_t cores = std::thread::hardware_concurrency();
+	size_t count = std::min(std::max<size_t>(cores, 2) - 1, _queue.size());
+	for (size_t i = 0; i < count; ++i)
+	{
+		_workers.push_back(std::thread(&TerrainPrefetcher::work, this));
+	}
+}
+
+/**
+ * Worker thread body: takes the next set from the queue until
+ * the queue is exhausted or the prefetch gets cancelled.
+ */
+void TerrainPrefetcher::work()
+{
+	while (!_cancel)
+	{
+		size_t i = _next++;
+		if (i >= _queue.size())
+		{
+			return;
+		}
+		MapDataSet *mds = _queue[i].first;
+		try
+		{
+			if (mds->loadData(_queue[i].second))
+			{
+				std::lock_guard<std::mutex> lock(_prefetchedMutex);
+				_prefetched.push_back(mds);
+			}
+		}
+		catch (...)
+		{
+			// leave it to the main thread to run into the problem and report it properly
+			mds->unloadData();
+		}
+	}
+}
+
+/**
+ * Cancels the work not started yet and waits for the rest.
+ */
+void TerrainPrefetcher::stop()
+{
+	_cancel = true;
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+	_workers.clear();
+}
+
+/**
+ * Stops loading and unloads the prefetched sets
+ * the battle didn't end up using.
+ * @param save Pointer to the battle, null if there's none.
+ */
+void TerrainPrefetcher::finish(SavedBattleGame *save)
+{
+	stop();
+	size_t unloaded = 0;
+	for (auto* mds : _prefetched)
+	{
+		if (save)
+		{
+			std::vector<MapDataSet*> *used = save->getMapDataSets();
+			if (std::find(used->begin(), used->end(), mds) != used->end())
+			{
+				continue;
+			}
+		}
+		mds->unloadData();
+		unloaded++;
+	}
+	if (!_prefetched.empty())
+	{
+		Log(LOG_VERBOSE) << "Terrain prefetch: " << _prefetched.size() << " map data sets loaded ahead, " << unloaded << " unused.";
+	}
+	_prefetched.clear();
+}
+
+}
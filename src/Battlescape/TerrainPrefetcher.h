@@ -0,0 +1,70 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Mod;
+class MapDataSet;
+class MCDPatch;
+class RuleTerrain;
+class SavedBattleGame;
+
+/**
+ * Loads map data sets (MCD, PCK and TAB files) on background threads,
+ * before the battlescape generator or the save loader asks for them.
+ * MapDataSet::loadData() can be called on a queued set at any time,
+ * it just waits for the set if a worker is loading it right now.
+ */
+class TerrainPrefetcher
+{
+private:
+	Mod *_mod;
+	std::vector<std::pair<MapDataSet*, MCDPatch*> > _queue;
+	std::vector<MapDataSet*> _prefetched;
+	std::mutex _prefetchedMutex;
+	std::atomic<size_t> _next;
+	std::atomic<bool> _cancel;
+	std::vector<std::thread> _workers;
+	/// Loads queued sets until there are none left.
+	void work();
+	/// Stops and joins the workers.
+	void stop();
+public:
+	/// Creates a terrain prefetcher.
+	TerrainPrefetcher(Mod *mod);
+	/// Cleans up the terrain prefetcher.
+	~TerrainPrefetcher();
+	/// Queues the map data sets of a terrain.
+	void add(RuleTerrain *terrain);
+	/// Queues some map data sets.
+	void add(const std::vector<MapDataSet*> &sets);
+	/// Starts loading the queued sets.
+	void start();
+	/// Stops loading and unloads the prefetched sets the battle doesn't use.
+	void finish(SavedBattleGame *save);
+};
+
+}
@@ -32,6 +32,7 @@
 #include "../Savegame/HitLog.h"
 #include "../Engine/RNG.h"
 #include "../Engine/GraphSubset.h"
+#include "../Engine/WorkerPool.h"
 #include "BattlescapeState.h"
 #include "../Mod/MapDataSet.h"
 #include "../Mod/Unit.h"
@@ -1385,6 +1386,7 @@ inline bool TileEngine::inEventVisibilitySector(const Position &toCheck) const
 */
 bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos, const int eventRadius)
 {
+	_save->getVisibility().attach(unit);
 	size_t oldNumVisibleUnits = unit->getUnitsSpottedThisTurn().size();
 	bool useTurretDirection = false;
 	if (Options::strafe && (unit->getTurretType() > -1)) {
@@ -1485,6 +1487,7 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 */
 void TileEngine::calculateTilesInFOV(BattleUnit* unit, const Position eventPos, const int eventRadius)
 {
+	_save->getVisibility().attach(unit);
 	bool useTurretDirection = false;
 	bool skipNarrowArcTest = false;
 	int direction;
@@ -2578,6 +2581,7 @@ std::vector<TileEngine::ReactionScore> TileEngine::getSpottingUnits(BattleUnit*
 					{
 						unit->setVisible(true);
 					}
+					_save->getVisibility().attach(bu);
 					bu->addToVisibleUnits(unit);
 					ReactionScore rs = determineReactionType(bu, unit);
 					if (rs.attackType != BA_NONE)
@@ -3263,10 +3267,8 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	const Position centetTile = center.toTile();
 	int hitSide = 0;
 	int diagonalWall = 0;
-	int power_;
-	std::map<Tile*, int> tilesAffected;
+	TileFieldLease<int> tilesAffected(_save->getTileFields(), _save->getMapSizeXYZ());
 	std::vector<BattleItem*> toRemove;
-	std::pair<std::map<Tile*, int>::iterator, bool> ret;
 
 	if (type->FireBlastCalc)
 	{
@@ -3289,7 +3291,6 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	}
 
 	Tile *origin = _save->getTile(Position(centetTile));
-	Tile *dest = nullptr;
 	if (origin->isBigWall()) //pre-calculations for bigwall deflection
 	{
 		diagonalWall = origin->getMapData(O_OBJECT)->getBigWall();
@@ -3299,87 +3300,33 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 			hitSide = (center.x % 16 + center.y % 16 - 15) > 0 ? 1 : -1;
 	}
 
-	for (int fi = -90; fi <= 90; fi += 5)
+	// raytrace every 5 degrees vertically and every 3 degrees horizontally, that makes sure we cover all tiles in a circle.
+	const int fiSteps = 180 / 5 + 1, teSteps = 360 / 3 + 1;
+	_explosionRays.resize(fiSteps * teSteps);
+
+	// tracing only reads the terrain, which the blast doesn't change until it's over,
+	// so the rays are traced in parallel: each one lists the tiles it reaches and the power it has left there
+	WorkerPool::getShared().run(fiSteps * teSteps, 64, [&](int first, int last)
 	{
-		// raytrace every 3 degrees makes sure we cover all tiles in a circle.
-		for (int te = 0; te <= 360; te += 3)
+		for (int ray = first; ray < last; ++ray)
 		{
+			const int fi = -90 + (ray / teSteps) * 5;
+			const int te = (ray % teSteps) * 3;
 			double cos_te = cos(Deg2Rad(te));
 			double sin_te = sin(Deg2Rad(te));
 			double sin_fi = sin(Deg2Rad(fi));
 			double cos_fi = cos(Deg2Rad(fi));
 
-			origin = _save->getTile(centetTile);
-			dest = origin;
+			auto &steps = _explosionRays[ray];
+			steps.clear();
+			Tile *orig = _save->getTile(centetTile);
+			Tile *dest = orig;
 			double l = 0;
 			int tileX, tileY, tileZ;
-			power_ = power;
+			int power_ = power;
 			while (power_ > 0 && l <= maxRadius)
 			{
-				if (power_ > 0)
-				{
-					ret = tilesAffected.insert(std::make_pair(dest, 0)); // check if we had this tile already affected
-
-					const int tileDmg = type->getTileFinalDamage(power_);
-					if (tileDmg > ret.first->second)
-					{
-						ret.first->second = tileDmg;
-					}
-					if (ret.second)
-					{
-						const int damage = type->getRandomDamage(power_);
-						BattleUnit *bu = dest->getOverlappingUnit(_save);
-
-						toRemove.clear();
-						if (bu)
-						{
-							if (
-									(
-										Position::distance2dSq(dest->getPosition(), centetTile) < 4
-										&& dest->getPosition().z == centetTile.z
-									)
-									|| dest->getPosition().z > centetTile.z
-								)
-							{
-								// ground zero effect is in effect, or unit is above explosion
-								hitUnit(attack, bu, Position(0, 0, 0), damage, type, rangeAtack);
-							}
-							else
-							{
-								// directional damage relative to explosion position.
-								// units above the explosion will be hit in the legs, units lateral to or below will be hit in the torso
-								hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type, rangeAtack);
-							}
-
-							// Affect all items and units in inventory
-							const int itemDamage = bu->getOverKillDamage();
-							if (itemDamage > 0)
-							{
-								for (auto* bi : *bu->getInventory())
-								{
-									if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), itemDamage, type, rangeAtack) && type->getItemFinalDamage(itemDamage) > bi->getRules()->getArmor())
-									{
-										toRemove.push_back(bi);
-									}
-								}
-							}
-						}
-						// Affect all items and units on ground
-						for (auto* bi : *dest->getInventory())
-						{
-							if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > bi->getRules()->getArmor())
-							{
-								toRemove.push_back(bi);
-							}
-						}
-						for (auto* bi : toRemove)
-						{
-							_save->removeItem(bi);
-						}
-
-						hitTile(dest, damage, type);
-					}
-				}
+				steps.push_back(std::make_pair(_save->getTileIndex(dest->getPosition()), power_));
 
 				l += 1.0;
 
@@ -3387,27 +3334,27 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 				tileY = int(floor(centetTile.y + 0.5 + l * cos_te * cos_fi));
 				tileZ = int(floor(centetTile.z + 0.5 + l * sin_fi));
 
-				origin = dest;
+				orig = dest;
 				dest = _save->getTile(Position(tileX, tileY, tileZ));
 
 				if (!dest) break; // out of map!
 
 				// blockage by terrain is deducted from the explosion power
 				power_ -= type->RadiusReduction; // explosive damage decreases by 10 per tile
-				if (origin->getPosition().z != tileZ)
+				if (orig->getPosition().z != tileZ)
 					power_ -= vertdec; //3d explosion factor
 
 				if (type->FireBlastCalc)
 				{
 					int dir;
-					Pathfinding::vectorToDirection(origin->getPosition() - dest->getPosition(), dir);
+					Pathfinding::vectorToDirection(orig->getPosition() - dest->getPosition(), dir);
 					if (dir != -1 && dir %2) power_ -= 0.5f * type->RadiusReduction; // diagonal movement costs an extra 50% for fire.
 				}
 				if (l > 0.5) {
 					if ( l > 1.5)
 					{
-						power_ -= verticalBlockage(origin, dest, type->ResistType, false) * 2;
-						power_ -= horizontalBlockage(origin, dest, type->ResistType, false) * 2;
+						power_ -= verticalBlockage(orig, dest, type->ResistType, false) * 2;
+						power_ -= horizontalBlockage(orig, dest, type->ResistType, false) * 2;
 					}
 					else //tricky bigwall deflection /Volutar
 					{
@@ -3426,26 +3373,101 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 							if (hitSide<0 && ( te < 45 || te > 225))
 								skipObject = true;
 						}
-						power_ -= verticalBlockage(origin, dest, type->ResistType, skipObject) * 2;
-						power_ -= horizontalBlockage(origin, dest, type->ResistType, skipObject) * 2;
+						power_ -= verticalBlockage(orig, dest, type->ResistType, skipObject) * 2;
+						power_ -= horizontalBlockage(orig, dest, type->ResistType, skipObject) * 2;
 
 					}
 				}
 			}
 		}
+	});
+
+	// walk the rays in order, so damage rolls come out the same as when each ray was applied as it was traced
+	for (const auto &steps : _explosionRays)
+	{
+		for (const auto &step : steps)
+		{
+			const int power_ = step.second;
+			const bool firstHit = !tilesAffected->contains(step.first); // check if we had this tile already affected
+			int &tileDamage = (*tilesAffected)[step.first];
+
+			const int tileDmg = type->getTileFinalDamage(power_);
+			if (tileDmg > tileDamage)
+			{
+				tileDamage = tileDmg;
+			}
+			if (firstHit)
+			{
+				Tile *dest = _save->getTile(step.first);
+				const int damage = type->getRandomDamage(power_);
+				BattleUnit *bu = dest->getOverlappingUnit(_save);
+
+				toRemove.clear();
+				if (bu)
+				{
+					if (
+							(
+								Position::distance2dSq(dest->getPosition(), centetTile) < 4
+								&& dest->getPosition().z == centetTile.z
+							)
+							|| dest->getPosition().z > centetTile.z
+						)
+					{
+						// ground zero effect is in effect, or unit is above explosion
+						hitUnit(attack, bu, Position(0, 0, 0), damage, type, rangeAtack);
+					}
+					else
+					{
+						// directional damage relative to explosion position.
+						// units above the explosion will be hit in the legs, units lateral to or below will be hit in the torso
+						hitUnit(attack, bu, centetTile + Position(0, 0, 5) - dest->getPosition(), damage, type, rangeAtack);
+					}
+
+					// Affect all items and units in inventory
+					const int itemDamage = bu->getOverKillDamage();
+					if (itemDamage > 0)
+					{
+						for (auto* bi : *bu->getInventory())
+						{
+							if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), itemDamage, type, rangeAtack) && type->getItemFinalDamage(itemDamage) > bi->getRules()->getArmor())
+							{
+								toRemove.push_back(bi);
+							}
+						}
+					}
+				}
+				// Affect all items and units on ground
+				for (auto* bi : *dest->getInventory())
+				{
+					if (!hitUnit(attack, bi->getUnit(), Position(0, 0, 0), damage, type) && type->getItemFinalDamage(damage) > bi->getRules()->getArmor())
+					{
+						toRemove.push_back(bi);
+					}
+				}
+				for (auto* bi : toRemove)
+				{
+					_save->removeItem(bi);
+				}
+
+				hitTile(dest, damage, type);
+			}
+		}
 	}
 
-	// now detonate the tiles affected by explosion
+	// now detonate the tiles affected by explosion, in map order
 	if (type->ToTile > 0.0f)
 	{
-		for (auto& pair : tilesAffected)
+		std::vector<int> indices = tilesAffected->getIndices();
+		std::sort(indices.begin(), indices.end());
+		for (int index : indices)
 		{
-			if (detonate(pair.first, pair.second))
+			Tile *tile = _save->getTile(index);
+			if (detonate(tile, tilesAffected->get(index)))
 			{
 				_save->addDestroyedObjective();
 			}
-			applyGravity(pair.first);
-			Tile *j = _save->getTile(pair.first->getPosition() + Position(0,0,1));
+			applyGravity(tile);
+			Tile *j = _save->getTile(tile->getPosition() + Position(0,0,1));
 			if (j)
 				applyGravity(j);
 		}
@@ -4995,9 +5017,9 @@ bool TileEngine::skillUse(BattleAction *action, const RuleSkill *skill)
  */
 bool TileEngine::tryConcealUnit(BattleUnit* unit)
 {
-	for (const auto* bu : *_save->getUnits())
+	for (UnitFaction faction : {UnitFaction::FACTION_PLAYER, UnitFaction::FACTION_HOSTILE, UnitFaction::FACTION_NEUTRAL})
 	{
-		if (bu->getFaction() != unit->getFaction() && bu->hasVisibleUnit(unit))
+		if (faction != unit->getFaction() && _save->eyesOnTarget(faction, unit))
 		{
 			return false;
 		}
@@ -109,6 +109,7 @@ private:
 	std::vector<BattleUnit*> _movingUnitPrev;
 	BattleUnit* _movingUnit = nullptr;
 	std::map<std::pair<int, int>, bool> _visibilityCache;
+	std::vector<std::vector<std::pair<int, int> > > _explosionRays;
 
 	/// Add light source.
 	void addLight(MapSubset gs, Position center, int power, LightLayers layer);
@@ -0,0 +1,172 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * A value per map tile, indexed like SavedBattleGame::getTileIndex().
+ * Entries are stamped with the generation they were set in, so clear()
+ * only bumps the generation instead of touching the whole map.
+ * The indices that were set are kept in order of insertion for iteration.
+ */
+template<typename T>
+class TileField
+{
+private:
+	std::vector<T> _values;
+	std::vector<Uint32> _stamps;
+	std::vector<int> _indices;
+	Uint32 _generation;
+public:
+	/// Creates an empty field.
+	TileField() : _generation(1) { }
+
+	/// Sizes the field for a map and clears it.
+	void reset(int mapSize)
+	{
+		if ((int)_stamps.size() != mapSize)
+		{
+			_values.assign(mapSize, T());
+			_stamps.assign(mapSize, 0);
+			_generation = 0;
+		}
+		clear();
+	}
+	/// Forgets all the entries.
+	void clear()
+	{
+		_indices.clear();
+		if (++_generation == 0)
+		{
+			// wrapped around, old stamps could look current again
+			std::fill(_stamps.begin(), _stamps.end(), 0);
+			_generation = 1;
+		}
+	}
+	/// Checks if a tile has an entry.
+	bool contains(int index) const
+	{
+		return _stamps[index] == _generation;
+	}
+	/// Gets the entry of a tile, or null if there is none.
+	const T *find(int index) const
+	{
+		return contains(index) ? &_values[index] : 0;
+	}
+	/// Gets the entry of a tile, default constructing it if there is none.
+	T &operator[](int index)
+	{
+		if (!contains(index))
+		{
+			_stamps[index] = _generation;
+			_values[index] = T();
+			_indices.push_back(index);
+		}
+		return _values[index];
+	}
+	/// Gets the entry of a tile that is known to exist.
+	const T &get(int index) const
+	{
+		return _values[index];
+	}
+	/// Gets the number of tiles with an entry.
+	size_t size() const
+	{
+		return _indices.size();
+	}
+	/// Gets the tiles with an entry, in the order they were added.
+	const std::vector<int> &getIndices() const
+	{
+		return _indices;
+	}
+};
+
+/**
+ * Keeps map sized tile fields for reuse, so every AI unit thinking
+ * during a battle borrows the same few buffers instead of allocating its own.
+ */
+template<typename T>
+class TileFieldPool
+{
+private:
+	std::vector<TileField<T>*> _free;
+public:
+	/// Creates an empty pool.
+	TileFieldPool() { }
+	/// Deletes the pooled fields.
+	~TileFieldPool()
+	{
+		for (auto* field : _free)
+		{
+			delete field;
+		}
+	}
+	TileFieldPool(const TileFieldPool&) = delete;
+	TileFieldPool &operator=(const TileFieldPool&) = delete;
+
+	/// Hands out a cleared field for a map of the given size.
+	TileField<T> *acquire(int mapSize)
+	{
+		TileField<T> *field;
+		if (_free.empty())
+		{
+			field = new TileField<T>();
+		}
+		else
+		{
+			field = _free.back();
+			_free.pop_back();
+		}
+		field->reset(mapSize);
+		return field;
+	}
+	/// Takes a field back.
+	void release(TileField<T> *field)
+	{
+		_free.push_back(field);
+	}
+};
+
+/**
+ * Borrows a field from a pool for as long as it is in scope.
+ */
+template<typename T>
+class TileFieldLease
+{
+private:
+	TileFieldPool<T> &_pool;
+	TileField<T> *_field;
+public:
+	/// Borrows a cleared field for a map of the given size.
+	TileFieldLease(TileFieldPool<T> &pool, int mapSize) : _pool(pool), _field(pool.acquire(mapSize)) { }
+	/// Gives the field back.
+	~TileFieldLease() { _pool.release(_field); }
+	TileFieldLease(const TileFieldLease&) = delete;
+	TileFieldLease &operator=(const TileFieldLease&) = delete;
+
+	TileField<T> &operator*() const { return *_field; }
+	TileField<T> *operator->() const { return _field; }
+};
+
+}
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "UnitSprite.h"
+#include "UnitSpriteCache.h"
 #include "../Engine/SurfaceSet.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/Armor.h"
@@ -27,6 +28,8 @@
 #include "../Mod/RuleInventory.h"
 #include "../Mod/Mod.h"
 #include "../Engine/Exception.h"
+#include <algorithm>
+#include <climits>
 
 namespace OpenXcom
 {
@@ -37,8 +40,9 @@ namespace OpenXcom
  * @param height Height in pixels.
  * @param x X position in pixels.
  * @param y Y position in pixels.
+ * @param cache Cache of composed unit frames, can be null.
  */
-UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet) :
+UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, UnitSpriteCache* cache) :
 	_unit(0), _itemR(0), _itemL(0),
 	_unitSurface(0),
 	_itemSurface(const_cast<Mod*>(mod)->getSurfaceSet("HANDOB.PCK")),
@@ -49,7 +53,8 @@ UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* sav
 	_part(0), _animationFrame(frame), _drawingRoutine(0),
 	_helmet(helmet),
 	_x(0), _y(0), _shade(0), _burn(0),
-	_mask(0, 0)
+	_mask(0, 0),
+	_cache(cache), _recording(false)
 {
 
 }
@@ -143,6 +148,11 @@ void UnitSprite::blitItem(Part& item)
 	{
 		return;
 	}
+	if (_recording)
+	{
+		_recorded.push_back(RecordedPart{ item, true });
+		return;
+	}
 	ScriptWorkerBlit work;
 	BattleItem::ScriptFill(&work, (item.bodyPart == BODYPART_ITEM_RIGHTHAND ? _itemR : _itemL), _save, item.bodyPart, _animationFrame, _shade);
 
@@ -163,6 +173,11 @@ void UnitSprite::blitBody(Part& body)
 	{
 		return;
 	}
+	if (_recording)
+	{
+		_recorded.push_back(RecordedPart{ body, false });
+		return;
+	}
 	ScriptWorkerBlit work;
 	BattleUnit::ScriptFill(&work, _unit, _save, body.bodyPart, _animationFrame, _shade, _burn);
 
@@ -173,6 +188,107 @@ void UnitSprite::blitBody(Part& body)
 	_dest->unlock();
 }
 
+/**
+ * Checks if the frame of the current unit can be taken from the cache.
+ * Only the default sprite scripts are known to depend on nothing else
+ * than the sprites, the recolor table of the unit, shade and burn.
+ * @param armor Armor of the unit.
+ * @return True if the frame can be cached.
+ */
+bool UnitSprite::isCacheable(const Armor *armor) const
+{
+	if (!_cache)
+	{
+		return false;
+	}
+	if (!armor->getScript<ModScript::RecolorUnitSprite>().isDefault() || !armor->getScript<ModScript::SelectUnitSprite>().isDefault())
+	{
+		return false;
+	}
+	for (const auto* item : { _itemR, _itemL })
+	{
+		if (item && (!item->getRules()->getScript<ModScript::RecolorItemSprite>().isDefault() || !item->getRules()->getScript<ModScript::SelectItemSprite>().isDefault()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Blits the recorded parts as one frame, composing it first
+ * if the same parts were not composed before.
+ */
+void UnitSprite::blitRecorded()
+{
+	if (_recorded.empty())
+	{
+		return;
+	}
+
+	std::string key;
+	auto put = [&](const auto& value)
+	{
+		key.append((const char*)&value, sizeof(value));
+	};
+	put(_shade);
+	put(_burn);
+	const auto& recolor = _unit->getRecolor();
+	put(recolor.size());
+	for (const auto& p : recolor)
+	{
+		put(p.first);
+		put(p.second);
+	}
+	int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+	for (const auto& r : _recorded)
+	{
+		put(r.part.src);
+		put(r.part.offX);
+		put(r.part.offY);
+		put(r.item);
+		minX = std::min(minX, r.part.offX);
+		minY = std::min(minY, r.part.offY);
+		maxX = std::max(maxX, r.part.offX + r.part.src->getWidth());
+		maxY = std::max(maxY, r.part.offY + r.part.src->getHeight());
+	}
+
+	const auto* frame = _cache->find(key);
+	if (!frame)
+	{
+		Surface *composed = new Surface(maxX - minX, maxY - minY);
+		Surface *dest = _dest;
+		int x = _x, y = _y;
+		GraphSubset mask = _mask;
+		_dest = composed;
+		_x = -minX;
+		_y = -minY;
+		_mask = GraphSubset(composed->getWidth(), composed->getHeight());
+		for (auto& r : _recorded)
+		{
+			if (r.item)
+			{
+				blitItem(r.part);
+			}
+			else
+			{
+				blitBody(r.part);
+			}
+		}
+		_dest = dest;
+		_x = x;
+		_y = y;
+		_mask = mask;
+		frame = _cache->insert(key, composed, minX, minY);
+	}
+
+	_dest->lock();
+
+	frame->surface->blitNShade(_dest, _x + frame->offX, _y + frame->offY, 0, _mask);
+
+	_dest->unlock();
+}
+
 /**
  * Draws a unit, using the drawing rules of the unit.
  * This function is called by Map, for each unit on the screen.
@@ -245,7 +361,19 @@ void UnitSprite::draw(const BattleUnit* unit, int part, int x, int y, int shade,
 		&UnitSprite::drawRoutine3,
 	};
 	// Call the matching routine
-	(this->*(routines[_drawingRoutine]))();
+	if (isCacheable(armor))
+	{
+		// only collect the parts, they get composed once and then reused while nothing changes
+		_recording = true;
+		_recorded.clear();
+		(this->*(routines[_drawingRoutine]))();
+		_recording = false;
+		blitRecorded();
+	}
+	else
+	{
+		(this->*(routines[_drawingRoutine]))();
+	}
 	// draw fire
 	if (unit->getFire() > 0)
 	{
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../Engine/Surface.h"
+#include <vector>
 #include "../Engine/Script.h"
 
 namespace OpenXcom
@@ -28,6 +29,8 @@ class BattleItem;
 class SavedBattleGame;
 class SurfaceSet;
 class Mod;
+class Armor;
+class UnitSpriteCache;
 
 /**
  * A class that renders a specific unit, given its render rules
@@ -48,6 +51,12 @@ private:
 		void operator=(const Surface *s) { src = s; }
 		explicit operator bool() { return src; }
 	};
+	/// Part waiting to be composed into a cached frame.
+	struct RecordedPart
+	{
+		Part part;
+		bool item;
+	};
 
 	const BattleUnit *_unit;
 	const BattleItem *_itemR, *_itemL;
@@ -59,6 +68,9 @@ private:
 	bool _helmet;
 	int _x, _y, _shade, _burn;
 	GraphSubset _mask;
+	UnitSpriteCache *_cache;
+	bool _recording;
+	std::vector<RecordedPart> _recorded;
 
 	/// Drawing routine for XCom soldiers in overalls, sectoids (routine 0),
 	/// mutons (routine 10),
@@ -106,9 +118,13 @@ private:
 	void blitItem(Part& item);
 	/// Blit body sprite.
 	void blitBody(Part& body);
+	/// Checks if the frame of the current unit can be taken from the cache.
+	bool isCacheable(const Armor *armor) const;
+	/// Blits the recorded parts as one cached frame.
+	void blitRecorded();
 public:
 	/// Creates a new UnitSprite at the specified position and size.
-	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet);
+	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, UnitSpriteCache* cache = nullptr);
 	/// Cleans up the UnitSprite.
 	~UnitSprite();
 	/// Draws the unit.
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "UnitSpriteCache.h"
+#include "../Engine/Surface.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty cache.
+ * @param capacity Maximum number of frames kept.
+ */
+UnitSpriteCache::UnitSpriteCache(size_t capacity) : _capacity(capacity)
+{
+}
+
+/**
+ * Deletes the cached frames.
+ */
+UnitSpriteCache::~UnitSpriteCache()
+{
+	for (auto& entry : _entries)
+	{
+		delete entry.frame.surface;
+	}
+}
+
+/**
+ * Gets a composed frame and marks it as recently used.
+ * @param key Everything the frame was composed from.
+ * @return Pointer to the frame or null if it is not cached.
+ */
+const UnitSpriteCache::Frame *UnitSpriteCache::find(const std::string &key)
+{
+	auto it = _index.find(key);
+	if (it == _index.end())
+	{
+		return nullptr;
+	}
+	_entries.splice(_entries.begin(), _entries, it->second);
+	return &it->second->frame;
+}
+
+/**
+ * Adds a composed frame, dropping the least recently used one if the cache is full.
+ * @param key Everything the frame was composed from.
+ * @param surface Composed frame, now owned by the cache.
+ * @param offX Horizontal position of the frame relative to the unit sprite.
+ * @param offY Vertical position of the frame relative to the unit sprite.
+ * @return Pointer to the added frame.
+ */
+const UnitSpriteCache::Frame *UnitSpriteCache::insert(const std::string &key, Surface *surface, int offX, int offY)
+{
+	if (_entries.size() >= _capacity)
+	{
+		Entry &last = _entries.back();
+		delete last.frame.surface;
+		_index.erase(last.key);
+		_entries.pop_back();
+	}
+	_entries.push_front(Entry{ key, Frame{ surface, offX, offY } });
+	_index[key] = _entries.begin();
+	return &_entries.front().frame;
+}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace OpenXcom
+{
+
+class Surface;
+
+/**
+ * Keeps recently composed unit frames (body parts and hand items with
+ * recoloring applied), so units that don't change between frames are
+ * drawn with a single blit. Frames are keyed by everything they were
+ * composed from, units that look the same share them.
+ * The least recently used frames are dropped when the cache is full.
+ */
+class UnitSpriteCache
+{
+public:
+	/// A composed frame, with its position relative to the unit sprite.
+	struct Frame
+	{
+		Surface *surface;
+		int offX, offY;
+	};
+private:
+	struct Entry
+	{
+		std::string key;
+		Frame frame;
+	};
+	size_t _capacity;
+	std::list<Entry> _entries;
+	std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+public:
+	/// Creates an empty cache.
+	UnitSpriteCache(size_t capacity = 2048);
+	/// Deletes the cached frames.
+	~UnitSpriteCache();
+	UnitSpriteCache(const UnitSpriteCache&) = delete;
+	UnitSpriteCache &operator=(const UnitSpriteCache&) = delete;
+
+	/// Gets a frame, or null if it is not cached.
+	const Frame *find(const std::string &key);
+	/// Adds a frame, taking ownership of the surface.
+	const Frame *insert(const std::string &key, Surface *surface, int offX, int offY);
+};
+
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "VisibilityMatrix.h"
+#include <algorithm>
+#include "../Savegame/Tile.h"
+#include "../Savegame/BattleUnit.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates a matrix without any units or map.
+ */
+VisibilityMatrix::VisibilityMatrix() : _firstTile(0), _mapSize(0)
+{
+}
+
+/**
+ * Sets a bit in a row, growing the row if needed.
+ * @param row Row of bits.
+ * @param bit Bit number.
+ * @return True if the bit wasn't set before.
+ */
+bool VisibilityMatrix::setBit(std::vector<Uint64> &row, int bit)
+{
+	size_t word = bit / 64;
+	Uint64 mask = (Uint64)1 << (bit % 64);
+	if (word >= row.size())
+	{
+		row.resize(word + 1, 0);
+	}
+	if (row[word] & mask)
+	{
+		return false;
+	}
+	row[word] |= mask;
+	return true;
+}
+
+/**
+ * Clears a bit in a row.
+ * @param row Row of bits.
+ * @param bit Bit number.
+ * @return True if the bit was set before.
+ */
+bool VisibilityMatrix::clearBit(std::vector<Uint64> &row, int bit)
+{
+	size_t word = bit / 64;
+	Uint64 mask = (Uint64)1 << (bit % 64);
+	if (word >= row.size() || !(row[word] & mask))
+	{
+		return false;
+	}
+	row[word] &= ~mask;
+	return true;
+}
+
+/**
+ * Tests a bit in a row, bits past the end of the row are unset.
+ * @param row Row of bits.
+ * @param bit Bit number.
+ * @return True if the bit is set.
+ */
+bool VisibilityMatrix::testBit(const std::vector<Uint64> &row, int bit)
+{
+	size_t word = bit / 64;
+	return word < row.size() && (row[word] & ((Uint64)1 << (bit % 64)));
+}
+
+/**
+ * Gets the index of a tile, tiles of a map are stored in one block.
+ * @param tile Tile of the current map.
+ * @return Index of the tile.
+ */
+int VisibilityMatrix::getTileIndex(const Tile *tile) const
+{
+	return (int)(tile - _firstTile);
+}
+
+/**
+ * Switches to a new map. Units keep their slots and what
+ * they see of other units, but no tiles are seen any more.
+ * @param firstTile First tile of the map.
+ * @param mapSize Number of tiles of the map.
+ */
+void VisibilityMatrix::reset(const Tile *firstTile, int mapSize)
+{
+	_firstTile = firstTile;
+	_mapSize = mapSize;
+	for (auto& row : _tiles)
+	{
+		row.clear();
+	}
+}
+
+/**
+ * Gives a unit the next free slot, if it doesn't have one yet.
+ * Slots aren't reused, so stale bits of deleted units never
+ * point at a new one.
+ * @param unit Unit to add.
+ */
+void VisibilityMatrix::attach(BattleUnit *unit)
+{
+	if (unit->getVisibilitySlot() >= 0)
+	{
+		return;
+	}
+	unit->setVisibility(this, (int)_units.size());
+	_units.push_back(unit);
+	_visible.emplace_back();
+	_spotted.emplace_back();
+	_tiles.emplace_back();
+}
+
+/**
+ * Frees the memory of a slot when its unit is deleted.
+ * @param slot Slot of the unit.
+ */
+void VisibilityMatrix::detach(int slot)
+{
+	_units[slot] = 0;
+	std::vector<Uint64>().swap(_visible[slot]);
+	std::vector<Uint64>().swap(_spotted[slot]);
+	std::vector<Uint64>().swap(_tiles[slot]);
+}
+
+/**
+ * Marks a unit as seen by another.
+ * @param viewer Slot of the unit looking.
+ * @param target Slot of the unit seen.
+ * @return True if the viewer didn't see it yet.
+ */
+bool VisibilityMatrix::addUnit(int viewer, int target)
+{
+	return setBit(_visible[viewer], target);
+}
+
+/**
+ * Marks a unit as not seen by another any more.
+ * @param viewer Slot of the unit looking.
+ * @param target Slot of the unit lost from view.
+ * @return True if the viewer saw it.
+ */
+bool VisibilityMatrix::removeUnit(int viewer, int target)
+{
+	return clearBit(_visible[viewer], target);
+}
+
+/**
+ * Forgets all the units seen by a unit.
+ * @param viewer Slot of the unit.
+ */
+void VisibilityMatrix::clearUnits(int viewer)
+{
+	std::fill(_visible[viewer].begin(), _visible[viewer].end(), 0);
+}
+
+/**
+ * Marks a unit as spotted by another during this turn.
+ * @param viewer Slot of the unit looking.
+ * @param target Slot of the unit spotted.
+ * @return True if it wasn't spotted yet this turn.
+ */
+bool VisibilityMatrix::addSpotted(int viewer, int target)
+{
+	return setBit(_spotted[viewer], target);
+}
+
+/**
+ * Forgets the units spotted by a unit, at the start of its turn.
+ * @param viewer Slot of the unit.
+ */
+void VisibilityMatrix::clearSpotted(int viewer)
+{
+	std::fill(_spotted[viewer].begin(), _spotted[viewer].end(), 0);
+}
+
+/**
+ * Marks a tile of the current map as seen by a unit.
+ * @param viewer Slot of the unit looking.
+ * @param tile Tile seen.
+ * @return True if the unit didn't see it yet.
+ */
+bool VisibilityMatrix::addTile(int viewer, const Tile *tile)
+{
+	auto& row = _tiles[viewer];
+	if (row.empty())
+	{
+		// allocate the whole map at once instead of growing word by word
+		row.resize((_mapSize + 63) / 64, 0);
+	}
+	return setBit(row, getTileIndex(tile));
+}
+
+/**
+ * Forgets all the tiles seen by a unit.
+ * @param viewer Slot of the unit.
+ */
+void VisibilityMatrix::clearTiles(int viewer)
+{
+	std::fill(_tiles[viewer].begin(), _tiles[viewer].end(), 0);
+}
+
+/**
+ * Checks if any unit of a faction sees a unit.
+ * @param faction Faction looking.
+ * @param target Slot of the unit.
+ * @return True if it's seen.
+ */
+bool VisibilityMatrix::isSeenByFaction(UnitFaction faction, int target) const
+{
+	for (size_t i = 0; i < _units.size(); ++i)
+	{
+		if (_units[i] && _units[i]->getFaction() == faction && testBit(_visible[i], target))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+enum UnitFaction : int;
+class BattleUnit;
+class Tile;
+
+/**
+ * Who sees what in a battle. Every unit gets a slot the first time it
+ * looks around, and for each slot the matrix keeps a bit per unit it sees,
+ * per unit it spotted this turn and per map tile it sees, so checks are
+ * a bit test and clearing a unit's view is a few word writes.
+ * Units keep their own lists of what they see for walking through them.
+ */
+class VisibilityMatrix
+{
+private:
+	std::vector<BattleUnit*> _units;
+	std::vector<std::vector<Uint64> > _visible, _spotted, _tiles;
+	const Tile *_firstTile;
+	int _mapSize;
+
+	/// Sets a bit in a row, returns true if it wasn't set.
+	static bool setBit(std::vector<Uint64> &row, int bit);
+	/// Clears a bit in a row, returns true if it was set.
+	static bool clearBit(std::vector<Uint64> &row, int bit);
+	/// Tests a bit in a row.
+	static bool testBit(const std::vector<Uint64> &row, int bit);
+	/// Gets the index of a tile of the map.
+	int getTileIndex(const Tile *tile) const;
+public:
+	/// Creates an empty matrix.
+	VisibilityMatrix();
+	/// Switches to a new map, forgetting all the visible tiles.
+	void reset(const Tile *firstTile, int mapSize);
+	/// Gives a unit a slot if it doesn't have one yet.
+	void attach(BattleUnit *unit);
+	/// Frees the slot of a unit that's being deleted.
+	void detach(int slot);
+	/// Marks a unit as seen by another, returns true if it's new.
+	bool addUnit(int viewer, int target);
+	/// Marks a unit as not seen by another, returns true if it was seen.
+	bool removeUnit(int viewer, int target);
+	/// Checks if a unit is seen by another.
+	bool hasUnit(int viewer, int target) const { return testBit(_visible[viewer], target); }
+	/// Forgets the units seen by a unit.
+	void clearUnits(int viewer);
+	/// Marks a unit as spotted this turn by another, returns true if it's new.
+	bool addSpotted(int viewer, int target);
+	/// Checks if a unit was spotted this turn by another.
+	bool hasSpotted(int viewer, int target) const { return testBit(_spotted[viewer], target); }
+	/// Forgets the units spotted this turn by a unit.
+	void clearSpotted(int viewer);
+	/// Marks a tile as seen by a unit, returns true if it's new.
+	bool addTile(int viewer, const Tile *tile);
+	/// Checks if a tile is seen by a unit.
+	bool hasTile(int viewer, const Tile *tile) const { return testBit(_tiles[viewer], getTileIndex(tile)); }
+	/// Forgets the tiles seen by a unit.
+	void clearTiles(int viewer);
+	/// Checks if any unit of a faction sees a unit.
+	bool isSeenByFaction(UnitFaction faction, int target) const;
+};
+
+}
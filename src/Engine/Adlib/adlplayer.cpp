@@ -25,6 +25,7 @@
 #include <cmath>
 #include <memory.h>
 #include "fmopl.h"
+#include "adlplayer.h"
 
 /* Reading a 2-byte value from an unaligned address requires byte-copies on some
  * systems, which the system-memcpy takes care of for us */
@@ -120,7 +121,7 @@ struct struc_adlib_channels {
 	unsigned char	cur_volume;
 	int				duration;
 	int				pan;
-} adlib_channels[12];
+};
 
 struct struc_instruments{
 	unsigned char	sample_id;
@@ -131,7 +132,7 @@ struct struc_instruments{
 	unsigned char*	cur_address;
 	unsigned char*	start_address;
 	unsigned char*	return_address;
-} instruments[16];
+};
 
 struct struc_sample{
 	unsigned char	reg20_op1;
@@ -147,28 +148,42 @@ struct struc_sample{
 	unsigned char	regC0;
 };
 
-int adl_gv_master_music_volume = 127;
-int adl_gv_tmp_music_volume = 127;
-bool adl_gv_want_fade = false;
-bool adl_gv_music_playing = false;
-int adl_gv_tempo = 120;
-int adl_gv_tempo_run = 60;
-int adl_gv_tempo_inc = 70;
-unsigned char* adl_gv_samples_addr = 0;
-unsigned char* adl_gv_subtracks[128];
-unsigned int adl_gv_instruments_count = 0;
-unsigned int adl_gv_subtracks_count = 0;
-int adl_gv_polyphony_level = 0;
-unsigned char adl_gv_chorus_instruments[16];
-int adl_gv_FORMAT = 0;//0 = without title, 1=with title
-UINT8 iFMReg[256];
-UINT8 iTweakedFMReg[256];
-UINT8 iCurrentTweakedBlock[12];
-UINT8 iCurrentFNum[12];
-struc_instruments saved_instruments[2][16];
-
 FM_OPL* opl[2] = {0, 0};
 
+//everything the player works on, the game has one and the renderer its own
+struct AdlibPlayerState
+{
+	struc_adlib_channels adlib_channels[12];
+	struc_instruments instruments[16];
+	int master_music_volume = 127;
+	int tmp_music_volume = 127;
+	bool want_fade = false;
+	bool music_playing = false;
+	int tempo = 120;
+	int tempo_run = 60;
+	int tempo_inc = 70;
+	unsigned char* samples_addr = 0;
+	unsigned char* subtracks[128];
+	unsigned int instruments_count = 0;
+	unsigned int subtracks_count = 0;
+	int polyphony_level = 0;
+	unsigned char chorus_instruments[16];
+	int FORMAT = 0;//0 = without title, 1=with title
+	UINT8 FMReg[256];
+	UINT8 TweakedFMReg[256];
+	UINT8 CurrentTweakedBlock[12];
+	UINT8 CurrentFNum[12];
+	struc_instruments saved_instruments[2][16];
+	int restarts = 0;
+	FM_OPL* chips[2] = {0, 0};
+	FM_OPL** opl = ::opl;//chips played on, the live ones unless it has its own
+};
+
+//the live player, shared by the game and the audio callback
+static AdlibPlayerState adl_live_state;
+//the state the player functions work on, per thread so the renderer can use its own
+static thread_local AdlibPlayerState* adl_state = &adl_live_state;
+
 #define NEWBLOCK_LIMIT  32
 #define FREQ_OFFSET 128.0//128.0//96.0
 
@@ -189,11 +204,11 @@ void Transpose(int reg, int val, int*val2, int *reg3, int*val3)
 		)) {
 		this->iFMReg[iRegister] = iValue;
 	}*/
-	iFMReg[iRegister] = iValue;
+	adl_state->FMReg[iRegister] = iValue;
 
 	if ((iChannel >= 0 && iChannel < 12)) {// && (i == 1)) {
-		UINT8  iBlock = (iFMReg[0xB0 + iChannel] >> 2) & 0x07;
-		UINT16 iFNum = ((iFMReg[0xB0 + iChannel] & 0x03) << 8) | iFMReg[0xA0 + iChannel];
+		UINT8  iBlock = (adl_state->FMReg[0xB0 + iChannel] >> 2) & 0x07;
+		UINT16 iFNum = ((adl_state->FMReg[0xB0 + iChannel] & 0x03) << 8) | adl_state->FMReg[0xA0 + iChannel];
 		//double dbOriginalFreq = 50000.0 * (double)iFNum * pow(2, iBlock - 20);
 		double dbOriginalFreq = 49716.0 * (double)iFNum / pow((double)2, (20 - iBlock));
 
@@ -252,16 +267,16 @@ void Transpose(int reg, int val, int*val2, int *reg3, int*val3)
 			// Overwrite the supplied value with the new F-Number and Block.
 			iValue = (iValue & ~0x1F) | (iNewBlock << 2) | ((iNewFNum >> 8) & 0x03);
 
-			iCurrentTweakedBlock[iChannel] = iNewBlock; // save it so we don't have to update register 0xB0 later on
-			iCurrentFNum[iChannel] = iNewFNum;
+			adl_state->CurrentTweakedBlock[iChannel] = iNewBlock; // save it so we don't have to update register 0xB0 later on
+			adl_state->CurrentFNum[iChannel] = iNewFNum;
 
-			if (iTweakedFMReg[0xA0 + iChannel] != (iNewFNum & 0xFF)) {
+			if (adl_state->TweakedFMReg[0xA0 + iChannel] != (iNewFNum & 0xFF)) {
 				// Need to write out low bits
 				UINT8  iAdditionalReg = 0xA0 + iChannel;
 				UINT8  iAdditionalValue = iNewFNum & 0xFF;
 				*reg3 = iAdditionalReg;
 				*val3 = iAdditionalValue;
-				iTweakedFMReg[iAdditionalReg] = iAdditionalValue;
+				adl_state->TweakedFMReg[iAdditionalReg] = iAdditionalValue;
 			}
 		} else if ((iRegister >= 0xA0) && (iRegister <= 0xAC)) {
 
@@ -269,16 +284,16 @@ void Transpose(int reg, int val, int*val2, int *reg3, int*val3)
 			iValue = iNewFNum & 0xFF;
 
 			// See if we need to update the block number, which is stored in a different register
-			UINT8  iNewB0Value = (iFMReg[0xB0 + iChannel] & ~0x1F) | (iNewBlock << 2) | ((iNewFNum >> 8) & 0x03);
+			UINT8  iNewB0Value = (adl_state->FMReg[0xB0 + iChannel] & ~0x1F) | (iNewBlock << 2) | ((iNewFNum >> 8) & 0x03);
 			if (
 				(iNewB0Value & 0x20) && // but only update if there's a note currently playing (otherwise we can just wait
-				(iTweakedFMReg[0xB0 + iChannel] != iNewB0Value)   // until the next noteon and update it then)
+				(adl_state->TweakedFMReg[0xB0 + iChannel] != iNewB0Value)   // until the next noteon and update it then)
 			) {
 					// The note is already playing, so we need to adjust the upper bits too
 					UINT8  iAdditionalReg = 0xB0 + iChannel;
 					*reg3 = iAdditionalReg;
 					*val3 = iNewB0Value;
-					iTweakedFMReg[iAdditionalReg] = iNewB0Value;
+					adl_state->TweakedFMReg[iAdditionalReg] = iNewB0Value;
 			} // else the note is not playing, the upper bits will be set when the note is next played
 
 		} // if (register 0xB0 or 0xA0)
@@ -287,20 +302,20 @@ void Transpose(int reg, int val, int*val2, int *reg3, int*val3)
 
 	// Now write to the original register with a possibly modified value
 	*val2=iValue;
-	iTweakedFMReg[iRegister] = iValue;
+	adl_state->TweakedFMReg[iRegister] = iValue;
 };
 
 /*
 void adlib_reg(int i, int v)
 {
 //	adlib0(i,v);
-	OPLWrite(opl[0],0,i);
-	OPLWrite(opl[0],1,v);
+	OPLWrite(adl_state->opl[0],0,i);
+	OPLWrite(adl_state->opl[0],1,v);
 
 //	if (i==1) v=0x20;
 	if (i==0xbd) v=0x00;
-	OPLWrite(opl[1],0,i);
-	OPLWrite(opl[1],1,v);
+	OPLWrite(adl_state->opl[1],0,i);
+	OPLWrite(adl_state->opl[1],1,v);
 //	YM3812Write(0, 0, i);
 //	YM3812Write(0, 1, v);
 }
@@ -308,14 +323,14 @@ void adlib_reg(int i, int v)
 
 void adlib_reg(int i, int v)
 {
-	if (opl[0]==0) return;
+	if (adl_state->opl[0]==0) return;
 	int v2, i3, v3;
 	i3 = -1;
 	Transpose(i, v, &v2, &i3, &v3);
 
-	OPLWrite(opl[0], 0, i);
-	OPLWrite(opl[0], 1, v);
-	OPLWrite(opl[1], 0, i);
+	OPLWrite(adl_state->opl[0], 0, i);
+	OPLWrite(adl_state->opl[0], 1, v);
+	OPLWrite(adl_state->opl[1], 0, i);
 	if (i >= 0x20 && i <= 0x3f) //no tremolo/vibrato
 		v2 = (v2 & 0x3F);
 	if (i >= 0xE0 && i <= 0xFC)
@@ -325,11 +340,11 @@ void adlib_reg(int i, int v)
 	}
 	// if ((i >= 0x60 && i <= 0x7F) && ((slot_array[i & 0x1f] & 1) == 1)) //altered attack/decoy
 	//	v2 = v2 ^ 0x20;
-	OPLWrite(opl[1], 1, v2);
+	OPLWrite(adl_state->opl[1], 1, v2);
 	if (i3 != -1)
 	{
-		OPLWrite(opl[1], 0, i3);
-		OPLWrite(opl[1], 1, v3);
+		OPLWrite(adl_state->opl[1], 0, i3);
+		OPLWrite(adl_state->opl[1], 1, v3);
 	}
 }
 
@@ -358,8 +373,8 @@ void clear_channels()
 {
 	for (int i=0; i<12; ++i)
 	{
-		adlib_channels[i].cur_sample = 0xff;
-		adlib_channels[i].cur_note = 0;
+		adl_state->adlib_channels[i].cur_sample = 0xff;
+		adl_state->adlib_channels[i].cur_note = 0;
 	}
 }
 
@@ -377,7 +392,7 @@ void adlib_reset_channels()
 // returns note frequency with pitch wheel value applied
 int get_pitched_freq_instr(int note, int instrument)
 {
-	int pitch = instruments[instrument].cur_pitchbend;
+	int pitch = adl_state->instruments[instrument].cur_pitchbend;
 	if (pitch==0)
 		return adl_gv_freq_table[note];
 	else if (pitch>0)
@@ -391,17 +406,17 @@ int get_pitched_freq_instr(int note, int instrument)
 // !!! probably should also apply pitch for CHORUS instrument !!!
 void adlib_set_instrument_pitch(int instrument, int pitch)
 {
-	instruments[instrument].cur_pitchbend = pitch;
+	adl_state->instruments[instrument].cur_pitchbend = pitch;
 	for (int i=0; i<12; ++i) //search through active adlib channels
 	{
-		int note = adlib_channels[i].cur_note;
-		if (note != 0 && adlib_channels[i].cur_instrument == instrument)
+		int note = adl_state->adlib_channels[i].cur_note;
+		if (note != 0 && adl_state->adlib_channels[i].cur_instrument == instrument)
 		{
 			int freq = get_pitched_freq_instr(note, instrument);
-			adlib_channels[i].cur_freq = freq;
+			adl_state->adlib_channels[i].cur_freq = freq;
 			adlib_reg(0xA0+i, freq & 0xff);
 			int hf=((freq>>8) & 0x03) | (adl_gv_octave_table[note]<<2);
-			adlib_channels[i].hifreq = hf;
+			adl_state->adlib_channels[i].hifreq = hf;
 			adlib_reg(0xB0+i, hf | 0x20);
 		}
 	}
@@ -414,16 +429,16 @@ int adlib_get_unused_channel(int sample_id, bool* same_sample)
 	//bool empty=false;
 
 	for (i=0; i<12; ++i)
-		++adlib_channels[i].duration;
+		++adl_state->adlib_channels[i].duration;
 
 	for (i=0; i<12; ++i) //12/9
 	{
-		if (adlib_channels[i].duration > maxdur)
+		if (adl_state->adlib_channels[i].duration > maxdur)
 		{
-			maxdur = adlib_channels[i].duration;
+			maxdur = adl_state->adlib_channels[i].duration;
 			maxchan = i;
 		}
-		if (adlib_channels[i].cur_note == 0) //empty channel
+		if (adl_state->adlib_channels[i].cur_note == 0) //empty channel
 		{
 			maxchan = i;
 			//empty = true;
@@ -432,11 +447,11 @@ int adlib_get_unused_channel(int sample_id, bool* same_sample)
 	}
 
 	//if (!empty) printf("   POLYPHONY - channel %d replaced\n", maxchan);
-	if (adlib_channels[maxchan].cur_sample == sample_id)
+	if (adl_state->adlib_channels[maxchan].cur_sample == sample_id)
 		*same_sample = true;
 	else
-		adlib_channels[maxchan].cur_sample = sample_id;
-	adlib_channels[maxchan].duration = 0;
+		adl_state->adlib_channels[maxchan].cur_sample = sample_id;
+	adl_state->adlib_channels[maxchan].duration = 0;
 	return maxchan;
 }
 
@@ -444,7 +459,7 @@ int adlib_get_unused_channel(int sample_id, bool* same_sample)
 void adlib_play_note(int note, int volume, int instrument)
 {
 	struc_sample* cur_sample;
-	int sample_id = instruments[instrument].sample_id;
+	int sample_id = adl_state->instruments[instrument].sample_id;
 	int channel;
 	int ampl;
 	int op1;
@@ -460,27 +475,27 @@ void adlib_play_note(int note, int volume, int instrument)
 	}
 	else //ordinary sample
 */	{
-		cur_sample = (struc_sample*)(adl_gv_samples_addr + sample_id*24);
+		cur_sample = (struc_sample*)(adl_state->samples_addr + sample_id*24);
 	}
 	note--;
 	if (volume == 0) //stop note
 	{
 		for(int i=0; i<12; ++i)
 		{
-			if (adlib_channels[i].cur_note == note &&
-				adlib_channels[i].cur_instrument == instrument)
+			if (adl_state->adlib_channels[i].cur_note == note &&
+				adl_state->adlib_channels[i].cur_instrument == instrument)
 			{
-				adlib_channels[i].cur_note = 0; //clear channel
-				adlib_reg(0xB0+i, adlib_channels[i].hifreq); //mute note
+				adl_state->adlib_channels[i].cur_note = 0; //clear channel
+				adlib_reg(0xB0+i, adl_state->adlib_channels[i].hifreq); //mute note
 			}
 		}
 		return;
 	}
 	if (volume>127) volume=127;
 	channel = adlib_get_unused_channel(sample_id, &same_sample);
-	adlib_channels[channel].cur_volume = volume;
-	adlib_channels[channel].cur_note = note;
-	adlib_channels[channel].cur_instrument = instrument;
+	adl_state->adlib_channels[channel].cur_volume = volume;
+	adl_state->adlib_channels[channel].cur_note = note;
+	adl_state->adlib_channels[channel].cur_instrument = instrument;
 	op1 = adl_gv_operators1[channel];
 	if (!same_sample)
 	{
@@ -490,8 +505,8 @@ void adlib_play_note(int note, int volume, int instrument)
 		adlib_reg(0x40+op1, ((~ampl) & 0x3f) | (ampl & 0xc0)); // amplitude op1
 	}
 
-	adlib_reg(0xB0+channel, adlib_channels[channel].hifreq);  // reinit note
-	adlib_reg(0x43+op1, (~((adl_gv_tmp_music_volume*volume)>>8))&0x3f); //amplitude op2
+	adlib_reg(0xB0+channel, adl_state->adlib_channels[channel].hifreq);  // reinit note
+	adlib_reg(0x43+op1, (~((adl_state->tmp_music_volume*volume)>>8))&0x3f); //amplitude op2
 
 	if (!same_sample)
 	{
@@ -505,10 +520,10 @@ void adlib_play_note(int note, int volume, int instrument)
 	}
 
 	int freq = get_pitched_freq_instr(note, instrument);
-	adlib_channels[channel].cur_freq = freq;
+	adl_state->adlib_channels[channel].cur_freq = freq;
 	adlib_reg(0xA0+channel, freq & 0xff);
 	int hf=(freq>>8) | (adl_gv_octave_table[note]<<2);
-	adlib_channels[channel].hifreq = hf;
+	adl_state->adlib_channels[channel].hifreq = hf;
 	adlib_reg(0xB0+channel, hf | 0x20); //reinit note
 }
 
@@ -528,25 +543,25 @@ int get_numseq(unsigned char** mus_ptr)
 //MAIN FUNCTION - instantly stops music
 void func_mute()
 {
-	adl_gv_polyphony_level = 0;
-	adl_gv_music_playing = false;
+	adl_state->polyphony_level = 0;
+	adl_state->music_playing = false;
 	adlib_reset_channels();
 }
 
 //decrease volume until 0 with each call, and then stops music
 void fade_volume_if_need()
 {
-	if (!adl_gv_want_fade) return;
-	if (--adl_gv_tmp_music_volume == 0)
+	if (!adl_state->want_fade) return;
+	if (--adl_state->tmp_music_volume == 0)
 	{
 		func_mute();
-		adl_gv_want_fade = false;
-		adl_gv_tmp_music_volume = adl_gv_master_music_volume;
+		adl_state->want_fade = false;
+		adl_state->tmp_music_volume = adl_state->master_music_volume;
 		return;
 	}
 	for (int i=0; i<12; ++i)
 	{
-		adlib_set_amplitude(i, (adlib_channels[i].cur_volume*adl_gv_tmp_music_volume)>>7);
+		adlib_set_amplitude(i, (adl_state->adlib_channels[i].cur_volume*adl_state->tmp_music_volume)>>7);
 	}
 }
 
@@ -556,7 +571,7 @@ bool free_channel_available()
 
 	for (int i=0; i<12; ++i)
 	{
-		if (adlib_channels[i].cur_note==0)
+		if (adl_state->adlib_channels[i].cur_note==0)
 			return true;
 	}
 	return false;
@@ -566,7 +581,7 @@ bool free_channel_available()
 int decode_op(int instrument, bool* another_loop)
 {
 //	const track=2;
-	struc_instruments* instr1 = &instruments[instrument];
+	struc_instruments* instr1 = &adl_state->instruments[instrument];
 	struc_instruments* instr2;
 	unsigned char* music_ptr = instr1->cur_address;
 	unsigned char opcode,arg1,arg2;
@@ -579,7 +594,7 @@ int decode_op(int instrument, bool* another_loop)
 			arg1 = *(music_ptr++);
 				//printf("Call for subtrack [%d] %d\n",instrument,arg1);
 			instr1->return_address = music_ptr;
-			music_ptr = adl_gv_subtracks[arg1];
+			music_ptr = adl_state->subtracks[arg1];
 		}
 		else if (opcode == 0xfd) //return from subtrack
 		{
@@ -597,7 +612,7 @@ int decode_op(int instrument, bool* another_loop)
 		else if (opcode == 0xff) //finishing track
 		{
 				//printf("Track finish [%d]\n",instrument);
-			adl_gv_music_playing = false;
+			adl_state->music_playing = false;
 			delay = 0;
 			break;
 		}
@@ -617,11 +632,11 @@ int decode_op(int instrument, bool* another_loop)
 				arg2 = *(music_ptr++);
 					//printf("Opcode [%d] NOTE OFF: %d\n", instrument, arg1);
 				adlib_play_note(arg1,0,instrument);
-				--adl_gv_polyphony_level;
-				if (adl_gv_chorus_instruments[instrument] != 0)
+				--adl_state->polyphony_level;
+				if (adl_state->chorus_instruments[instrument] != 0)
 				{
-					adlib_play_note(arg1,0,adl_gv_chorus_instruments[instrument]);
-					--adl_gv_polyphony_level;
+					adlib_play_note(arg1,0,adl_state->chorus_instruments[instrument]);
+					--adl_state->polyphony_level;
 				}
 				break;
 			case 0x90: //note on
@@ -630,53 +645,53 @@ int decode_op(int instrument, bool* another_loop)
 				{
 						//printf("Opcode [%d] NOTE off: %d, volume=%d\n", instrument, arg1, arg2);
 					adlib_play_note(arg1,0,instrument);
-					--adl_gv_polyphony_level;
-					if (adl_gv_chorus_instruments[instrument] != 0)
+					--adl_state->polyphony_level;
+					if (adl_state->chorus_instruments[instrument] != 0)
 					{
-						adlib_play_note(arg1,0,adl_gv_chorus_instruments[instrument]);
-						--adl_gv_polyphony_level;
+						adlib_play_note(arg1,0,adl_state->chorus_instruments[instrument]);
+						--adl_state->polyphony_level;
 					}
 				}
 				else
 				{
 						//printf("Opcode [%d] NOTE ON: %d, volume=%d\n", instrument, arg1, arg2);
 					int vol = (arg2*instr1->volume)>>7;
-					if (adl_gv_chorus_instruments[instrument] != 0)
+					if (adl_state->chorus_instruments[instrument] != 0)
 					{
 						if (free_channel_available())
 						{
-							instr2 = &instruments[adl_gv_chorus_instruments[instrument]];
+							instr2 = &adl_state->instruments[adl_state->chorus_instruments[instrument]];
 							instr2->sample_id = instr1->sample_id;
 							instr2->cur_pitchbend = instr1->cur_pitchbend-1;
-							adlib_play_note(arg1,vol,adl_gv_chorus_instruments[instrument]);
+							adlib_play_note(arg1,vol,adl_state->chorus_instruments[instrument]);
 						}
-						++adl_gv_polyphony_level; //increase it nevertheless, because it SHOULD play
+						++adl_state->polyphony_level; //increase it nevertheless, because it SHOULD play
 					}
 					adlib_play_note(arg1,vol,instrument);
-					++adl_gv_polyphony_level;
+					++adl_state->polyphony_level;
 				}
 				break;
 			case 0xB0: //set controller
 				arg2 = *(music_ptr++);
 					//printf("Opcode [%d] CONTROLLER: %02Xh, %d\n", instrument, arg1, arg2);
 				if (arg1 == 0 && arg2 != 0) //tempo change
-					adl_gv_tempo = arg2 * 0.8;
+					adl_state->tempo = arg2 * 0.8;
 				else if (arg1 == 7) //channel volume change
 				{
 					instr1->volume = arg2;
 /*					for (i=0; i<9; ++i)
 					{
-						if (instrument == adlib_channels[i].cur_instrument)
+						if (instrument == adl_state->adlib_channels[i].cur_instrument)
 						{
-							adlib_channels[i].cur_volume = arg2;
-							adlib_set_amplitude(i, (arg2*adl_gv_tmp_music_volume)>>7);
+							adl_state->adlib_channels[i].cur_volume = arg2;
+							adlib_set_amplitude(i, (arg2*adl_state->tmp_music_volume)>>7);
 						}
 					}
 */				}
 				else if (arg1 == 0x7e) //setting up chorus (slave) instrument
-					adl_gv_chorus_instruments[instrument] = arg2-1;
+					adl_state->chorus_instruments[instrument] = arg2-1;
 				else if (arg1 == 0x7f) //clearing chorus (slave) instrument
-					adl_gv_chorus_instruments[instrument] = 0;
+					adl_state->chorus_instruments[instrument] = 0;
 
 				break;
 			case 0xC0: //set sample
@@ -695,8 +710,8 @@ int decode_op(int instrument, bool* another_loop)
 					//printf("Opcode [%d] PITCH BEND: %d\n", instrument, arg1-16);
 				instr1->cur_pitchbend = arg1-16; // no need???
 				adlib_set_instrument_pitch(instrument, arg1-16);
-				if (adl_gv_chorus_instruments[instrument] != 0)
-					adlib_set_instrument_pitch(adl_gv_chorus_instruments[instrument], arg1-17);
+				if (adl_state->chorus_instruments[instrument] != 0)
+					adlib_set_instrument_pitch(adl_state->chorus_instruments[instrument], arg1-17);
 			}
 		}
 		delay = get_numseq(&music_ptr);
@@ -714,39 +729,39 @@ void init_music_data(unsigned char* music_ptr,int length)
 	unsigned char* start=music_ptr;
 	for (i=0; i<16; ++i)
 	{
-		instruments[i].start_address = 0;
+		adl_state->instruments[i].start_address = 0;
 	}
-	adl_gv_subtracks_count = 0;
+	adl_state->subtracks_count = 0;
 
 	i = *music_ptr;
-	if (i>56) adl_gv_FORMAT=0; //switch to old
-	else  adl_gv_FORMAT=1;
-	if (adl_gv_FORMAT==1) music_ptr += (*music_ptr )+1; //skip name
-	adl_gv_tempo = *(music_ptr++);
-	adl_gv_samples_addr = music_ptr+1; //samples
+	if (i>56) adl_state->FORMAT=0; //switch to old
+	else  adl_state->FORMAT=1;
+	if (adl_state->FORMAT==1) music_ptr += (*music_ptr )+1; //skip name
+	adl_state->tempo = *(music_ptr++);
+	adl_state->samples_addr = music_ptr+1; //samples
 	music_ptr += ((*music_ptr) * 24) +1; //moving to next section - subtracks
-	adl_gv_subtracks_count = *(music_ptr++);
-	for(i=0; i<adl_gv_subtracks_count; ++i)
+	adl_state->subtracks_count = *(music_ptr++);
+	for(i=0; i<adl_state->subtracks_count; ++i)
 	{
 		to_add = peek_u16(music_ptr); //reading 16bit length
-		adl_gv_subtracks[i] = music_ptr+4; //store subtrack pointers
+		adl_state->subtracks[i] = music_ptr+4; //store subtrack pointers
 		music_ptr += to_add;
 	}
-	adl_gv_instruments_count = *(music_ptr++);
-	for (i=0; i<adl_gv_instruments_count; ++i)
+	adl_state->instruments_count = *(music_ptr++);
+	for (i=0; i<adl_state->instruments_count; ++i)
 	{
 		to_add = peek_u16(music_ptr); //reading 16bit length
-		if (adl_gv_FORMAT==1)
+		if (adl_state->FORMAT==1)
 		{
 			j = *(music_ptr+4);
 			if (j>15) j=15;
-			instruments[j].start_address = music_ptr+5;
+			adl_state->instruments[j].start_address = music_ptr+5;
 		}
 		else
-		if (adl_gv_FORMAT==0)
+		if (adl_state->FORMAT==0)
 		{
 			j = i;
-			instruments[j].start_address = music_ptr+4; //old format, without title
+			adl_state->instruments[j].start_address = music_ptr+4; //old format, without title
 		}
 		music_ptr += to_add;
 		if (music_ptr-start>=length)
@@ -763,17 +778,17 @@ void init_music()
 {
 	for (int i=0; i<16; ++i)
 	{
-		instruments[i].cur_pitchbend = 0;
-		adl_gv_chorus_instruments[i] = 0;
-		if (instruments[i].start_address != 0)
+		adl_state->instruments[i].cur_pitchbend = 0;
+		adl_state->chorus_instruments[i] = 0;
+		if (adl_state->instruments[i].start_address != 0)
 		{
-			instruments[i].cur_address = instruments[i].start_address;
-			instruments[i].cur_delay = get_numseq(&instruments[i].cur_address);
+			adl_state->instruments[i].cur_address = adl_state->instruments[i].start_address;
+			adl_state->instruments[i].cur_delay = get_numseq(&adl_state->instruments[i].cur_address);
 		}
 		else
 		{
-			instruments[i].cur_address = 0;
-			instruments[i].cur_delay = 0;
+			adl_state->instruments[i].cur_address = 0;
+			adl_state->instruments[i].cur_delay = 0;
 		}
 	}
 }
@@ -781,13 +796,13 @@ void init_music()
 //save music state
 void func_save_music_state(int i)
 {
-	memcpy(&saved_instruments[i], &instruments, sizeof(instruments));
+	memcpy(&adl_state->saved_instruments[i], &adl_state->instruments, sizeof(adl_state->instruments));
 }
 //load music state
 void func_load_music_state(int i)
 {
 	adlib_reset_channels();
-	memcpy(&instruments, &saved_instruments[i], sizeof(instruments));
+	memcpy(&adl_state->instruments, &adl_state->saved_instruments[i], sizeof(adl_state->instruments));
 }
 
 
@@ -796,11 +811,11 @@ void func_play_tick()
 {
 	bool another_loop;
 
-	if (!adl_gv_music_playing) return;
+	if (!adl_state->music_playing) return;
 	fade_volume_if_need();
-	adl_gv_tempo_run -= adl_gv_tempo;
-	if (adl_gv_tempo_run>0) return;
-	adl_gv_tempo_run += adl_gv_tempo_inc;
+	adl_state->tempo_run -= adl_state->tempo;
+	if (adl_state->tempo_run>0) return;
+	adl_state->tempo_run += adl_state->tempo_inc;
 
 	do {
 		another_loop = false;
@@ -808,15 +823,16 @@ void func_play_tick()
 		{
 			int instr = adl_gv_instr_order[i];
 //			if (instr!=10) continue;
-			if (instruments[instr].cur_address == 0) continue;
-			if (instruments[instr].cur_delay == 0)
+			if (adl_state->instruments[instr].cur_address == 0) continue;
+			if (adl_state->instruments[instr].cur_delay == 0)
 			{
-				instruments[instr].cur_delay = decode_op(instr,&another_loop);
-				if (!adl_gv_music_playing) break;
+				adl_state->instruments[instr].cur_delay = decode_op(instr,&another_loop);
+				if (!adl_state->music_playing) break;
 			}
-			--instruments[instr].cur_delay;
+			--adl_state->instruments[instr].cur_delay;
 		}
-		if (!another_loop && adl_gv_music_playing) break;
+		if (!another_loop && adl_state->music_playing) break;
+		if (adl_state->music_playing) ++adl_state->restarts;
 		init_music();
 		clear_channels();
 	} while (another_loop);
@@ -825,56 +841,89 @@ void func_play_tick()
 //MAIN FUNCTION - setup music for playing
 void func_setup_music(unsigned char* music_ptr, int length)
 {
-	adl_gv_music_playing = false;
+	adl_state->music_playing = false;
 	func_mute();
-	adl_gv_polyphony_level = 0;
-	adl_gv_want_fade = false;
-	adl_gv_tmp_music_volume = adl_gv_master_music_volume;
+	adl_state->polyphony_level = 0;
+	adl_state->want_fade = false;
+	adl_state->tmp_music_volume = adl_state->master_music_volume;
 	init_music_data(music_ptr,length);
 	init_music();
 	adlib_init();
 	adlib_reset_channels();
-	adl_gv_tempo *= 0.4;
-	adl_gv_tempo_run = adl_gv_tempo;
-	adl_gv_music_playing = true;
+	adl_state->tempo *= 0.4;
+	adl_state->tempo_run = adl_state->tempo;
+	adl_state->restarts = 0;
+	adl_state->music_playing = true;
 }
 
 //MAIN FUNCTION - initialize fade procedure
 void func_fade()
 {
-	if (adl_gv_tmp_music_volume == 0)
+	if (adl_state->tmp_music_volume == 0)
 	{
 		func_mute();
 	}
 	else
 	{
-		adl_gv_want_fade = true;
+		adl_state->want_fade = true;
 	}
 }
 
 //MAIN FUNCTION - check if music finished
 bool func_is_music_playing()
 {
-	return adl_gv_music_playing;
+	return adl_state->music_playing;
 }
 
 void func_set_music_tempo(int value)
 {
-	adl_gv_tempo_inc = value;
+	adl_state->tempo_inc = value;
 }
 
 void func_set_music_volume(int value)
 {
-	adl_gv_master_music_volume = value;
-	adl_gv_tmp_music_volume = adl_gv_master_music_volume;
+	adl_state->master_music_volume = value;
+	adl_state->tmp_music_volume = adl_state->master_music_volume;
 
 	for (int i=0; i<12; ++i)
 	{
-		adlib_set_amplitude(i, (adlib_channels[i].cur_volume*adl_gv_tmp_music_volume)>>7);
+		adlib_set_amplitude(i, (adl_state->adlib_channels[i].cur_volume*adl_state->tmp_music_volume)>>7);
 	}
 }
 
 int func_get_polyphony()
 {
-	return adl_gv_polyphony_level;
+	return adl_state->polyphony_level;
+}
+
+int func_get_restarts()
+{
+	return adl_state->restarts;
+}
+
+//creates a player state at the initial settings, with its own pair of chips
+AdlibPlayerState* func_create_state(int rate)
+{
+	AdlibPlayerState* state = new AdlibPlayerState();
+	state->opl = state->chips;
+	state->opl[0] = OPLCreate(OPL_TYPE_YM3812, 3579545, rate);
+	state->opl[1] = OPLCreate(OPL_TYPE_YM3812, 3579545, rate);
+	return state;
+}
+
+void func_destroy_state(AdlibPlayerState* state)
+{
+	if (state->opl[0]) OPLDestroy(state->opl[0]);
+	if (state->opl[1]) OPLDestroy(state->opl[1]);
+	delete state;
+}
+
+void func_use_state(AdlibPlayerState* state)
+{
+	adl_state = state ? state : &adl_live_state;
+}
+
+FM_OPL* func_get_chip(int i)
+{
+	return adl_state->opl[i];
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "fmopl.h"
 /* ADLPLAYER.H
  *
  * player functions for midi-like adlib music
@@ -19,3 +20,14 @@ void func_set_music_volume(int value);
 int func_get_polyphony();
 void func_save_music_state(int i);
 void func_load_music_state(int i);
+//counts how many times the track started over since setup
+int func_get_restarts();
+
+//player state with chips of its own, for rendering tracks on the side
+struct AdlibPlayerState;
+AdlibPlayerState* func_create_state(int rate);
+void func_destroy_state(AdlibPlayerState* state);
+//makes the player functions work on the given state on the calling thread, null for the live player
+void func_use_state(AdlibPlayerState* state);
+//gets a chip of the state the player functions work on
+FM_OPL* func_get_chip(int i);
@@ -38,6 +38,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <mutex>
 #include <cmath>
 //#include "driver.h"		/* use M.A.M.E. */
 #include "fmopl.h"
@@ -217,23 +218,24 @@ static INT32 RATE_0[16]=
 
 /* lock level of common table */
 static int num_lock = 0;
+/* chips may be created and updated on several threads */
+static std::mutex table_mutex;
 
-/* work table */
-static void *cur_chip = NULL;	/* current chip point */
+/* work table, per thread so chips can be updated side by side */
 /* current chip state */
 /* static OPLSAMPLE  *bufL,*bufR; */
-static OPL_CH *S_CH;
-static OPL_CH *E_CH;
-OPL_SLOT *SLOT7_1,*SLOT7_2,*SLOT8_1,*SLOT8_2;
-
-static INT32 outd[1];
-static INT32 ams;
-static INT32 vib;
-INT32  *ams_table;
-INT32  *vib_table;
-static INT32 amsIncr;
-static INT32 vibIncr;
-static INT32 feedback2;		/* connect for SLOT 2 */
+static thread_local OPL_CH *S_CH;
+static thread_local OPL_CH *E_CH;
+static thread_local OPL_SLOT *SLOT7_1,*SLOT7_2,*SLOT8_1,*SLOT8_2;
+
+static thread_local INT32 outd[1];
+static thread_local INT32 ams;
+static thread_local INT32 vib;
+static thread_local INT32  *ams_table;
+static thread_local INT32  *vib_table;
+static thread_local INT32 amsIncr;
+static thread_local INT32 vibIncr;
+static thread_local INT32 feedback2;		/* connect for SLOT 2 */
 
 /* log output level */
 #define LOG_ERR  3      /* ERROR       */
@@ -363,14 +365,6 @@ INLINE UINT32 OPL_CALC_SLOT( OPL_SLOT *SLOT )
 	return SLOT->TLL+ENV_CURVE[SLOT->evc>>ENV_BITS]+(SLOT->ams ? ams : 0);
 }
 
-/* set algorithm connection */
-static void set_algorythm( OPL_CH *CH)
-{
-	INT32 *carrier = &outd[0];
-	CH->connect1 = CH->CON ? carrier : &feedback2;
-	CH->connect2 = carrier;
-}
-
 /* ---------- frequency counter for operator update ---------- */
 INLINE void CALC_FCSLOT(OPL_CH *CH,OPL_SLOT *SLOT)
 {
@@ -460,6 +454,8 @@ INLINE void OPL_CALC_CH( OPL_CH *CH )
 {
 	UINT32 env_out;
 	OPL_SLOT *SLOT;
+	/* algorithm connection, looked up here since the outputs are per thread */
+	INT32 *connect1 = CH->CON ? &outd[0] : &feedback2;
 
 	feedback2 = 0;
 	/* SLOT 1 */
@@ -475,11 +471,11 @@ INLINE void OPL_CALC_CH( OPL_CH *CH )
 		{
 			int feedback1 = (CH->op1_out[0]+CH->op1_out[1])>>CH->FB;
 			CH->op1_out[1] = CH->op1_out[0];
-			*CH->connect1 += CH->op1_out[0] = OP_OUT(SLOT,env_out,feedback1);
+			*connect1 += CH->op1_out[0] = OP_OUT(SLOT,env_out,feedback1);
 		}
 		else
 		{
-			*CH->connect1 += OP_OUT(SLOT,env_out,0);
+			*connect1 += OP_OUT(SLOT,env_out,0);
 		}
 	}else
 	{
@@ -996,7 +992,6 @@ static void OPLWriteReg(FM_OPL *OPL, int r, int v)
 		int feedback = (v>>1)&7;
 		CH->FB   = feedback ? (8+1) - feedback : 0;
 		CH->CON = v&1;
-		set_algorythm(CH);
 		}
 		return;
 	case 0xe0: /* wave type */
@@ -1015,10 +1010,10 @@ static void OPLWriteReg(FM_OPL *OPL, int r, int v)
 /* lock/unlock for common table */
 static int OPL_LockTable(void)
 {
+	std::lock_guard<std::mutex> lock(table_mutex);
 	num_lock++;
 	if(num_lock>1) return 0;
 	/* first time */
-	cur_chip = NULL;
 	/* allocate total level table (128kb space) */
 	if( !OPLOpenTable() )
 	{
@@ -1030,10 +1025,10 @@ static int OPL_LockTable(void)
 
 static void OPL_UnLockTable(void)
 {
+	std::lock_guard<std::mutex> lock(table_mutex);
 	if(num_lock) num_lock--;
 	if(num_lock) return;
 	/* last time */
-	cur_chip = NULL;
 	OPLCloseTable();
 }
 
@@ -1053,8 +1048,8 @@ void YM3812UpdateOne(FM_OPL *OPL, INT16 *buffer, int length, int stripe, float v
 	UINT8 rythm = OPL->rythm&0x20;
 	OPL_CH *CH,*R_CH;
 
-	if( (void *)OPL != cur_chip ){
-		cur_chip = (void *)OPL;
+	/* load the chip every time, the last one may have been freed on another thread */
+	{
 		/* channel pointers */
 		S_CH = OPL->P_CH;
 		E_CH = &S_CH[9];
@@ -1119,8 +1114,8 @@ void Y8950UpdateOne(FM_OPL *OPL, INT16 *buffer, int length)
 	/* setup DELTA-T unit */
 	YM_DELTAT_DECODE_PRESET(DELTAT);
 
-	if( (void *)OPL != cur_chip ){
-		cur_chip = (void *)OPL;
+	/* load the chip every time, the last one may have been freed on another thread */
+	{
 		/* channel pointers */
 		S_CH = OPL->P_CH;
 		E_CH = &S_CH[9];
@@ -81,8 +81,6 @@ typedef struct fm_opl_channel {
 	OPL_SLOT SLOT[2];
 	UINT8 CON;			/* connection type                     */
 	UINT8 FB;			/* feed back       :(shift down bit)   */
-	INT32 *connect1;	/* slot1 output pointer                */
-	INT32 *connect2;	/* slot2 output pointer                */
 	INT32 op1_out[2];	/* slot1 output for selfeedback        */
 	/* phase generator state */
 	UINT32  block_fnum;	/* block+fnum      :                   */
@@ -18,7 +18,16 @@
  */
 #include "AdlibMusic.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include "Options.h"
+#include "Exception.h"
 #include "Logger.h"
 #include "Game.h"
 #include "SDL2Helpers.h"
@@ -31,6 +40,269 @@ extern FM_OPL* opl[2];
 namespace OpenXcom
 {
 
+/**
+ * An Adlib track rendered to a WAV file in memory.
+ */
+struct AdlibTrack
+{
+	std::vector<Uint8> wav;
+	bool loops;
+};
+
+namespace
+{
+
+const size_t MAX_RENDERED_BYTES = 64 * 1024 * 1024;
+const size_t MAX_TRACK_BYTES = MAX_RENDERED_BYTES / 4; // so the cache always holds a few tracks, longer ones play live
+const int RENDER_SLICE = 4 * 2048; // bytes synthesized between checks for quitting
+
+/// The live player and chips are shared by the game and the audio callback.
+std::mutex synthMutex;
+/// The track whose rendered music is loaded in SDL_mixer.
+const AdlibMusic *renderedHolder = 0;
+
+/**
+ * Renders Adlib tracks to PCM on a thread of its own, one at a time.
+ * The renderer thread has its own player state and chips, so it
+ * never waits for the live player or holds up the audio callback.
+ * The results are kept by track, dropping the least recently played
+ * ones when there are too many.
+ */
+class AdlibRenderer
+{
+private:
+	struct Entry
+	{
+		std::shared_ptr<const AdlibTrack> track; // null until rendered, stays null if it can't be
+		Uint64 lastUse;
+	};
+	struct Job
+	{
+		Uint64 key;
+		std::vector<Uint8> data;
+		float volume;
+		int rate, tickBytes;
+	};
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::unordered_map<Uint64, Entry> _entries;
+	std::deque<Job> _jobs;
+	Uint64 _uses;
+	size_t _bytes;
+	std::atomic<bool> _quit;
+	std::thread _thread;
+
+	/// Writes a little endian value into the WAV header.
+	static void put(std::vector<Uint8> &wav, size_t pos, Uint32 value, int bytes)
+	{
+		for (int i = 0; i < bytes; ++i)
+		{
+			wav[pos + i] = (value >> (i * 8)) & 0xFF;
+		}
+	}
+
+	/**
+	 * Plays a track through from the start into a WAV file.
+	 * Stops at the end of the track or when it starts over.
+	 * @param job Track to render.
+	 * @param track Rendered track.
+	 * @return False if the track doesn't fit its share of the cache or the renderer is quitting.
+	 */
+	bool render(const Job &job, AdlibTrack &track)
+	{
+		const size_t header = 44;
+		const size_t maxBytes = header + MAX_TRACK_BYTES;
+		std::vector<Uint8> &wav = track.wav;
+		wav.resize(header);
+
+		AdlibPlayerState *state = func_create_state(job.rate);
+		func_use_state(state);
+		func_setup_music((unsigned char*)job.data.data(), job.data.size());
+		func_set_music_volume(127 * job.volume);
+		FM_OPL *chip0 = func_get_chip(0), *chip1 = func_get_chip(1);
+
+		int tickDelay = 0;
+		bool done = false;
+		while (!done && !_quit && wav.size() < maxBytes)
+		{
+			size_t start = wav.size();
+			wav.resize(start + RENDER_SLICE);
+			Uint8 *stream = wav.data() + start;
+			int len = RENDER_SLICE;
+			while (len != 0)
+			{
+				int i = std::min(tickDelay, len);
+				if (i)
+				{
+					YM3812UpdateOne(chip0, (INT16*)stream, i / 2, 2, 1.0f);
+					YM3812UpdateOne(chip1, ((INT16*)stream) + 1, i / 2, 2, 1.0f);
+					stream += i;
+					tickDelay -= i;
+					len -= i;
+				}
+				if (!len)
+					break;
+				if (!func_is_music_playing() || func_get_restarts() > 0)
+				{
+					track.loops = func_is_music_playing();
+					wav.resize(wav.size() - len);
+					done = true;
+					break;
+				}
+				func_play_tick();
+
+				tickDelay = job.tickBytes;
+			}
+		}
+
+		func_use_state(0);
+		func_destroy_state(state);
+		if (!done)
+		{
+			return false;
+		}
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		for (size_t i = header; i + 1 < wav.size(); i += 2)
+		{
+			std::swap(wav[i], wav[i + 1]);
+		}
+#endif
+		Uint32 dataSize = wav.size() - header;
+		std::copy_n("RIFF", 4, wav.begin());
+		put(wav, 4, dataSize + header - 8, 4);
+		std::copy_n("WAVEfmt ", 8, wav.begin() + 8);
+		put(wav, 16, 16, 4);
+		put(wav, 20, 1, 2); // PCM
+		put(wav, 22, 2, 2); // stereo
+		put(wav, 24, job.rate, 4);
+		put(wav, 28, job.rate * 4, 4);
+		put(wav, 32, 4, 2);
+		put(wav, 34, 16, 2);
+		std::copy_n("data", 4, wav.begin() + 36);
+		put(wav, 40, dataSize, 4);
+		return true;
+	}
+
+	/**
+	 * Drops the least recently played tracks that aren't
+	 * in use until the cache fits its budget.
+	 */
+	void trim()
+	{
+		while (_bytes > MAX_RENDERED_BYTES)
+		{
+			auto oldest = _entries.end();
+			for (auto i = _entries.begin(); i != _entries.end(); ++i)
+			{
+				if (i->second.track && i->second.track.use_count() == 1 && (oldest == _entries.end() || i->second.lastUse < oldest->second.lastUse))
+				{
+					oldest = i;
+				}
+			}
+			if (oldest == _entries.end())
+			{
+				break;
+			}
+			_bytes -= oldest->second.track->wav.size();
+			_entries.erase(oldest);
+		}
+	}
+
+	/// Renders the queued tracks.
+	void work()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true)
+		{
+			_wake.wait(lock, [this] { return _quit || !_jobs.empty(); });
+			if (_quit)
+			{
+				return;
+			}
+			Job job = std::move(_jobs.front());
+			_jobs.pop_front();
+			lock.unlock();
+
+			auto track = std::make_shared<AdlibTrack>();
+			track->loops = false;
+			bool ok = render(job, *track);
+
+			lock.lock();
+			if (ok)
+			{
+				Log(LOG_VERBOSE) << "Pre-rendered Adlib track: " << (track->wav.size() / 4 / job.rate) << "s";
+				_entries[job.key].track = track;
+				_bytes += track->wav.size();
+				trim();
+			}
+			else if (!_quit)
+			{
+				Log(LOG_VERBOSE) << "Adlib track is too long to pre-render, it will play live";
+			}
+		}
+	}
+public:
+	/// Starts the renderer thread.
+	AdlibRenderer() : _uses(0), _bytes(0), _quit(false)
+	{
+		_thread = std::thread(&AdlibRenderer::work, this);
+	}
+	/// Stops the renderer thread.
+	~AdlibRenderer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+		}
+		_wake.notify_one();
+		_thread.join();
+	}
+	AdlibRenderer(const AdlibRenderer&) = delete;
+	AdlibRenderer &operator=(const AdlibRenderer&) = delete;
+
+	/**
+	 * Gets a rendered track, queueing it for rendering the first time.
+	 * @param key Hash of the track and its settings.
+	 * @param data Track data.
+	 * @param size Size of the track data.
+	 * @param volume Volume modifier of the track.
+	 * @param rate Sample rate to render at.
+	 * @param tickBytes Bytes of output between player ticks.
+	 * @return Rendered track, or null if it's not ready or can't be rendered.
+	 */
+	std::shared_ptr<const AdlibTrack> find(Uint64 key, const char *data, size_t size, float volume, int rate, int tickBytes)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto i = _entries.find(key);
+		if (i != _entries.end())
+		{
+			i->second.lastUse = ++_uses;
+			return i->second.track;
+		}
+
+		_entries[key].lastUse = ++_uses;
+		Job job;
+		job.key = key;
+		job.data.assign(data, data + size);
+		job.volume = volume;
+		job.rate = rate;
+		job.tickBytes = tickBytes;
+		_jobs.push_back(std::move(job));
+		_wake.notify_one();
+		return 0;
+	}
+};
+
+/// Gets the renderer, starting it the first time.
+AdlibRenderer &getRenderer()
+{
+	static AdlibRenderer renderer;
+	return renderer;
+}
+
+}
+
 int AdlibMusic::delay = 0;
 int AdlibMusic::rate = 0;
 std::map<int, int> AdlibMusic::delayRates;
@@ -39,9 +311,10 @@ std::map<int, int> AdlibMusic::delayRates;
  * Initializes a new music track.
  * @param volume Music volume modifier (1.0 = 100%).
  */
-AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume)
+AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume), _key(0), _rendered(0)
 {
 	rate = Options::audioSampleRate;
+	std::lock_guard<std::mutex> lock(synthMutex);
 	if (!opl[0])
 	{
 		opl[0] = OPLCreate(OPL_TYPE_YM3812, 3579545, rate);
@@ -68,9 +341,14 @@ AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volu
  */
 AdlibMusic::~AdlibMusic()
 {
+	releaseRendered();
 	if (opl[0])
 	{
 		stop();
+	}
+	std::lock_guard<std::mutex> lock(synthMutex);
+	if (opl[0])
+	{
 		OPLDestroy(opl[0]);
 		opl[0] = 0;
 	}
@@ -101,6 +379,40 @@ void AdlibMusic::load(const std::string &filename)
 void AdlibMusic::load(SDL_RWops *rwops)
 {
 	_data = (char *)SDL_LoadFile_RW(rwops, &_size, SDL_TRUE);
+
+	// FNV-1a over the track and everything that changes how it sounds
+	_key = 14695981039346656037ULL;
+	auto mix = [&](Uint8 byte)
+	{
+		_key = (_key ^ byte) * 1099511628211ULL;
+	};
+	for (size_t i = 0; _data && i < _size; ++i)
+	{
+		mix(_data[i]);
+	}
+	Uint32 volume;
+	float normalization = _volume;
+	memcpy(&volume, &normalization, sizeof(volume));
+	for (int i = 0; i < 4; ++i)
+	{
+		mix(volume >> (i * 8));
+		mix(rate >> (i * 8));
+	}
+}
+
+/**
+ * Unloads the pre-rendered track from SDL_mixer and lets the cache
+ * have it back.
+ */
+void AdlibMusic::releaseRendered() const
+{
+	if (renderedHolder == this)
+	{
+		renderedHolder = 0;
+	}
+	delete _rendered;
+	_rendered = 0;
+	_track.reset();
 }
 
 /**
@@ -112,11 +424,54 @@ void AdlibMusic::play(int) const
 #ifndef __NO_MUSIC
 	if (!Options::mute)
 	{
-		stop();
+		if (renderedHolder && renderedHolder != this)
+		{
+			renderedHolder->releaseRendered();
+		}
+		if (Options::adlibPreRender && _data && delayRates[rate] > 0)
+		{
+			auto track = getRenderer().find(_key, _data, _size, _volume, rate, delayRates[rate]);
+			if (track && track != _track)
+			{
+				releaseRendered();
+				_track = track;
+				_rendered = new Music();
+				try
+				{
+					_rendered->load(SDL_RWFromConstMem(_track->wav.data(), _track->wav.size()));
+				}
+				catch (Exception &e)
+				{
+					Log(LOG_WARNING) << e.what();
+					releaseRendered();
+				}
+			}
+			if (_rendered)
+			{
+				renderedHolder = this;
+				_rendered->play((_track->loops || Options::musicAlwaysLoop) ? -1 : 1);
+				return;
+			}
+		}
+		releaseRendered();
+		playLive();
+	}
+#endif
+}
+
+/**
+ * Plays the contained music track on the Adlib player.
+ */
+void AdlibMusic::playLive() const
+{
+#ifndef __NO_MUSIC
+	stop();
+	{
+		std::lock_guard<std::mutex> lock(synthMutex);
 		func_setup_music((unsigned char*)_data, _size);
 		func_set_music_volume(127 * _volume);
-		Mix_HookMusic(player, (void*)this);
 	}
+	Mix_HookMusic(player, (void*)this);
 #endif
 }
 
@@ -132,10 +487,13 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 	// Check SDL volume for Background Mute functionality
 	if (Options::musicVolume == 0 || Mix_VolumeMusic(-1) == 0)
 		return;
+	std::unique_lock<std::mutex> lock(synthMutex);
 	if (Options::musicAlwaysLoop && !func_is_music_playing())
 	{
+		lock.unlock();
 		AdlibMusic *music = (AdlibMusic*)udata;
-		music->play();
+		if (!Options::mute)
+			music->playLive();
 		return;
 	}
 	while (len != 0)
@@ -166,10 +524,33 @@ bool AdlibMusic::isPlaying()
 #ifndef __NO_MUSIC
 	if (!Options::mute)
 	{
+		if (_rendered)
+		{
+			return Mix_PlayingMusic() != 0;
+		}
+		std::lock_guard<std::mutex> lock(synthMutex);
 		return func_is_music_playing();
 	}
 #endif
 	return false;
 }
 
+/**
+ * Instantly stops the Adlib player.
+ */
+void AdlibMusic::mute()
+{
+	std::lock_guard<std::mutex> lock(synthMutex);
+	func_mute();
+}
+
+/**
+ * Starts fading out the Adlib player.
+ */
+void AdlibMusic::fade()
+{
+	std::lock_guard<std::mutex> lock(synthMutex);
+	func_fade();
+}
+
 }
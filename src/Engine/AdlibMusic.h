@@ -19,14 +19,20 @@
  */
 #include "Music.h"
 #include <map>
+#include <memory>
 #include <string>
 
 namespace OpenXcom
 {
 
+struct AdlibTrack;
+
 /**
  * Container for Adlib music tracks.
  * Uses a custom YM3812 music player passed to SDL_mixer.
+ * With the adlibPreRender option, tracks are rendered to PCM in
+ * the background the first time they play, and later plays stream
+ * the result through SDL_mixer like any other music.
  */
 class AdlibMusic : public Music
 {
@@ -34,8 +40,15 @@ private:
 	char *_data;
 	size_t _size;
 	float _volume;
+	Uint64 _key;
+	mutable std::shared_ptr<const AdlibTrack> _track;
+	mutable Music *_rendered;
 	static int delay, rate;
 	static std::map<int, int> delayRates;
+	/// Lets go of the pre-rendered track.
+	void releaseRendered() const;
+	/// Plays the music on the Adlib player.
+	void playLive() const;
 public:
 	/// Creates a blank music track.
 	AdlibMusic(float volume = 1.0f);
@@ -50,6 +63,10 @@ public:
 	/// Adlib music player.
 	static void player(void *udata, Uint8 *stream, int len);
 	bool isPlaying();
+	/// Instantly stops the Adlib player.
+	static void mute();
+	/// Starts fading out the Adlib player.
+	static void fade();
 };
 
 }
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AssetCache.h"
+#include <cstdio>
+#include <cstring>
+#include "CrossPlatform.h"
+#include "Logger.h"
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Bump whenever the layout of any payload changes.
+const Uint32 CacheVersion = 1;
+const char CacheMagic[4] = { 'O', 'X', 'A', 'C' };
+
+/**
+ * Every entry starts with this, the payload follows.
+ */
+struct CacheHeader
+{
+	char magic[4];
+	Uint32 version;
+	Uint64 key;
+	Uint64 payloadSize;
+};
+
+bool folderReady = false;
+
+/**
+ * Gets the file name of a cache entry.
+ * @param kind Kind of resource, keeps the keys of different conversions apart.
+ * @param key Key of the entry.
+ * @return Full path of the entry.
+ */
+std::string entryPath(const char *kind, Uint64 key)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "%s-%016llx.bin", kind, (unsigned long long)key);
+	return Options::getUserFolder() + "cache/" + name;
+}
+
+}
+
+/**
+ * Checks if the cache is turned on.
+ * @return True if converted resources should go through the cache.
+ */
+bool AssetCache::isEnabled()
+{
+	return Options::oxceAssetCache;
+}
+
+/**
+ * Computes the cache key of some source data (64-bit FNV-1a).
+ * @param data Source data.
+ * @param size Size of the source data.
+ * @param salt Tells apart different conversions of the same data.
+ * @return Key of the converted data.
+ */
+Uint64 AssetCache::makeKey(const void *data, size_t size, Uint32 salt)
+{
+	Uint64 hash = 14695981039346656037ULL;
+	auto mix = [&](const Uint8 *p, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			hash ^= p[i];
+			hash *= 1099511628211ULL;
+		}
+	};
+	Uint64 size64 = size;
+	mix((const Uint8 *)&salt, sizeof(salt));
+	mix((const Uint8 *)&size64, sizeof(size64));
+	mix((const Uint8 *)data, size);
+	return hash;
+}
+
+/**
+ * Maps the payload of a cache entry. Entries with a wrong header or
+ * size (left behind by an older version or a crash) are ignored.
+ * @param kind Kind of resource.
+ * @param key Key of the entry.
+ * @param size Where to put the size of the payload.
+ * @return Start of the payload or NULL.
+ */
+const Uint8 *AssetCache::open(const char *kind, Uint64 key, size_t *size)
+{
+	*size = 0;
+	size_t fileSize;
+	const char *data = CrossPlatform::mapFile(entryPath(kind, key), &fileSize);
+	if (data == NULL)
+	{
+		return NULL;
+	}
+	CacheHeader header;
+	if (fileSize < sizeof(header))
+	{
+		CrossPlatform::unmapFile(data, fileSize);
+		return NULL;
+	}
+	memcpy(&header, data, sizeof(header));
+	if (memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0 || header.version != CacheVersion
+		|| header.key != key || header.payloadSize != fileSize - sizeof(header))
+	{
+		CrossPlatform::unmapFile(data, fileSize);
+		return NULL;
+	}
+	*size = header.payloadSize;
+	return (const Uint8 *)data + sizeof(header);
+}
+
+/**
+ * Releases a payload returned by open().
+ * @param payload Start of the payload.
+ * @param size Size of the payload.
+ */
+void AssetCache::close(const Uint8 *payload, size_t size)
+{
+	if (payload == NULL)
+	{
+		return;
+	}
+	CrossPlatform::unmapFile((const char *)payload - sizeof(CacheHeader), size + sizeof(CacheHeader));
+}
+
+/**
+ * Writes a cache entry. The entry is written under a temporary name
+ * first, anything half written is rejected by the size check in open().
+ * @param kind Kind of resource.
+ * @param key Key of the entry.
+ * @param payload Converted data.
+ */
+void AssetCache::store(const char *kind, Uint64 key, const std::vector<Uint8> &payload)
+{
+	if (!folderReady)
+	{
+		std::string folder = Options::getUserFolder() + "cache";
+		if (!CrossPlatform::folderExists(folder) && !CrossPlatform::createFolder(folder))
+		{
+			Log(LOG_WARNING) << "Failed to create cache folder " << folder << ", turning the asset cache off.";
+			Options::oxceAssetCache = false;
+			return;
+		}
+		folderReady = true;
+	}
+
+	CacheHeader header;
+	memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+	header.version = CacheVersion;
+	header.key = key;
+	header.payloadSize = payload.size();
+
+	std::vector<unsigned char> entry(sizeof(header) + payload.size());
+	memcpy(entry.data(), &header, sizeof(header));
+	if (!payload.empty())
+	{
+		memcpy(entry.data() + sizeof(header), payload.data(), payload.size());
+	}
+
+	std::string path = entryPath(kind, key);
+	std::string temp = path + ".tmp";
+	if (!CrossPlatform::writeFile(temp, entry) || !CrossPlatform::moveFile(temp, path))
+	{
+		CrossPlatform::deleteFile(temp);
+	}
+}
+
+}
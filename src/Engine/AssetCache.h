@@ -0,0 +1,48 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Content-addressed disk cache of converted resources (decoded images,
+ * resampled sounds), so a warm start can skip the decoding.
+ * Entries are named after a hash of the source data, so a changed
+ * source simply misses the cache. Only used from the main thread.
+ */
+class AssetCache
+{
+public:
+	/// Checks if the cache is turned on.
+	static bool isEnabled();
+	/// Computes the cache key of some source data.
+	static Uint64 makeKey(const void *data, size_t size, Uint32 salt);
+	/// Maps the payload of a cache entry, or returns NULL if there is no valid entry.
+	static const Uint8 *open(const char *kind, Uint64 key, size_t *size);
+	/// Releases a payload returned by open().
+	static void close(const Uint8 *payload, size_t size);
+	/// Writes a cache entry.
+	static void store(const char *kind, Uint64 key, const std::vector<Uint8> &payload);
+};
+
+}
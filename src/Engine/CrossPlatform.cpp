@@ -26,12 +26,16 @@
 #include <fstream>
 #include <string>
 #include <list>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
 #include <stdint.h>
 #include <time.h>
 #include <signal.h>
 #include <sys/stat.h>
 #include <assert.h>
 #include "Logger.h"
+#include "LogWriter.h"
 #include "Exception.h"
 #include "Options.h"
 #include "Unicode.h"
@@ -79,6 +83,8 @@
 #include <cxxabi.h>
 #include <dlfcn.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include "Unicode.h"
 #endif		/* #ifdef _WIN32 */
 #include <SDL.h>
@@ -1100,6 +1106,90 @@ std::unique_ptr<std::istream> getYamlSaveHeader(const std::string& filename) {
 	return std::unique_ptr<std::istream>(new std::istringstream(datastr));
 }
 
+/**
+ * Maps a file into the address space, read-only, so that it can be
+ * read without copying it. Empty files and platforms without file
+ * mapping support yield NULL, callers are to fall back to plain reads.
+ * @param filename - what to map
+ * @param size - where to put the file size
+ * @return start of the mapped data or NULL.
+ */
+const char *mapFile(const std::string& filename, size_t *size)
+{
+	*size = 0;
+#ifdef _WIN32
+	auto pathW = pathToWindows(filename);
+	HANDLE file = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return NULL;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 || (ULONGLONG)fileSize.QuadPart > (ULONGLONG)SIZE_MAX)
+	{
+		CloseHandle(file);
+		return NULL;
+	}
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (mapping == NULL)
+	{
+		return NULL;
+	}
+	// the view keeps the mapping object alive by itself
+	const char *data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == NULL)
+	{
+		return NULL;
+	}
+	*size = (size_t)fileSize.QuadPart;
+	return data;
+#elif __MORPHOS__
+	return NULL;
+#else
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return NULL;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+	{
+		close(fd);
+		return NULL;
+	}
+	void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+	{
+		return NULL;
+	}
+	*size = (size_t)info.st_size;
+	return (const char *)data;
+#endif
+}
+
+/**
+ * Releases a file mapping.
+ * @param data - what mapFile() returned
+ * @param size - size of the mapping
+ */
+void unmapFile(const char *data, size_t size)
+{
+	if (data == NULL)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#elif __MORPHOS__
+	// nothing is ever mapped
+#else
+	munmap((void *)data, size);
+#endif
+}
+
 /**
  * Notifies the user that maybe he should have a look.
  */
@@ -1458,6 +1548,7 @@ void crashDump(void *ex, const std::string &err)
 	Log(LOG_FATAL) << "A fatal error has occurred: " << error.str();
 	stackTrace(0);
 #endif
+	flushLogOnCrash();
 	std::ostringstream msg;
 	msg << "OpenXcom has crashed: " << error.str() << std::endl;
 	msg << "Log file: " << getLogFileName() << std::endl;
@@ -1491,26 +1582,10 @@ bool openExplorer(const std::string &url)
 }
 
 
-/**
- * Appends a file, logs nothing to avoid recursion.
- * @param filename - where to writeFile
- * @param data - what to writeFile
- * @return if we did write it.
- */
-static bool logToFile(const std::string& filename, const std::string& data) {
-	// Even SDL1 file IO accepts UTF-8 file names on windows.
-	SDL_RWops *rwops = SDL_RWFromFile(filename.c_str(), "a+");
-	if (rwops) {
-		auto rv = SDL_RWwrite(rwops, data.c_str(), data.size(), 1);
-		SDL_RWclose(rwops);
-		return rv == 1;
-	}
-	return false;
-}
-
 static const size_t LOG_BUFFER_LIMIT = 1<<10;
 static std::list<std::pair<int, std::string>> logBuffer;
 static std::string logFileName;
+static std::atomic<LogWriter*> logWriter(nullptr);
 const std::string& getLogFileName() { return logFileName; }
 
 /**
@@ -1524,6 +1599,28 @@ void setLogFileName(const std::string& name) {
 	Log(LOG_DEBUG) << "setLogFileName("<<name<<") was '"<<logFileName<<"'; "<<sz<<" in buffer";
 	logFileName = name;
 }
+
+/**
+ * Writes out the queued log messages, for when the game exits.
+ */
+void flushLog() {
+	LogWriter *writer = logWriter.load(std::memory_order_acquire);
+	if (writer) {
+		writer->flush();
+	}
+}
+
+/**
+ * Writes out the queued log messages when the game crashes,
+ * without waiting on a log write that may never finish.
+ */
+void flushLogOnCrash() {
+	LogWriter *writer = logWriter.load(std::memory_order_acquire);
+	if (writer) {
+		writer->flushOnCrash();
+	}
+}
+
 void log(int level, const std::ostringstream& baremsgstream) {
 	std::ostringstream msgstream;
 	msgstream << "[" << CrossPlatform::now() << "]" << "\t"
@@ -1532,7 +1629,25 @@ void log(int level, const std::ostringstream& baremsgstream) {
 	auto msg = msgstream.str();
 
 	int effectiveLevel = Logger::reportingLevel();
-	if (effectiveLevel >= LOG_DEBUG) {
+	bool echo = effectiveLevel >= LOG_DEBUG;
+
+	// once the log file is open, messages just get queued for the writer thread
+	LogWriter *writer = logWriter.load(std::memory_order_acquire);
+	if (writer) {
+		writer->write(std::move(msg), echo);
+		return;
+	}
+
+	// loader threads log too
+	static std::mutex logMutex;
+	std::lock_guard<std::mutex> lock(logMutex);
+
+	writer = logWriter.load(std::memory_order_acquire);
+	if (writer) {
+		writer->write(std::move(msg), echo);
+		return;
+	}
+	if (echo) {
 		fwrite(msg.c_str(), msg.size(), 1, stderr);
 		fflush(stderr);
 	}
@@ -1543,23 +1658,25 @@ void log(int level, const std::ostringstream& baremsgstream) {
 		logBuffer.push_back(std::make_pair(level, msg));
 		return;
 	}
-	// attempt to flush the buffer
-	bool failed = false;
-	while (!logBuffer.empty()) {
-		if (effectiveLevel >= logBuffer.front().first) {
-			if (!logToFile(logFileName, logBuffer.front().second)) {
-				std::string err = "Failed to append to '" + logFileName + "': " + SDL_GetError();
-				logBuffer.push_back(std::make_pair(LOG_ERROR, err));
-				failed = true;
-				break;
-			}
-		}
-		logBuffer.pop_front();
-	}
-	// retain the current message if write fails.
-	if (failed || !logToFile(logFileName, msg)) {
+	writer = new LogWriter(logFileName);
+	if (!writer->isOpen()) {
+		// retain the messages and try again with the next one
+		delete writer;
+		std::string err = "Failed to append to '" + logFileName + "': " + SDL_GetError();
 		logBuffer.push_back(std::make_pair(level, msg));
+		logBuffer.push_back(std::make_pair(LOG_ERROR, err));
+		return;
+	}
+	// hand over the buffer, the writer is never deleted so late messages still have somewhere to go
+	for (auto& buffered : logBuffer) {
+		if (effectiveLevel >= buffered.first) {
+			writer->write(std::move(buffered.second), false);
+		}
 	}
+	logBuffer.clear();
+	writer->write(std::move(msg), false);
+	logWriter.store(writer, std::memory_order_release);
+	std::atexit(flushLog);
 }
 
 #if defined(EMBED_ASSETS)
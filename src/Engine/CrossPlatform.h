@@ -96,6 +96,10 @@ namespace CrossPlatform
 	std::unique_ptr<std::istream> readFile(const std::string& filename);
 	/// Reads file until "\n---" sequence is met or to the end. To be used only for savegames.
 	std::unique_ptr<std::istream> getYamlSaveHeader (const std::string& filename);
+	/// Maps a whole file into memory, read-only. NULL if that's not possible.
+	const char *mapFile(const std::string& filename, size_t *size);
+	/// Releases a mapping made by mapFile().
+	void unmapFile(const char *data, size_t size);
 	/// Flashes the game window.
 	void flashWindow();
 	/// Gets the DOS-style executable path.
@@ -112,6 +116,10 @@ namespace CrossPlatform
 	bool openExplorer(const std::string &url);
 	/// Log something.
 	void log(int, const std::ostringstream& msg);
+	/// Writes out the queued log messages.
+	void flushLog();
+	/// Writes out the queued log messages without waiting for a lock.
+	void flushLogOnCrash();
 	/// The log file name
 	void setLogFileName(const std::string &path);
 	const std::string& getLogFileName();
@@ -36,9 +36,15 @@
  * A. somename.zip is always scanned before somename/ directory.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <istream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -162,12 +168,6 @@ static mz_bool mz_zip_reader_init_rwops(mz_zip_archive *pZip, SDL_RWops *rwops)
 	pZip->m_pIO_opaque = rwops;
 	return mz_zip_reader_init(pZip, size, 0);
 }
-static mz_bool mz_zip_reader_end_rwops(mz_zip_archive *pZip) {
-	if (!pZip) { return false; }
-	if (!pZip->m_pIO_opaque) { return false; }
-	SDL_RWclose((SDL_RWops *)(pZip->m_pIO_opaque));
-	return mz_zip_reader_end(pZip);
-}
 
 }
 
@@ -205,14 +205,389 @@ static inline std::string concatOptionalPaths(const std::string& basePath, const
 	}
 }
 
+/**
+ * A piece of file data in memory: a mapped file, a slice of one
+ * or an inflated zip entry. The shared pointer owns the storage,
+ * so a view stays valid after whatever handed it out is gone.
+ */
+struct FileView
+{
+	std::shared_ptr<const char> data;
+	size_t size;
+
+	FileView() : data(), size(0) { }
+	FileView(std::shared_ptr<const char> d, size_t s) : data(std::move(d)), size(s) { }
+	explicit operator bool() const { return data != nullptr; }
+	/// Gets a part of this view, sharing the ownership of the storage.
+	FileView slice(size_t offset, size_t length) const
+	{
+		return FileView(std::shared_ptr<const char>(data, data.get() + offset), length);
+	}
+};
+
+/**
+ * Maps a whole file into memory.
+ * @param fullpath - the file.
+ * @return the view or an empty one if the file can't be mapped.
+ */
+static FileView mapFileView(const std::string& fullpath)
+{
+	size_t size = 0;
+	const char *data = CrossPlatform::mapFile(fullpath, &size);
+	if (data == NULL)
+	{
+		return FileView();
+	}
+	return FileView(std::shared_ptr<const char>(data, [size](const char *p) { CrossPlatform::unmapFile(p, size); }), size);
+}
+
+// views backing the SDL_RWops made by rwopsFromView(), released when the RWops gets closed.
+static std::mutex ViewRWopsMutex;
+static std::unordered_map<SDL_RWops *, std::shared_ptr<const char>> ViewRWops;
+
+static int viewRWopsClose(struct SDL_RWops *context)
+{
+	if (context)
+	{
+		{
+			std::lock_guard<std::mutex> guard(ViewRWopsMutex);
+			ViewRWops.erase(context);
+		}
+		SDL_FreeRW(context);
+	}
+	return 0;
+}
+
+/**
+ * Wraps a view into a read-only SDL_RWops, without copying the data.
+ * @param view - the data.
+ * @return the RWops, NULL on error.
+ */
+static SDL_RWops *rwopsFromView(const FileView& view)
+{
+	SDL_RWops *rv = SDL_RWFromConstMem(view.data.get(), (int)view.size);
+	if (rv)
+	{
+		std::lock_guard<std::mutex> guard(ViewRWopsMutex);
+		ViewRWops[rv] = view.data;
+		rv->close = viewRWopsClose;
+	}
+	return rv;
+}
+
+/**
+ * Stream buffer reading straight out of a view.
+ */
+class FileViewBuf : public std::streambuf
+{
+	FileView _view;
+public:
+	FileViewBuf(const FileView& view) : _view(view)
+	{
+		char *begin = const_cast<char *>(_view.data.get());
+		setg(begin, begin, begin + _view.size);
+	}
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		off_type base = 0;
+		if (dir == std::ios_base::cur)
+		{
+			base = gptr() - eback();
+		}
+		else if (dir == std::ios_base::end)
+		{
+			base = egptr() - eback();
+		}
+		return seekpos(pos_type(base + off), which);
+	}
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		off_type off = off_type(pos);
+		if (!(which & std::ios_base::in) || off < 0 || off > egptr() - eback())
+		{
+			return pos_type(off_type(-1));
+		}
+		setg(eback(), eback() + off, egptr());
+		return pos;
+	}
+};
+
+/**
+ * Input stream over a view.
+ */
+class FileViewStream : public std::istream
+{
+	FileViewBuf _buf;
+public:
+	FileViewStream(const FileView& view) : std::istream(nullptr), _buf(view) { rdbuf(&_buf); }
+};
+
+struct ZipArchive;
+
+/**
+ * LRU of recently inflated zip entries, shared between all threads.
+ * Entries too big for it are not kept.
+ */
+class InflatedCache
+{
+	typedef std::pair<const ZipArchive *, mz_uint> Key;
+	typedef std::list<std::pair<Key, FileView>> Entries;
+
+	std::mutex _mutex;
+	Entries _entries; // most recently used first
+	std::map<Key, Entries::iterator> _index;
+	size_t _bytes, _capacity;
+
+	void evict()
+	{
+		while (_bytes > _capacity && !_entries.empty())
+		{
+			_bytes -= _entries.back().second.size;
+			_index.erase(_entries.back().first);
+			_entries.pop_back();
+		}
+	}
+public:
+	InflatedCache(size_t capacity) : _bytes(0), _capacity(capacity) { }
+
+	bool get(const ZipArchive *zip, mz_uint findex, FileView& view)
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+		auto it = _index.find(Key(zip, findex));
+		if (it == _index.end())
+		{
+			return false;
+		}
+		_entries.splice(_entries.begin(), _entries, it->second);
+		view = it->second->second;
+		return true;
+	}
+	void put(const ZipArchive *zip, mz_uint findex, const FileView& view)
+	{
+		if (view.size > _capacity / 4)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> guard(_mutex);
+		Key key(zip, findex);
+		if (_index.find(key) != _index.end())
+		{
+			return; // another thread was faster
+		}
+		_entries.push_front(std::make_pair(key, view));
+		_index[key] = _entries.begin();
+		_bytes += view.size;
+		evict();
+	}
+	void clear()
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+		_index.clear();
+		_entries.clear();
+		_bytes = 0;
+	}
+};
+
+static InflatedCache RecentlyInflated(32 * 1024 * 1024);
+
+/**
+ * A .zip mapped into the VFS.
+ * The archive bytes are shared, but the miniz reader contexts are not:
+ * a thread takes one from the pool for each extraction and returns it
+ * afterwards, so concurrent readers never touch the same context.
+ */
+struct ZipArchive
+{
+	std::string fullpath;
+	FileView image;			// the whole archive, if it could be mapped
+	SDL_RWops *rwops;		// otherwise it's read through this, under ioMutex
+	mz_uint64 size;
+	std::mutex ioMutex;
+	std::mutex poolMutex;
+	std::vector<mz_zip_archive *> idle; // reader contexts not in use by any thread
+
+	ZipArchive(const std::string& path) : fullpath(path), image(), rwops(NULL), size(0) { }
+	~ZipArchive()
+	{
+		for (auto zip : idle)
+		{
+			mz_zip_reader_end(zip);
+			SDL_free(zip);
+		}
+		if (rwops)
+		{
+			SDL_RWclose(rwops);
+		}
+	}
+	ZipArchive(const ZipArchive&) = delete;
+	ZipArchive& operator=(const ZipArchive&) = delete;
+
+	static size_t readFunc(void *opaque, mz_uint64 file_ofs, void *pBuf, size_t n)
+	{
+		ZipArchive *self = (ZipArchive *)opaque;
+		if (self->image)
+		{
+			if (file_ofs >= self->image.size) { return 0; }
+			n = std::min<mz_uint64>(n, self->image.size - file_ofs);
+			memcpy(pBuf, self->image.data.get() + file_ofs, n);
+			return n;
+		}
+		std::lock_guard<std::mutex> guard(self->ioMutex);
+		return mz_rwops_read_func(self->rwops, file_ofs, pBuf, n);
+	}
+
+	/**
+	 * Takes an idle reader context or makes a new one.
+	 * @param log_ctx - for the error message.
+	 * @return the context or NULL if the archive is unreadable.
+	 */
+	mz_zip_archive *acquire(const std::string& log_ctx)
+	{
+		{
+			std::lock_guard<std::mutex> guard(poolMutex);
+			if (!idle.empty())
+			{
+				mz_zip_archive *zip = idle.back();
+				idle.pop_back();
+				return zip;
+			}
+		}
+		mz_zip_archive *zip = (mz_zip_archive *) SDL_malloc(sizeof(mz_zip_archive));
+		if (!zip)
+		{
+			Log(LOG_FATAL) << log_ctx << ": " << SDL_GetError();
+			throw Exception("Out of memory");
+		}
+		mz_zip_zero_struct(zip);
+		zip->m_pRead = readFunc;
+		zip->m_pIO_opaque = this;
+		if (!mz_zip_reader_init(zip, size, 0))
+		{
+			Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << mz_zip_get_error_string(mz_zip_get_last_error(zip));
+			SDL_free(zip);
+			return NULL;
+		}
+		return zip;
+	}
+	/// Puts a reader context back into the pool.
+	void release(mz_zip_archive *zip)
+	{
+		std::lock_guard<std::mutex> guard(poolMutex);
+		idle.push_back(zip);
+	}
+
+	/**
+	 * Gets an entry stored without compression right out of the mapped archive.
+	 * @param fistat - the entry.
+	 * @return the view or an empty one if the entry can't be read in place.
+	 */
+	FileView getStored(const mz_zip_archive_file_stat& fistat) const
+	{
+		if (!image || fistat.m_method != 0 || fistat.m_is_encrypted || fistat.m_comp_size != fistat.m_uncomp_size)
+		{
+			return FileView();
+		}
+		// local header is 30 bytes followed by the name and the extra field,
+		// lengths of which don't have to match the central directory ones.
+		mz_uint64 ofs = fistat.m_local_header_ofs;
+		if (ofs + 30 > image.size)
+		{
+			return FileView();
+		}
+		const unsigned char *header = (const unsigned char *)image.data.get() + ofs;
+		if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4)
+		{
+			return FileView();
+		}
+		mz_uint64 dataOfs = ofs + 30 + (header[26] | (header[27] << 8)) + (header[28] | (header[29] << 8));
+		if (dataOfs + fistat.m_comp_size > image.size)
+		{
+			return FileView();
+		}
+		return image.slice((size_t)dataOfs, (size_t)fistat.m_comp_size);
+	}
+
+	FileView extract(mz_uint findex);
+};
+
+/**
+ * Borrows a reader context for the lifetime of the object.
+ */
+struct ZipReader
+{
+	ZipArchive *archive;
+	mz_zip_archive *zip;
+
+	ZipReader(ZipArchive *a, const std::string& log_ctx) : archive(a), zip(a->acquire(log_ctx)) { }
+	~ZipReader() { if (zip) { archive->release(zip); } }
+	ZipReader(const ZipReader&) = delete;
+	ZipReader& operator=(const ZipReader&) = delete;
+};
+
+/**
+ * Gets the contents of an entry. Stored entries of a mapped archive are
+ * returned in place, the rest gets inflated or comes from the LRU cache.
+ * @param findex - entry index.
+ * @return the data, or an empty view with SDL_GetError() set.
+ */
+FileView ZipArchive::extract(mz_uint findex)
+{
+	FileView rv;
+	if (RecentlyInflated.get(this, findex, rv))
+	{
+		return rv;
+	}
+	ZipReader reader(this, "ZipArchive::extract(" + fullpath + "): ");
+	if (!reader.zip)
+	{
+		SDL_SetError("miniz: can't read %s", fullpath.c_str());
+		return rv;
+	}
+	mz_zip_archive_file_stat fistat;
+	if (image && mz_zip_reader_file_stat(reader.zip, findex, &fistat))
+	{
+		rv = getStored(fistat);
+		if (rv)
+		{
+			return rv;
+		}
+	}
+	size_t dataSize;
+	void *data = mz_zip_reader_extract_to_heap(reader.zip, findex, &dataSize, 0);
+	if (data == NULL)
+	{
+		SDL_SetError("miniz extract: %s", mz_zip_get_error_string(mz_zip_get_last_error(reader.zip)));
+		return rv;
+	}
+	rv = FileView(std::shared_ptr<const char>((const char *)data, [](const char *p) { mz_free((void *)p); }), dataSize);
+	RecentlyInflated.put(this, findex, rv);
+	return rv;
+}
+
+/**
+ * Gets the whole contents of a file record without copying, if possible.
+ * @param frec - the record.
+ * @return the data; empty view if it needs to be read the usual way.
+ */
+static FileView getFileView(const FileRecord& frec)
+{
+	if (frec.zip != NULL)
+	{
+		return ((ZipArchive *)frec.zip)->extract((mz_uint)frec.findex);
+	}
+	return mapFileView(frec.fullpath);
+}
+
 FileRecord::FileRecord() : fullpath(""), zip(NULL), findex(0) { }
 
 SDL_RWops *FileRecord::getRWops() const
 {
-	SDL_RWops *rv;
-	if (zip != NULL) {
-		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
-	} else {
+	SDL_RWops *rv = NULL;
+	FileView view = getFileView(*this);
+	if (view) {
+		rv = rwopsFromView(view);
+	} else if (zip == NULL) {
 		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
 	}
 	if (!rv) { Log(LOG_ERROR) << "FileRecord::getRWops(): err=" << SDL_GetError(); }
@@ -221,12 +596,13 @@ SDL_RWops *FileRecord::getRWops() const
 
 SDL_RWops *FileRecord::getRWopsReadAll() const
 {
-	SDL_RWops *rv;
-	if (zip != NULL)
+	SDL_RWops *rv = NULL;
+	FileView view = getFileView(*this);
+	if (view)
 	{
-		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
+		rv = rwopsFromView(view);
 	}
-	else
+	else if (zip == NULL)
 	{
 		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
 		if (rv)
@@ -264,19 +640,14 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 
 std::unique_ptr<std::istream> FileRecord::getIStream() const
 {
-	if (zip != NULL) {
-		size_t size;
-		void *data = mz_zip_reader_extract_to_heap((mz_zip_archive *)zip, findex, &size, 0);
-		if (data == NULL) {
-			auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
-			err += mz_zip_get_error_string(mz_zip_get_last_error((mz_zip_archive *)zip));
-			Log(LOG_FATAL) << err;
-			throw Exception(err);
-		}
-		std::string a_string((char *)data, size);
-		auto rv = new std::stringstream(a_string);
-		mz_free(data);
-		return std::unique_ptr<std::istream>(rv);
+	FileView view = getFileView(*this);
+	if (view) {
+		return std::unique_ptr<std::istream>(new FileViewStream(view));
+	} else if (zip != NULL) {
+		auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
+		err += SDL_GetError();
+		Log(LOG_FATAL) << err;
+		throw Exception(err);
 	} else {
 		return CrossPlatform::readFile(fullpath);
 	}
@@ -356,7 +727,8 @@ static bool isRuleset(const std::string& fname) {
 
 typedef std::unordered_map<std::string, FileRecord> FileSet;
 static const NameSet emptySet;
-static mz_zip_archive *newZipContext(const std::string& log_ctx, SDL_RWops *rwops);
+static ZipArchive *newZipArchive(const std::string& log_ctx, const std::string& zippath);
+static ZipArchive *newZipArchiveRW(const std::string& log_ctx, SDL_RWops *rwops, const std::string& fullpath);
 
 struct VFSLayer {
 	std::string fullpath;				// the origin
@@ -418,12 +790,9 @@ struct VFSLayer {
 	*/
 	bool mapZipFile(const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZipFile(" + zippath + ",  '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
-		SDL_RWops *rwops = SDL_RWFromFile(zippath.c_str(), "r");
-		if (!rwops) {
-			Log(LOG_WARNING) << log_ctx << "Ignoring zip '" << zippath << "': " << SDL_GetError();
-			return false;
-		}
-		return mapZipFileRW(rwops, zippath, prefix, ignore_ruls);
+		ZipArchive *zip = newZipArchive(log_ctx, zippath);
+		if (!zip) { return false; }
+		return mapZip(zip, zippath, prefix, ignore_ruls);
 	}
 	/** maps a zipped moddir from an SDL_RWops
 	* @param rwops - SDL_RWops with the zip data
@@ -434,7 +803,7 @@ struct VFSLayer {
 	*/
 	bool mapZipFileRW(SDL_RWops *rwops, const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZipFileRW(rwops, '" + zippath + "', '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
-		mz_zip_archive *zip = newZipContext(log_ctx, rwops);
+		ZipArchive *zip = newZipArchiveRW(log_ctx, rwops, zippath);
 		if (!zip) { return false; }
 		return mapZip(zip, zippath, prefix, ignore_ruls);
 	}
@@ -445,7 +814,7 @@ struct VFSLayer {
 	* @param ignore_ruls - skip rulesets
 	* @return - did we map anything (false, i.e if failed to unzip)
 	*/
-	bool mapZip(mz_zip_archive *zip, const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
+	bool mapZip(ZipArchive *zip, const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZip(zip, '" + zippath + "', '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
 		if (mapped) {
 			auto err=  log_ctx + "Fatal: already mapped.";
@@ -458,9 +827,11 @@ struct VFSLayer {
 			Log(LOG_FATAL) << err;
 			throw Exception(err);
 		}
+		ZipReader reader(zip, log_ctx);
+		if (!reader.zip) { return false; }
 		mapped = true;
 		fullpath = zippath;
-		mz_uint filecount = mz_zip_reader_get_num_files(zip);
+		mz_uint filecount = mz_zip_reader_get_num_files(reader.zip);
 
 		FileRecord frec;
 		frec.zip = zip;
@@ -468,7 +839,7 @@ struct VFSLayer {
 		mz_uint mapped_count = 0;
 		for (mz_uint fi = 0; fi < filecount; ++fi) {
 			mz_zip_archive_file_stat fistat;
-			mz_zip_reader_file_stat(zip, fi, &fistat);
+			mz_zip_reader_file_stat(reader.zip, fi, &fistat);
 
 			std::string fname = fistat.m_filename;
 			if (!sanitizeZipEntryName(fname)) {
@@ -683,27 +1054,70 @@ struct VFS {
 static std::unordered_map<std::string, ModRecord *> ModsAvailable;
 static std::unordered_set<VFSLayer *> MappedVFSLayers; // owned here so we can have some sense of their lifetime
 												       // only the layers that get dropped on FileMap::clear()
-static std::vector<mz_zip_archive *> ZipContexts;	   // zip decompression contexts shared between layers that came from
-													   // the same .zip. this makes the whole thing very thread-unsafe
+static std::vector<ZipArchive *> ZipArchives;		   // zips shared between layers that came from the same .zip.
+													   // each pools its own decompression contexts, so reads are thread-safe
 static VFS TheVFS;
 
 const RSOrder &getRulesets() { return TheVFS.get_rulesets(); }
 
-static mz_zip_archive *newZipContext(const std::string& log_ctx, SDL_RWops *rwops) {
-	mz_zip_archive *zip = (mz_zip_archive *) SDL_malloc(sizeof(mz_zip_archive));
-	if (!zip) {
-		Log(LOG_FATAL) << log_ctx << ": " << SDL_GetError();
-		throw Exception("Out of memory");
+/**
+ * Checks that an archive is readable and keeps it until FileMap::clear().
+ * @param log_ctx - for error messages.
+ * @param archive - the archive, deleted if it's no good.
+ * @return the archive or NULL.
+ */
+static ZipArchive *registerZipArchive(const std::string& log_ctx, ZipArchive *archive) {
+	{
+		ZipReader reader(archive, log_ctx);
+		if (!reader.zip) {
+			// whoa, no opening the file
+			delete archive;
+			return NULL;
+		}
 	}
-	if (!mz_zip_reader_init_rwops(zip, rwops)) {
-		// whoa, no opening the file
-		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << mz_zip_get_error_string(mz_zip_get_last_error(zip));
-		SDL_RWclose(rwops);
-		SDL_free(zip);
+	ZipArchives.push_back(archive);
+	return archive;
+}
+/**
+ * Opens a .zip from the filesystem, mapping it into memory when possible.
+ * @param log_ctx - for error messages.
+ * @param zippath - the .zip.
+ * @return the archive or NULL.
+ */
+static ZipArchive *newZipArchive(const std::string& log_ctx, const std::string& zippath) {
+	FileView image = mapFileView(zippath);
+	if (image) {
+		auto archive = new ZipArchive(zippath);
+		archive->image = image;
+		archive->size = image.size;
+		return registerZipArchive(log_ctx, archive);
+	}
+	SDL_RWops *rwops = SDL_RWFromFile(zippath.c_str(), "rb");
+	if (!rwops) {
+		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << SDL_GetError();
 		return NULL;
 	}
-	ZipContexts.push_back(zip);
-	return zip;
+	return newZipArchiveRW(log_ctx, rwops, zippath);
+}
+/**
+ * Opens a .zip from an SDL_RWops. Takes the ownership of the rwops.
+ * @param log_ctx - for error messages.
+ * @param rwops - the .zip data.
+ * @param fullpath - the path to associate this with.
+ * @return the archive or NULL.
+ */
+static ZipArchive *newZipArchiveRW(const std::string& log_ctx, SDL_RWops *rwops, const std::string& fullpath) {
+	if (!rwops) { return NULL; }
+	auto archive = new ZipArchive(fullpath);
+	archive->rwops = rwops;
+	Sint64 size = SDL_RWsize(rwops);
+	if (size < 0) {
+		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << SDL_GetError();
+		delete archive;
+		return NULL;
+	}
+	archive->size = size;
+	return registerZipArchive(log_ctx, archive);
 }
 
 void clear(bool clearOnly, bool embeddedOnly) {
@@ -712,8 +1126,9 @@ void clear(bool clearOnly, bool embeddedOnly) {
 	ModsAvailable.clear();
 	for (auto i : MappedVFSLayers ) { delete i; }
 	MappedVFSLayers.clear();
-	for (auto i : ZipContexts) { mz_zip_reader_end_rwops(i); SDL_free(i); }
-	ZipContexts.clear();
+	RecentlyInflated.clear(); // keyed by the archive pointers
+	for (auto i : ZipArchives) { delete i; }
+	ZipArchives.clear();
 	if (!clearOnly)
 	{
 		Log(LOG_VERBOSE) << "FileMap::clear(): mapping 'common'";
@@ -859,7 +1274,7 @@ static bool mapExtResources(ModRecord *mrec, const std::string& basename, bool e
  * @param zipfname  - full path to the .zip_open
  * @param prefix    - prefix (subdir) in the .zip if any
  */
-static void mapZippedMod(mz_zip_archive *zip, const std::string& zipfname, const std::string& prefix) {
+static void mapZippedMod(ZipArchive *zip, const std::string& zipfname, const std::string& prefix) {
 	std::string log_ctx = "mapZippedMod(" + zipfname + ", '" + prefix + "'): ";
 	auto layer = new VFSLayer(concatPaths(zipfname, prefix));
 	if (!layer->mapZip(zip, zipfname, prefix)) {
@@ -896,19 +1311,20 @@ static void mapZippedMod(mz_zip_archive *zip, const std::string& zipfname, const
 	ModsAvailable.insert(std::make_pair(mrec->modInfo.getId(), mrec));
 }
 /** now this scans a zip of mods or of a single mod
- * @param rwops - SDL_RWops to the zip data
+ * @param zip - the opened .zip
  * @param fullpath - full path to associate with the .zip.
  */
-void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
-	std::string log_ctx = "scanModZipRW(rwops, " + fullpath + "): ";
-	mz_zip_archive *mzip = newZipContext(log_ctx, rwops);
+static void scanModZipArchive(ZipArchive *zip, const std::string& fullpath) {
+	std::string log_ctx = "scanModZipArchive(zip, " + fullpath + "): ";
+	ZipReader reader(zip, log_ctx);
+	mz_zip_archive *mzip = reader.zip;
 
 	if (!mzip) { return; }
 	// check if this is maybe a zip of a single mod (metadata.yml at the top level)
 	if (mz_zip_reader_locate_file_v2(mzip, "metadata.yml", NULL, 0, NULL)) {
 		Log(LOG_VERBOSE) << log_ctx << "retrying as a single-mod .zip";
 		// FIXME: this doesn't seem to work at all... do we support this?
-		mapZippedMod(mzip, fullpath, "");
+		mapZippedMod(zip, fullpath, "");
 		return;
 	}
 	mz_uint filecount = mz_zip_reader_get_num_files(mzip);
@@ -927,20 +1343,27 @@ void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
 		// FIXME: if Microsoft Windows "Send to > Compressed (zipped) folder" is used to create the ZIP archive,
 		// this will never be called, because the top-level directory is NOT on the file list... yes, seriously, I'm not kidding!
 		// Do we want to handle this somehow or do we just call it unsupported?
-		mapZippedMod(mzip, fullpath, prefix);
+		mapZippedMod(zip, fullpath, prefix);
 	}
 }
+/** now this scans a zip of mods or of a single mod
+ * @param rwops - SDL_RWops to the zip data
+ * @param fullpath - full path to associate with the .zip.
+ */
+void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
+	std::string log_ctx = "scanModZipRW(rwops, " + fullpath + "): ";
+	ZipArchive *zip = newZipArchiveRW(log_ctx, rwops, fullpath);
+	if (!zip) { return; }
+	scanModZipArchive(zip, fullpath);
+}
 /** Filesystem wrapper for scanModZipRW()
  * @param fullpath - full path to the .zip.
  */
 void scanModZip(const std::string& fullpath) {
 	std::string log_ctx = "scanModZip(" + fullpath + "): ";
-	SDL_RWops *rwops = SDL_RWFromFile(fullpath.c_str(), "r");
-	if (!rwops) {
-		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << SDL_GetError();
-		return;
-	}
-	scanModZipRW(rwops, fullpath);
+	ZipArchive *zip = newZipArchive(log_ctx, fullpath);
+	if (!zip) { return; }
+	scanModZipArchive(zip, fullpath);
 }
 /**
  * Extracts a single file to an ConstMem RWops object
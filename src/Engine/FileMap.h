@@ -33,18 +33,20 @@ namespace OpenXcom
 /**
  * Maps canonical names to file paths and maintains the virtual file system
  * for resource files.
+ * Once set up, files can be read from any number of threads at once,
+ * as long as nobody calls clear() or setup() meanwhile.
  */
 namespace FileMap
 {
 	struct FileRecord {
 		std::string fullpath; 	// includes zip file name if any
 
-		void *zip; 				// borrowed reference/weakref. NOTNULL:
+		void *zip; 				// borrowed reference to the ZipArchive, NULL for plain files.
 		size_t findex;       	// file index in the zipfile.
 
 		FileRecord();
 
-		/// Open file warped in RWops.
+		/// Open file warped in RWops. Mapped into memory when possible.
 		SDL_RWops *getRWops() const;
 		/// Read the whole file to memory and warp in RWops.
 		SDL_RWops *getRWopsReadAll() const;
@@ -79,7 +79,7 @@ enum PlayingState
 	SKIPPED
 };
 
-FlcPlayer::FlcPlayer() : _fileBuf(0), _mainScreen(0), _realScreen(0), _game(0)
+FlcPlayer::FlcPlayer() : _fileSize(0), _framesDecoded(0), _framesShown(0), _queueAudio(false), _decoderDone(false), _stopDecoder(false), _mainScreen(0), _realScreen(0), _game(0)
 {
 	_volume = Game::volumeExponent(Options::musicVolume);
 }
@@ -90,7 +90,8 @@ FlcPlayer::~FlcPlayer()
 }
 
 /**
- * Initialize data structures needed buy the player and read the whole file into memory
+ * Initialize data structures needed buy the player and open the file for streaming.
+ * Only a few frames are kept decoded at a time, so long videos don't need more memory.
  * @param filename Video file name
  * @param frameCallback Function to call each video frame
  * @param game Pointer to the Game instance
@@ -99,7 +100,7 @@ FlcPlayer::~FlcPlayer()
  */
 bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, bool useInternalAudio, int dx, int dy)
 {
-	if (_fileBuf != 0)
+	if (_file)
 	{
 		Log(LOG_ERROR) << "Trying to init a video player that is already initialized";
 		return false;
@@ -115,23 +116,23 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 
 	_fileSize = 0;
 	_frameCount = 0;
-	_audioFrameData = 0;
 	_hasAudio = false;
 	_audioData.loadingBuffer = 0;
 	_audioData.playingBuffer = 0;
 
-	auto file = FileMap::getIStream(filename);
-	file->seekg(0, std::istream::end);
-	auto size = file->tellg();
-	file->seekg(0, std::istream::beg);
-	_fileBuf = new Uint8[size];
-	_fileSize = size;
-	file->read((char *)_fileBuf, size);
-
-	_audioFrameData = _fileBuf + 128;
+	_file = FileMap::getIStream(filename);
+	_file->seekg(0, std::istream::end);
+	_fileSize = _file->tellg();
+	_file->seekg(0, std::istream::beg);
 
 	// Let's read the first 128 bytes
-	readFileHeader();
+	Uint8 header[128];
+	if (!_file->read((char *)header, sizeof(header)))
+	{
+		Log(LOG_ERROR) << "Flx file failed header check.";
+		return false;
+	}
+	readFileHeader(header);
 
 	// If it's a FLC or FLI file, it's ok
 	if (_headerType == SDL_SwapLE16(FLI_TYPE) || (_headerType == SDL_SwapLE16(FLC_TYPE)))
@@ -166,11 +167,21 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 		_mainScreen = SDL_AllocSurface(SDL_SWSURFACE, _realScreen->getSurface()->w, _realScreen->getSurface()->h, 8, 0, 0, 0, 0);
 	}
 
+	// Delta frames build on the previous one, so the decoder keeps its own copy
+	_canvas.assign(_headerWidth * _headerHeight, 0);
+	memset(_palette, 0, sizeof(_palette));
+	for (auto &frame : _frames)
+	{
+		frame.pixels.resize(_canvas.size());
+	}
+
 	return true;
 }
 
 void FlcPlayer::deInit()
 {
+	stopDecoder();
+
 	if (_mainScreen != 0 && _realScreen != 0)
 	{
 		if (_mainScreen != _realScreen->getSurface())
@@ -179,17 +190,19 @@ void FlcPlayer::deInit()
 		_mainScreen = 0;
 	}
 
-	if (_fileBuf != 0)
+	if (_file)
 	{
-		delete[] _fileBuf;
-		_fileBuf = 0;
+		_file.reset();
+		_audioQueue.clear();
 
 		deInitAudio();
 	}
 }
 
 /**
- * Starts decoding and playing the FLI/FLC file
+ * Starts decoding and playing the FLI/FLC file.
+ * The decoder thread works ahead while this one waits for
+ * the next frame time and puts the decoded frames on screen.
  */
 void FlcPlayer::play(bool skipLastFrame)
 {
@@ -201,15 +214,22 @@ void FlcPlayer::play(bool skipLastFrame)
 	_offset = _dy * _mainScreen->pitch + _mainScreen->format->BytesPerPixel * _dx;
 
 	// Skip file header
-	_videoFrameData = _fileBuf + 128;
-	_audioFrameData = _videoFrameData;
+	_file->clear();
+	_file->seekg(128, std::istream::beg);
+	_framesDecoded = 0;
+	_framesShown = 0;
+	_decoderDone = false;
+	_stopDecoder = false;
+	// TODO: support both, in the case the callback is not some audio?
+	_queueAudio = !_frameCallBack;
+	_decoder = std::thread(&FlcPlayer::decodeFile, this);
 
 	while (!shouldQuit())
 	{
 		if (_frameCallBack)
 			(*_frameCallBack)();
-		else // TODO: support both, in the case the callback is not some audio?
-			decodeAudio(2);
+		else
+			decodeAudio();
 
 		if (!shouldQuit())
 			decodeVideo(skipLastFrame);
@@ -218,6 +238,7 @@ void FlcPlayer::play(bool skipLastFrame)
 			SDLPolling();
 	}
 
+	stopDecoder();
 }
 
 void FlcPlayer::delay(Uint32 milliseconds)
@@ -268,15 +289,15 @@ bool FlcPlayer::shouldQuit()
 	return _playingState == FINISHED || _playingState == SKIPPED;
 }
 
-void FlcPlayer::readFileHeader()
+void FlcPlayer::readFileHeader(const Uint8 *header)
 {
-	readU32(_headerSize, _fileBuf);
-	readU16(_headerType, _fileBuf + 4);
-	readU16(_headerFrames, _fileBuf + 6);
-	readU16(_headerWidth, _fileBuf + 8);
-	readU16(_headerHeight, _fileBuf + 10);
-	readU16(_headerDepth, _fileBuf + 12);
-	readU16(_headerSpeed, _fileBuf + 16);
+	readU32(_headerSize, header);
+	readU16(_headerType, header + 4);
+	readU16(_headerFrames, header + 6);
+	readU16(_headerWidth, header + 8);
+	readU16(_headerHeight, header + 10);
+	readU16(_headerDepth, header + 12);
+	readU16(_headerSpeed, header + 16);
 }
 
 bool FlcPlayer::isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType)
@@ -287,113 +308,178 @@ bool FlcPlayer::isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &fram
 	return (frameType == FRAME_TYPE || frameType == AUDIO_CHUNK || frameType == PREFIX_CHUNK);
 }
 
-void FlcPlayer::decodeAudio(int frames)
+/**
+ * Reads the file one frame at a time on the decoder thread.
+ * Video frames are decoded into the ring as long as it has room,
+ * audio chunks are queued for the main thread to play.
+ */
+void FlcPlayer::decodeFile()
 {
+	Uint32 filePos = 128;
+	Uint8 frameHeader[6];
 
-	int audioFramesFound = 0;
-
-	while (audioFramesFound < frames && !isEndOfFile(_audioFrameData))
+	while (filePos + sizeof(frameHeader) <= _fileSize && _file->read((char *)frameHeader, sizeof(frameHeader)))
 	{
-		if (!isValidFrame(_audioFrameData, _audioFrameSize, _audioFrameType))
-		{
-			_playingState = FINISHED;
+		Uint32 frameSize;
+		Uint16 frameType;
+		if (!isValidFrame(frameHeader, frameSize, frameType))
+			break;
+
+		// The size of audio chunks leaves out their headers
+		Uint32 recordSize = (frameType == AUDIO_CHUNK) ? frameSize + 16 : frameSize;
+		Uint32 minSize = (frameType == PREFIX_CHUNK) ? sizeof(frameHeader) : 16;
+		if (recordSize < minSize || recordSize > _fileSize - filePos)
 			break;
+		filePos += recordSize;
+
+		if (frameType == PREFIX_CHUNK)
+		{
+			// Just skip it
+			_file->ignore(recordSize - sizeof(frameHeader));
+			continue;
 		}
 
-		switch (_audioFrameType)
+		_record.resize(recordSize);
+		std::copy(frameHeader, frameHeader + sizeof(frameHeader), _record.begin());
+		if (!_file->read((char *)_record.data() + sizeof(frameHeader), recordSize - sizeof(frameHeader)))
+			break;
+
+		if (frameType == AUDIO_CHUNK)
 		{
-			case FRAME_TYPE:
-			case PREFIX_CHUNK:
-				_audioFrameData += _audioFrameSize;
-				break;
-			case AUDIO_CHUNK:
-				Uint16 sampleRate;
+			if (_queueAudio && recordSize > 16)
+			{
+				AudioFrame audio;
+				readU16(audio.sampleRate, &_record[8]);
+				audio.samples.assign(_record.begin() + 16, _record.end());
 
-				readU16(sampleRate, _audioFrameData + 8);
+				std::lock_guard<std::mutex> lock(_decodeMutex);
+				_audioQueue.push_back(std::move(audio));
+			}
+			continue;
+		}
 
-				_chunkData = _audioFrameData + 16;
+		{
+			std::unique_lock<std::mutex> lock(_decodeMutex);
+			_frameFree.wait(lock, [this] { return _stopDecoder || _framesDecoded - _framesShown < FRAMES_AHEAD; });
+			if (_stopDecoder)
+				return;
+		}
 
-				playAudioFrame(sampleRate);
+		VideoFrame &frame = _frames[_framesDecoded % FRAMES_AHEAD];
+		readU16(_frameChunks, &_record[6]);
+		readU16(frame.delayOverride, &_record[8]);
+		// Skip the frame header, we are not interested in the rest
+		_chunkData = &_record[16];
 
-				_audioFrameData += _audioFrameSize + 16;
+		_paletteRanges.clear();
+		decodeFrame();
 
-				++audioFramesFound;
+		std::copy(_canvas.begin(), _canvas.end(), frame.pixels.begin());
+		for (const auto &range : _paletteRanges)
+		{
+			std::copy(_palette + range.first, _palette + range.first + range.second, frame.palette + range.first);
+		}
+		frame.paletteRanges = _paletteRanges;
+		// If this frame is the last one, don't play it
+		frame.last = (filePos == _fileSize);
 
-				break;
+		{
+			std::lock_guard<std::mutex> lock(_decodeMutex);
+			++_framesDecoded;
 		}
+		_frameReady.notify_one();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_decodeMutex);
+		_decoderDone = true;
 	}
+	_frameReady.notify_one();
 }
 
-void FlcPlayer::decodeVideo(bool skipLastFrame)
+/**
+ * Stops the decoder thread, if it's running.
+ */
+void FlcPlayer::stopDecoder()
 {
-	bool videoFrameFound = false;
+	if (!_decoder.joinable())
+		return;
 
-	while (!videoFrameFound)
 	{
-		if (!isValidFrame(_videoFrameData, _videoFrameSize, _videoFrameType))
-		{
-			_playingState = FINISHED;
-			break;
-		}
-
-		switch (_videoFrameType)
-		{
-		case FRAME_TYPE:
-
-			Uint32 delay;
-
-			readU16(_frameChunks, _videoFrameData + 6);
-			readU16(_delayOverride, _videoFrameData + 8);
+		std::lock_guard<std::mutex> lock(_decodeMutex);
+		_stopDecoder = true;
+	}
+	_frameFree.notify_one();
+	_decoder.join();
+}
 
-			if (_headerType == FLI_TYPE)
-			{
-				delay = _delayOverride > 0 ? _delayOverride : _headerSpeed * (1000.0 / 70.0);
-			}
-			else if (_useInternalAudio && !_frameCallBack) // this means TFTD videos are playing
-			{
-				delay = _videoDelay;
-			}
-			else
-			{
-				delay = _headerSpeed;
-			}
+/**
+ * Plays the audio chunks the decoder has read so far.
+ */
+void FlcPlayer::decodeAudio()
+{
+	std::lock_guard<std::mutex> lock(_decodeMutex);
+	for (const auto &audio : _audioQueue)
+	{
+		_audioFrameSize = audio.samples.size();
+		playAudioFrame(audio.samples.data(), audio.sampleRate);
+	}
+	_audioQueue.clear();
+}
 
-			waitForNextFrame(delay);
+/**
+ * Waits for the next decoded frame and shows it when its time comes.
+ */
+void FlcPlayer::decodeVideo(bool skipLastFrame)
+{
+	std::unique_lock<std::mutex> lock(_decodeMutex);
+	_frameReady.wait(lock, [this] { return _framesDecoded != _framesShown || _decoderDone; });
+	if (_framesDecoded == _framesShown)
+	{
+		_playingState = FINISHED;
+		return;
+	}
+	const VideoFrame &frame = _frames[_framesShown % FRAMES_AHEAD];
+	lock.unlock();
 
-			// Skip the frame header, we are not interested in the rest
-			_chunkData = _videoFrameData + 16;
+	// The first audio chunk sets the frame rate of TFTD videos
+	if (_queueAudio)
+		decodeAudio();
 
-			_videoFrameData += _videoFrameSize;
-			// If this frame is the last one, don't play it
-			if(isEndOfFile(_videoFrameData))
-				_playingState = FINISHED;
+	Uint32 delay;
+	if (_headerType == FLI_TYPE)
+	{
+		delay = frame.delayOverride > 0 ? frame.delayOverride : _headerSpeed * (1000.0 / 70.0);
+	}
+	else if (_useInternalAudio && !_frameCallBack) // this means TFTD videos are playing
+	{
+		delay = _videoDelay;
+	}
+	else
+	{
+		delay = _headerSpeed;
+	}
 
-			if(!shouldQuit() || !skipLastFrame)
-				playVideoFrame();
+	waitForNextFrame(delay);
 
-			videoFrameFound = true;
+	if (frame.last)
+		_playingState = FINISHED;
 
-			break;
-		case AUDIO_CHUNK:
-			_videoFrameData += _videoFrameSize + 16;
-			break;
-		case PREFIX_CHUNK:
-			// Just skip it
-			_videoFrameData += _videoFrameSize;
+	if(!shouldQuit() || !skipLastFrame)
+		playVideoFrame(frame);
 
-			break;
-		}
-	}
+	lock.lock();
+	++_framesShown;
+	lock.unlock();
+	_frameFree.notify_one();
 }
 
-void FlcPlayer::playVideoFrame()
+void FlcPlayer::decodeFrame()
 {
-	++_frameCount;
-	if (SDL_LockSurface(_mainScreen) < 0)
-		return;
+	const Uint8 *recordEnd = _record.data() + _record.size();
 	int chunkCount = _frameChunks;
 
-	for (int i = 0; i < chunkCount; ++i)
+	for (int i = 0; i < chunkCount && _chunkData + 6 <= recordEnd; ++i)
 	{
 		readU32(_chunkSize, _chunkData);
 		readU16(_chunkType, _chunkData + 4);
@@ -430,6 +516,32 @@ void FlcPlayer::playVideoFrame()
 
 		_chunkData += _chunkSize;
 	}
+}
+
+void FlcPlayer::playVideoFrame(const VideoFrame &frame)
+{
+	++_frameCount;
+	for (const auto &range : frame.paletteRanges)
+	{
+		SDL_Color *colors = const_cast<SDL_Color*>(frame.palette) + range.first;
+		if (_mainScreen != _realScreen->getSurface())
+			SDL_SetColors(_mainScreen, colors, range.first, range.second);
+		_realScreen->setPalette(colors, range.first, range.second, true);
+	}
+
+	if (SDL_LockSurface(_mainScreen) < 0)
+		return;
+
+	int width = std::min<int>(_headerWidth, _mainScreen->w - _dx);
+	int height = std::min<int>(_headerHeight, _mainScreen->h - _dy);
+	const Uint8 *pSrc = frame.pixels.data();
+	Uint8 *pDst = (Uint8*)_mainScreen->pixels + _offset;
+	for (int y = 0; width > 0 && y < height; ++y)
+	{
+		memcpy(pDst, pSrc, width);
+		pSrc += _headerWidth;
+		pDst += _mainScreen->pitch;
+	}
 
 	SDL_UnlockSurface(_mainScreen);
 
@@ -441,7 +553,7 @@ void FlcPlayer::playVideoFrame()
 	_realScreen->flip();
 }
 
-void FlcPlayer::playAudioFrame(Uint16 sampleRate)
+void FlcPlayer::playAudioFrame(const Uint8 *samples, Uint16 sampleRate)
 {
 	/* TFTD audio header (10 bytes)
 	* Uint16 unknown1 - always 0
@@ -479,7 +591,7 @@ void FlcPlayer::playAudioFrame(Uint16 sampleRate)
 
 		for (unsigned int i = 0; i < _audioFrameSize; i++)
 		{
-			loadingBuff->samples[loadingBuff->sampleCount + i] = (float)((_chunkData[i]) -128) * 240 * _volume;
+			loadingBuff->samples[loadingBuff->sampleCount + i] = (float)((samples[i]) -128) * 240 * _volume;
 		}
 		loadingBuff->sampleCount += _audioFrameSize;
 
@@ -511,16 +623,18 @@ void FlcPlayer::color256()
 			numColors = 256;
 		}
 
+		int count = std::min(256 - numColorsSkip, (int)numColors);
 		for (int i = 0; i < numColors; ++i)
 		{
-			_colors[i].r = *(pSrc++);
-			_colors[i].g = *(pSrc++);
-			_colors[i].b = *(pSrc++);
+			if (i < count)
+			{
+				_palette[numColorsSkip + i].r = pSrc[0];
+				_palette[numColorsSkip + i].g = pSrc[1];
+				_palette[numColorsSkip + i].b = pSrc[2];
+			}
+			pSrc += 3;
 		}
-
-		if (_mainScreen != _realScreen->getSurface())
-			SDL_SetColors(_mainScreen, _colors, numColorsSkip, numColors);
-		_realScreen->setPalette(_colors, numColorsSkip, numColors, true);
+		_paletteRanges.push_back(std::make_pair((int)numColorsSkip, count));
 
 		if (numColorPackets >= 1)
 		{
@@ -540,7 +654,7 @@ void FlcPlayer::fliSS2()
 	Uint8 lastByte = 0;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 	readU16(lines, pSrc);
 
 	pSrc += 2;
@@ -552,7 +666,7 @@ void FlcPlayer::fliSS2()
 
 		if ((count & MASK) == SKIP_LINES)
 		{
-			pDst += (-count)*_mainScreen->pitch;
+			pDst += (-count)*_headerWidth;
 			++lines;
 			continue;
 		}
@@ -601,9 +715,9 @@ void FlcPlayer::fliSS2()
 			if (setLastByte)
 			{
 				setLastByte = false;
-				*(pDst + _mainScreen->pitch - 1) = lastByte;
+				*(pDst + _headerWidth - 1) = lastByte;
 			}
-			pDst += _mainScreen->pitch;
+			pDst += _headerWidth;
 		}
 	}
 }
@@ -616,7 +730,7 @@ void FlcPlayer::fliBRun()
 
 	heightCount = _headerHeight;
 	pSrc = _chunkData + 6; // Skip chunk header
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	while (heightCount--)
 	{
@@ -648,7 +762,7 @@ void FlcPlayer::fliBRun()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _headerWidth;
 	}
 }
 
@@ -663,11 +777,11 @@ void FlcPlayer::fliLC()
 	int packetsCount;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	readU16(tmp, pSrc);
 	pSrc += 2;
-	pDst += tmp*_mainScreen->pitch;
+	pDst += tmp*_headerWidth;
 	readU16(lines, pSrc);
 	pSrc += 2;
 
@@ -702,7 +816,7 @@ void FlcPlayer::fliLC()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _headerWidth;
 	}
 }
 
@@ -726,16 +840,18 @@ void FlcPlayer::color64()
 			NumColors = 256;
 		}
 
+		int count = std::min(256 - NumColorsSkip, (int)NumColors);
 		for (int i = 0; i < NumColors; ++i)
 		{
-			_colors[i].r = *(pSrc++) << 2;
-			_colors[i].g = *(pSrc++) << 2;
-			_colors[i].b = *(pSrc++) << 2;
+			if (i < count)
+			{
+				_palette[NumColorsSkip + i].r = pSrc[0] << 2;
+				_palette[NumColorsSkip + i].g = pSrc[1] << 2;
+				_palette[NumColorsSkip + i].b = pSrc[2] << 2;
+			}
+			pSrc += 3;
 		}
-
-		if (_mainScreen != _realScreen->getSurface())
-			SDL_SetColors(_mainScreen, _colors, NumColorsSkip, NumColors);
-		_realScreen->setPalette(_colors, NumColorsSkip, NumColors, true);
+		_paletteRanges.push_back(std::make_pair((int)NumColorsSkip, count));
 	}
 }
 
@@ -744,27 +860,19 @@ void FlcPlayer::fliCopy()
 	Uint8 *pSrc, *pDst;
 	int Lines = _screenHeight;
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	while (Lines--)
 	{
 		memcpy(pDst, pSrc, _screenWidth);
 		pSrc += _screenWidth;
-		pDst += _mainScreen->pitch;
+		pDst += _headerWidth;
 	}
 }
 
 void FlcPlayer::black()
 {
-	Uint8 *pDst;
-	int Lines = _screenHeight;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
-
-	while (Lines-- > 0)
-	{
-		memset(pDst, 0, _screenHeight);
-		pDst += _mainScreen->pitch;
-	}
+	std::fill(_canvas.begin(), _canvas.end(), 0);
 }
 
 void FlcPlayer::audioCallback(void *userData, Uint8 *stream, int len)
@@ -875,11 +983,6 @@ void FlcPlayer::stop()
 	_playingState = FINISHED;
 }
 
-bool FlcPlayer::isEndOfFile(Uint8 *pos)
-{
-	return (pos - _fileBuf) == (int)(_fileSize); // should be Sint64, but let's assume the videos won't be 2gb
-}
-
 int FlcPlayer::getFrameCount()
 {
 	return _frameCount;
@@ -910,26 +1013,12 @@ void FlcPlayer::waitForNextFrame(Uint32 delay)
 	else
 		newTick = oldTick + delay;
 
-	if (_hasAudio)
+	while (currentTick < newTick)
 	{
-		while (currentTick < newTick)
-		{
-			while ((newTick - currentTick) > 10 && !isEndOfFile(_audioFrameData))
-			{
-				decodeAudio(1);
-				currentTick = SDL_GetTicks();
-			}
-			SDL_Delay(1);
-			currentTick = SDL_GetTicks();
-		}
-	}
-	else
-	{
-		while (currentTick < newTick)
-		{
-			SDL_Delay(1);
-			currentTick = SDL_GetTicks();
-		}
+		if (_hasAudio && (newTick - currentTick) > 10)
+			decodeAudio();
+		SDL_Delay(1);
+		currentTick = SDL_GetTicks();
 	}
 	oldTick = SDL_GetTicks();
 }
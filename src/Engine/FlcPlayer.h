@@ -22,6 +22,14 @@
 /*
  * Based on http://www.libsdl.org/projects/flxplay/
  */
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <SDL.h>
 
 namespace OpenXcom
@@ -34,11 +42,25 @@ class FlcPlayer
 {
 private:
 
-	Uint8 *_fileBuf;
+	/// A decoded frame waiting to be shown.
+	struct VideoFrame
+	{
+		std::vector<Uint8> pixels;
+		SDL_Color palette[256];
+		std::vector<std::pair<int, int> > paletteRanges;
+		Uint16 delayOverride;
+		bool last;
+	};
+	/// An audio chunk waiting to be played.
+	struct AudioFrame
+	{
+		std::vector<Uint8> samples;
+		Uint16 sampleRate;
+	};
+	static const int FRAMES_AHEAD = 8;
+
+	std::unique_ptr<std::istream> _file;
 	Uint32 _fileSize;
-	Uint8 *_videoFrameData;
-	Uint8 *_chunkData;
-	Uint8 *_audioFrameData;
 	Uint16 _frameCount;    /* Frame Counter */
 	Uint32 _headerSize;    /* Fli file size */
 	Uint16 _headerType;    /* Fli header check */
@@ -47,20 +69,30 @@ private:
 	Uint16 _headerHeight;  /* Fli height */
 	Uint16 _headerDepth;   /* Color depth */
 	Uint16 _headerSpeed;   /* Number of video ticks between frame */
-	Uint32 _videoFrameSize;     /* Frame size in bytes */
-	Uint16 _videoFrameType;
+	Uint32 _audioFrameSize;
+
+	/* Only touched by the decoder thread */
+	std::vector<Uint8> _record, _canvas;
+	Uint8 *_chunkData;
 	Uint16 _frameChunks;   /* Number of chunks in frame */
 	Uint32 _chunkSize;     /* Size of chunk */
 	Uint16 _chunkType;     /* Type of chunk */
-	Uint16 _delayOverride; /* FRAME_TYPE extension */
-	Uint32 _audioFrameSize;
-	Uint16 _audioFrameType;
+	SDL_Color _palette[256];
+	std::vector<std::pair<int, int> > _paletteRanges;
+
+	/* Shared with the decoder thread, guarded by _decodeMutex */
+	VideoFrame _frames[FRAMES_AHEAD];
+	std::deque<AudioFrame> _audioQueue;
+	Uint32 _framesDecoded, _framesShown;
+	bool _queueAudio, _decoderDone, _stopDecoder;
+	std::mutex _decodeMutex;
+	std::condition_variable _frameReady, _frameFree;
+	std::thread _decoder;
 
 	void (*_frameCallBack)();
 
 	SDL_Surface *_mainScreen;
 	Screen *_realScreen;
-	SDL_Color _colors[256];
 	int _screenWidth;
 	int _screenHeight;
 	int _screenDepth;
@@ -97,16 +129,22 @@ private:
 	void readU32(Uint32 &dst, const Uint8 *const src);
 	void readS16(Sint16 &dst, const Sint8 *const src);
 	void readS32(Sint32 &dst, const Sint8 *const src);
-	void readFileHeader();
+	void readFileHeader(const Uint8 *header);
 
 	bool isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType);
+	/// Reads and decodes the file on the decoder thread.
+	void decodeFile();
+	/// Decodes the chunks of a frame into the canvas.
+	void decodeFrame();
+	/// Stops the decoder thread.
+	void stopDecoder();
 	void decodeVideo(bool skipLastFrame);
-	void decodeAudio(int frames);
+	void decodeAudio();
 	void waitForNextFrame(Uint32 delay);
 	void SDLPolling();
 	bool shouldQuit();
 
-	void playVideoFrame();
+	void playVideoFrame(const VideoFrame &frame);
 	void color256();
 	void fliBRun();
 	void fliCopy();
@@ -115,12 +153,10 @@ private:
 	void color64();
 	void black();
 
-	void playAudioFrame(Uint16 sampleRate);
+	void playAudioFrame(const Uint8 *samples, Uint16 sampleRate);
 	void initAudio(Uint16 format, Uint8 channels);
 	void deInitAudio();
 
-	bool isEndOfFile(Uint8 *pos);
-
 	static void audioCallback(void *userData, Uint8 *stream, int len);
 
 public:
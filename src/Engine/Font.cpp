@@ -25,6 +25,16 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Codepoints below this are looked up in a table instead of the map.
+const UCode LOW_CHARS = 0x180;
+/// Layouts kept before the cache starts over.
+const size_t MAX_LAYOUTS = 4096;
+
+}
+
 const SDL_Color Font::TerminalColors[2] = {{0, 0, 0, 0}, {185, 185, 185, 255}};
 
 /**
@@ -163,6 +173,37 @@ void Font::init(size_t index, const UString &str)
 		}
 	}
 	surface->unlock();
+
+	// map elements don't move on rehash, so the table stays valid
+	auto fallback = _chars.find('?');
+	_lowChars.assign(LOW_CHARS, fallback != _chars.end() ? &fallback->second : nullptr);
+	for (UCode c = 0; c < LOW_CHARS; ++c)
+	{
+		auto f = _chars.find(c);
+		if (f != _chars.end())
+		{
+			_lowChars[c] = &f->second;
+		}
+	}
+	_layouts.clear();
+}
+
+/**
+ * Looks up where a character is in the font, using the
+ * table for the common codepoints.
+ * @param c Font character.
+ * @return Image index and cropping rectangle of the character.
+ */
+const std::pair<size_t, SDL_Rect> *Font::findChar(UCode c) const
+{
+	if (c < _lowChars.size())
+	{
+		return _lowChars[c];
+	}
+	auto f = _chars.find(c);
+	if (f == _chars.end())
+		f = _chars.find('?');
+	return &f->second;
 }
 
 /**
@@ -173,11 +214,9 @@ void Font::init(size_t index, const UString &str)
  */
 SurfaceCrop Font::getChar(UCode c) const
 {
-	auto f = _chars.find(c);
-	if (f == _chars.end())
-		f = _chars.find('?');
-	auto surfaceCrop = _images[f->second.first].surface->getCrop();
-	*surfaceCrop.getCrop() = f->second.second;
+	auto f = findChar(c);
+	auto surfaceCrop = _images[f->first].surface->getCrop();
+	*surfaceCrop.getCrop() = f->second;
 	return surfaceCrop;
 }
 
@@ -220,13 +259,10 @@ SDL_Rect Font::getCharSize(UCode c) const
 	SDL_Rect size = { 0, 0, 0, 0 };
 	if (Unicode::isPrintable(c))
 	{
-		auto f = _chars.find(c);
-		if (f == _chars.end())
-			f = _chars.find('?');
-
-		const FontImage *image = &_images[f->second.first];
-		size.w = f->second.second.w + image->spacing;
-		size.h = f->second.second.h + image->spacing;
+		auto f = findChar(c);
+		const FontImage *image = &_images[f->first];
+		size.w = f->second.w + image->spacing;
+		size.h = f->second.h + image->spacing;
 	}
 	else
 	{
@@ -246,4 +282,33 @@ SDL_Rect Font::getCharSize(UCode c) const
 	return size;
 }
 
+/**
+ * Returns the layout of a text that was already
+ * processed with this font and the same settings.
+ * @param key Text and layout settings.
+ * @return Cached layout, or null if there is none.
+ */
+const FontTextLayout *Font::findLayout(const FontLayoutKey &key) const
+{
+	auto f = _layouts.find(key);
+	if (f == _layouts.end())
+		return nullptr;
+	return &f->second;
+}
+
+/**
+ * Stores the layout of a processed text, so other texts
+ * with the same contents and settings can skip measuring it.
+ * @param key Text and layout settings.
+ * @param layout Processed text and line metrics.
+ */
+void Font::storeLayout(FontLayoutKey &&key, const FontTextLayout &layout)
+{
+	if (_layouts.size() >= MAX_LAYOUTS)
+	{
+		_layouts.clear();
+	}
+	_layouts.emplace(std::move(key), layout);
+}
+
 }
@@ -19,6 +19,7 @@
  */
 #include <unordered_map>
 #include <vector>
+#include <string>
 #include <utility>
 #include <SDL.h>
 #include <yaml-cpp/yaml.h>
@@ -38,6 +39,47 @@ struct FontImage
 	Surface *surface;
 };
 
+/**
+ * The settings a text was laid out with.
+ * Width and wrapping flags are only set for wrapped text.
+ */
+struct FontLayoutKey
+{
+	std::string text;
+	int width;
+	const void *small;
+	Uint8 flags;
+
+	bool operator==(const FontLayoutKey &other) const
+	{
+		return width == other.width && small == other.small && flags == other.flags && text == other.text;
+	}
+};
+
+/**
+ * Hashes the settings a text was laid out with.
+ */
+struct FontLayoutKeyHash
+{
+	size_t operator()(const FontLayoutKey &key) const
+	{
+		size_t h = std::hash<std::string>()(key.text);
+		h ^= std::hash<int>()(key.width * 16 + key.flags) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		h ^= std::hash<const void*>()(key.small) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		return h;
+	}
+};
+
+/**
+ * A text converted to codepoints and broken into lines,
+ * with the width and height of each line.
+ */
+struct FontTextLayout
+{
+	UString text;
+	std::vector<int> lineWidth, lineHeight;
+};
+
 /**
  * Takes care of loading and storing each character in a sprite font.
  * Sprite fonts consist of a set of characters split in fixed-size regions.
@@ -49,9 +91,13 @@ class Font
 private:
 	std::vector<FontImage> _images;
 	std::unordered_map< UCode, std::pair<size_t, SDL_Rect> > _chars;
+	std::vector<const std::pair<size_t, SDL_Rect>*> _lowChars;
+	std::unordered_map<FontLayoutKey, FontTextLayout, FontLayoutKeyHash> _layouts;
 	bool _monospace;
 	/// Determines the size and position of each character in the font.
 	void init(size_t index, const UString &str);
+	/// Gets the image and position of a character, or of '?' if it's missing.
+	const std::pair<size_t, SDL_Rect> *findChar(UCode c) const;
 public:
 
 	/// Default palette for terminal text.
@@ -75,6 +121,10 @@ public:
 	int getSpacing() const;
 	/// Gets the size of a particular character;
 	SDL_Rect getCharSize(UCode c) const;
+	/// Gets a text laid out earlier with the same settings.
+	const FontTextLayout *findLayout(const FontLayoutKey &key) const;
+	/// Remembers how a text was laid out.
+	void storeLayout(FontLayoutKey &&key, const FontTextLayout &layout);
 };
 
 }
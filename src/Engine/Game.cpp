@@ -33,6 +33,7 @@
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "Action.h"
 #include "Exception.h"
 #include "Options.h"
@@ -101,6 +102,9 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	// Create fps counter
 	_fpsCounter = new FpsCounter(15, 5, 0, 0);
 
+	// Create save writer
+	_saveWriter = new SaveWriter();
+
 	// Create blank language
 	_lang = new Language();
 
@@ -115,6 +119,9 @@ Game::~Game()
 	Sound::stop();
 	Music::stop();
 
+	// finish writing the last save before anything goes away
+	delete _saveWriter;
+
 	for (auto* state : _states)
 	{
 		delete state;
@@ -149,6 +156,8 @@ void Game::run()
 	Uint32 lastMouseMoveEvent = 0;
 	Sint16 xrel = 0;
 	Sint16 yrel = 0;
+	// replays run as fast as they can, without drawing anything
+	const bool headless = !Options::getReplayBattle().empty();
 
 	while (!_quit)
 	{
@@ -193,6 +202,8 @@ void Game::run()
 					// An event other than SDL_APPMOUSEFOCUS change happened.
 					if (reinterpret_cast<SDL_ActiveEvent*>(&_event)->state & ~SDL_APPMOUSEFOCUS)
 					{
+						// the window may have been covered or minimized, show the current frame again
+						_screen->invalidate();
 						Uint8 currentState = SDL_GetAppState();
 						// Game is minimized
 						if (!(currentState & SDL_APPACTIVE))
@@ -223,6 +234,9 @@ void Game::run()
 						}
 					}
 					break;
+				case SDL_VIDEOEXPOSE:
+					_screen->invalidate();
+					break;
 				case SDL_VIDEORESIZE:
 					if (Options::allowResize)
 					{
@@ -346,7 +360,7 @@ void Game::run()
 				_timeUntilNextFrame = 0;
 			}
 
-			if (_init && _timeUntilNextFrame <= 0)
+			if (_init && _timeUntilNextFrame <= 0 && !headless)
 			{
 				// make a note of when this frame update occurred.
 				_timeOfLastFrame = SDL_GetTicks();
@@ -373,7 +387,8 @@ void Game::run()
 		switch (runningState)
 		{
 			case RUNNING:
-				SDL_Delay(1); //Save CPU from going 100%
+				if (!headless)
+					SDL_Delay(1); //Save CPU from going 100%
 				break;
 			case SLOWED: case PAUSED:
 				SDL_Delay(100); break; //More slowing down.
@@ -388,11 +403,12 @@ void Game::run()
  */
 void Game::quit()
 {
-	// Always save ironman
-	if (_save != 0 && _save->isIronman() && !_save->getName().empty())
+	// Always save ironman, unless it's only being replayed
+	if (_save != 0 && _save->isIronman() && !_save->getName().empty() && Options::getReplayBattle().empty())
 	{
 		std::string filename = CrossPlatform::sanitizeFilename(_save->getName()) + ".sav";
-		_save->save(filename, _mod);
+		_saveWriter->save(filename, _save->snapshot(_mod));
+		_saveWriter->wait();
 	}
 	_quit = true;
 }
@@ -656,6 +672,7 @@ void Game::loadLanguages()
 	_lang->loadRule(_mod->getExtraStrings(), defaultLang);
 	if (twoLangs)
 		_lang->loadRule(_mod->getExtraStrings(), currentLang);
+	_lang->buildIndex();
 }
 
 /**
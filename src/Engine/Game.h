@@ -34,6 +34,7 @@ class ModInfo;
 class FpsCounter;
 class Action;
 class GeoscapeState;
+class SaveWriter;
 
 /**
  * The core of the game engine, manages the game's entire contents and structure.
@@ -53,6 +54,7 @@ private:
 	Mod *_mod;
 	bool _quit, _init, _update;
 	FpsCounter *_fpsCounter;
+	SaveWriter *_saveWriter;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
 	int _timeUntilNextFrame;
@@ -78,6 +80,8 @@ public:
 	Cursor *getCursor() const { return _cursor; }
 	/// Gets the FpsCounter.
 	FpsCounter *getFpsCounter() const { return _fpsCounter; }
+	/// Gets the background save writer.
+	SaveWriter *getSaveWriter() const { return _saveWriter; }
 	/// Resets the state stack to a new state.
 	void setState(State *state);
 	/// Pushes a new state into the state stack.
@@ -22,6 +22,8 @@
 #include <cassert>
 #include <set>
 #include <climits>
+#include <cstring>
+#include <functional>
 #include <algorithm>
 #include "CrossPlatform.h"
 #include "Logger.h"
@@ -36,6 +38,7 @@ namespace OpenXcom
 {
 
 std::map<std::string, std::string> Language::_names;
+const char *const Language::PLURAL_SUFFIXES[PLURAL_FORMS] = { "_zero", "_one", "_few", "_many", "_other" };
 std::vector<std::string> Language::_rtl, Language::_cjk;
 
 /**
@@ -186,6 +189,8 @@ void Language::getList(std::vector<std::string> &ids, std::vector<std::string> &
  */
 void Language::loadFile(const FileMap::FileRecord *frec)
 {
+	_entries.clear();
+	_slots.clear();
 	YAML::Node doc = frec->getYAML();
 	YAML::Node lang;
 	if (doc.begin()->second.IsMap())
@@ -232,6 +237,8 @@ void Language::loadFile(const FileMap::FileRecord *frec)
  */
 void Language::loadRule(const std::map<std::string, ExtraStrings*> &extraStrings, const std::string &id)
 {
+	_entries.clear();
+	_slots.clear();
 	auto it = extraStrings.find(id);
 	if (it != extraStrings.end())
 	{
@@ -257,41 +264,180 @@ std::string Language::loadString(const std::string &string) const
 }
 
 /**
- * Returns the localized text with the specified ID.
- * If it's not found, just returns the ID.
+ * Builds the hash table used to look up strings, once all the
+ * language files are loaded. Every ID gets an entry, and so does
+ * the base of every plural form (STR_X for STR_X_one), with the
+ * texts of its forms, so a quantity lookup is a single probe.
+ * Loading more strings drops the table until it's built again.
+ */
+void Language::buildIndex()
+{
+	_entries.clear();
+	_entries.reserve(_strings.size() + _strings.size() / 4);
+	size_t capacity = 16;
+	while (capacity < _strings.size() * 2)
+	{
+		capacity *= 2;
+	}
+	_slots.assign(capacity, EMPTY_SLOT);
+
+	for (auto& pair : _strings)
+	{
+		_entries[getEntry(pair.first)].text = &pair.second;
+		size_t sep = pair.first.rfind('_');
+		if (sep != std::string::npos)
+		{
+			for (int form = 0; form < PLURAL_FORMS; ++form)
+			{
+				if (pair.first.compare(sep, std::string::npos, PLURAL_SUFFIXES[form]) == 0)
+				{
+					_entries[getEntry(pair.first.substr(0, sep))].forms[form] = &pair.second;
+					break;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Looks up a string ID in the hash table, probing linearly.
  * @param id ID of the string.
- * @return String with the requested ID.
+ * @return Entry of the ID, or null if it's not there.
  */
-LocalizedText Language::getString(const std::string &id) const
+const Language::StringEntry *Language::findEntry(const std::string &id) const
 {
-	if (id.empty())
+	if (_slots.empty())
 	{
-		return id;
+		return 0;
 	}
-	auto s = _strings.find(id);
-	// Check if translation strings recently learned pluralization.
-	if (s == _strings.end())
+	size_t hash = std::hash<std::string>()(id);
+	size_t mask = _slots.size() - 1;
+	for (size_t i = hash & mask; _slots[i] != EMPTY_SLOT; i = (i + 1) & mask)
 	{
-		return getString(id, UINT_MAX);
+		const StringEntry &entry = _entries[_slots[i]];
+		if (entry.hash == hash && entry.id == id)
+		{
+			return &entry;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Finds a string ID in the hash table, adding an empty entry
+ * for it if it's not there. The table is kept at most half full.
+ * @param id ID of the string.
+ * @return Index of the entry, stays valid until the table is rebuilt.
+ */
+size_t Language::getEntry(const std::string &id)
+{
+	const StringEntry *found = findEntry(id);
+	if (found)
+	{
+		return found - &_entries[0];
+	}
+
+	StringEntry entry;
+	entry.id = id;
+	entry.hash = std::hash<std::string>()(id);
+	entry.text = 0;
+	std::fill(std::begin(entry.forms), std::end(entry.forms), nullptr);
+	_entries.push_back(entry);
+
+	if (_entries.size() * 2 > _slots.size())
+	{
+		// grow and put all the entries back
+		_slots.assign(_slots.size() * 2, EMPTY_SLOT);
+		for (size_t e = 0; e < _entries.size(); ++e)
+		{
+			addSlot(e);
+		}
 	}
 	else
 	{
-		return s->second;
+		addSlot(_entries.size() - 1);
 	}
+	return _entries.size() - 1;
 }
 
 /**
- * Returns the localized text with the specified ID, in the proper form for @a n.
- * The substitution of @a n has already happened in the returned LocalizedText.
- * If it's not found, just returns the ID.
+ * Puts an entry in the first free slot after the one its hash points to.
+ * @param entry Index of the entry.
+ */
+void Language::addSlot(size_t entry)
+{
+	size_t mask = _slots.size() - 1;
+	size_t i = _entries[entry].hash & mask;
+	while (_slots[i] != EMPTY_SLOT)
+	{
+		i = (i + 1) & mask;
+	}
+	_slots[i] = (Uint32)entry;
+}
+
+/**
+ * Returns the plural form a language uses for a number.
+ * @param n Number.
+ * @return Plural form.
+ */
+Language::PluralForm Language::getPluralForm(unsigned n) const
+{
+	const char *suffix = _handler->getSuffix(n);
+	for (int form = 0; form < PLURAL_FORMS; ++form)
+	{
+		if (strcmp(suffix, PLURAL_SUFFIXES[form]) == 0)
+		{
+			return (PluralForm)form;
+		}
+	}
+	return PLURAL_OTHER;
+}
+
+/**
+ * Finds the text of a string in the proper form for @a n,
+ * from the forms stored with its entry.
+ * @param entry Entry of the string, or null if it's not there.
+ * @param n Number to use to decide the proper form.
+ * @return Text of the form, or null if there's none.
+ */
+const LocalizedText *Language::findPlural(const StringEntry *entry, unsigned n) const
+{
+	if (!entry)
+	{
+		return 0;
+	}
+	const LocalizedText *text = 0;
+	// Try specialized form.
+	if (n == 0)
+	{
+		text = entry->forms[PLURAL_ZERO];
+	}
+	// Try proper form by language
+	if (!text)
+	{
+		text = entry->forms[getPluralForm(n)];
+	}
+	// Try default form
+	if (!text)
+	{
+		text = entry->forms[PLURAL_OTHER];
+	}
+	return text;
+}
+
+/**
+ * Finds the text of a string in the proper form for @a n,
+ * using the lookup table if it's built.
  * @param id ID of the string.
  * @param n Number to use to decide the proper form.
- * @return String with the requested ID.
+ * @return Text of the form, or null if there's none.
  */
-LocalizedText Language::getString(const std::string &id, unsigned n) const
+const LocalizedText *Language::findPlural(const std::string &id, unsigned n) const
 {
-	assert(!id.empty());
-	static std::set<std::string> notFoundIds;
+	if (!_slots.empty())
+	{
+		return findPlural(findEntry(id), n);
+	}
 	auto s = _strings.end();
 	// Try specialized form.
 	if (n == 0)
@@ -308,8 +454,22 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 	{
 		s = _strings.find(id + "_other");
 	}
+	return s != _strings.end() ? &s->second : 0;
+}
+
+/**
+ * Substitutes @a n in the proper form of a string,
+ * or returns the ID if the string has no plural forms.
+ * @param id ID of the string.
+ * @param text Text of the proper form, or null if it wasn't found.
+ * @param n Number to substitute, UINT_MAX if the string was asked for as singular.
+ * @return String with the requested ID.
+ */
+LocalizedText Language::formatPlural(const std::string &id, const LocalizedText *text, unsigned n) const
+{
+	static std::set<std::string> notFoundIds;
 	// Give up
-	if (s == _strings.end())
+	if (!text)
 	{
 		if (notFoundIds.end() == notFoundIds.find(id))
 		{
@@ -326,17 +486,64 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 			Log(LOG_WARNING) << id << " has plural format in ``" << Options::language << "``. Code assumes singular format.";
 //		Hint: Change ``getstring(ID).arg(value)`` to ``getString(ID, value)`` in appropriate files.
 		}
-		return s->second;
+		return *text;
 	}
 	else
 	{
 		std::ostringstream ss;
 		ss << n;
-		std::string marker("{N}"), val(ss.str()), txt(s->second);
+		std::string marker("{N}"), val(ss.str()), txt(*text);
 		Unicode::replace(txt, marker, val);
 		return txt;
 	}
+}
+
+/**
+ * Returns the localized text with the specified ID.
+ * If it's not found, just returns the ID.
+ * @param id ID of the string.
+ * @return String with the requested ID.
+ */
+LocalizedText Language::getString(const std::string &id) const
+{
+	if (id.empty())
+	{
+		return id;
+	}
+	if (!_slots.empty())
+	{
+		const StringEntry *entry = findEntry(id);
+		if (entry && entry->text)
+		{
+			return *entry->text;
+		}
+		// Check if translation strings recently learned pluralization.
+		return formatPlural(id, findPlural(entry, UINT_MAX), UINT_MAX);
+	}
+	auto s = _strings.find(id);
+	// Check if translation strings recently learned pluralization.
+	if (s == _strings.end())
+	{
+		return getString(id, UINT_MAX);
+	}
+	else
+	{
+		return s->second;
+	}
+}
 
+/**
+ * Returns the localized text with the specified ID, in the proper form for @a n.
+ * The substitution of @a n has already happened in the returned LocalizedText.
+ * If it's not found, just returns the ID.
+ * @param id ID of the string.
+ * @param n Number to use to decide the proper form.
+ * @return String with the requested ID.
+ */
+LocalizedText Language::getString(const std::string &id, unsigned n) const
+{
+	assert(!id.empty());
+	return formatPlural(id, findPlural(id, n), n);
 }
 
 /**
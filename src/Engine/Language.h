@@ -20,6 +20,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <SDL_types.h>
 #include "LocalizedText.h"
 #include "FileMap.h"
 
@@ -41,7 +42,21 @@ enum SoldierGender : char;
 class Language
 {
 private:
+	enum PluralForm { PLURAL_ZERO, PLURAL_ONE, PLURAL_FEW, PLURAL_MANY, PLURAL_OTHER, PLURAL_FORMS };
+	/// A string ID in the lookup table, with its text and the texts of its plural forms.
+	struct StringEntry
+	{
+		std::string id;
+		size_t hash;
+		const LocalizedText *text;
+		const LocalizedText *forms[PLURAL_FORMS];
+	};
+	static const char *const PLURAL_SUFFIXES[PLURAL_FORMS];
+	static const Uint32 EMPTY_SLOT = 0xFFFFFFFF;
+
 	std::map<std::string, LocalizedText> _strings;
+	std::vector<StringEntry> _entries;
+	std::vector<Uint32> _slots;
 	LanguagePlurality *_handler;
 	TextDirection _direction;
 	TextWrapping _wrap;
@@ -51,6 +66,20 @@ private:
 
 	/// Parses a text string loaded from an external file.
 	std::string loadString(const std::string &s) const;
+	/// Finds a string ID in the lookup table.
+	const StringEntry *findEntry(const std::string &id) const;
+	/// Finds or adds a string ID to the lookup table.
+	size_t getEntry(const std::string &id);
+	/// Puts an entry in a free slot of the lookup table.
+	void addSlot(size_t entry);
+	/// Gets the plural form the language uses for a number.
+	PluralForm getPluralForm(unsigned n) const;
+	/// Finds the text of a plural form.
+	const LocalizedText *findPlural(const StringEntry *entry, unsigned n) const;
+	/// Finds the text of a plural form.
+	const LocalizedText *findPlural(const std::string &id, unsigned n) const;
+	/// Fills in a plural form, or reports it's missing.
+	LocalizedText formatPlural(const std::string &id, const LocalizedText *text, unsigned n) const;
 public:
 	/// Creates a blank language.
 	Language();
@@ -64,6 +93,8 @@ public:
 	void loadFile(const FileMap::FileRecord *frec);
 	/// Loads the language from a ruleset file.
 	void loadRule(const std::map<std::string, ExtraStrings*> &extraStrings, const std::string &id);
+	/// Builds the lookup table once all the strings are loaded.
+	void buildIndex();
 	/// Outputs the language to a HTML file.
 	void toHtml(const std::string &filename) const;
 	/// Get a localized text.
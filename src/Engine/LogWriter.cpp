@@ -0,0 +1,279 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LogWriter.h"
+#include <chrono>
+#include <cstdio>
+
+namespace OpenXcom
+{
+
+/**
+ * Opens the log file for appending and starts the thread that writes to it.
+ * If the file can't be opened no thread is started.
+ * @param filename Path of the log file.
+ */
+LogWriter::LogWriter(const std::string &filename) : _cells(new Cell[CAPACITY]), _head(0), _tail(0), _filename(filename), _file(0), _quit(false)
+{
+	for (size_t i = 0; i < CAPACITY; ++i)
+	{
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+		_cells[i].echo = false;
+	}
+	// Even SDL1 file IO accepts UTF-8 file names on windows.
+	_file = SDL_RWFromFile(_filename.c_str(), "a+");
+	if (_file)
+	{
+		_thread = std::thread(&LogWriter::work, this);
+	}
+}
+
+/**
+ * Stops the writer thread and writes out the messages still queued.
+ */
+LogWriter::~LogWriter()
+{
+	if (_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(_wakeMutex);
+			_quit = true;
+		}
+		_wake.notify_one();
+		_thread.join();
+	}
+	flush();
+}
+
+/**
+ * Claims the next free cell of the ring and moves the message into it.
+ * Any number of threads can push at the same time.
+ * @param text Message, emptied if it was added.
+ * @param echo Also copy the message to stderr?
+ * @return False if the ring is full.
+ */
+bool LogWriter::push(std::string &text, bool echo)
+{
+	Cell *cell;
+	size_t pos = _tail.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		cell = &_cells[pos % CAPACITY];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		if (sequence == pos)
+		{
+			if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (sequence < pos)
+		{
+			// the reader hasn't freed this cell yet
+			return false;
+		}
+		else
+		{
+			pos = _tail.load(std::memory_order_relaxed);
+		}
+	}
+	cell->text.swap(text);
+	cell->echo = echo;
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+/**
+ * Takes the oldest message out of the ring and frees its cell.
+ * @param text Returns the message.
+ * @param echo Returns if the message goes to stderr too.
+ * @return False if the ring is empty.
+ */
+bool LogWriter::pop(std::string &text, bool &echo)
+{
+	Cell *cell;
+	size_t pos = _head.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		cell = &_cells[pos % CAPACITY];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		if (sequence == pos + 1)
+		{
+			if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (sequence < pos + 1)
+		{
+			// nothing written here yet
+			return false;
+		}
+		else
+		{
+			pos = _head.load(std::memory_order_relaxed);
+		}
+	}
+	text.clear();
+	text.swap(cell->text);
+	echo = cell->echo;
+	cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+	return true;
+}
+
+/**
+ * Takes out up to a ring's worth of messages and writes them in one go,
+ * reopening the file if it was closed by a flush.
+ */
+void LogWriter::drain()
+{
+	std::string batch, echoed, text;
+	bool echo;
+	for (size_t i = 0; i < CAPACITY && pop(text, echo); ++i)
+	{
+		batch += text;
+		if (echo)
+		{
+			echoed += text;
+		}
+	}
+	if (!echoed.empty())
+	{
+		fwrite(echoed.c_str(), echoed.size(), 1, stderr);
+		fflush(stderr);
+	}
+	if (batch.empty())
+	{
+		return;
+	}
+	if (!_file)
+	{
+		_file = SDL_RWFromFile(_filename.c_str(), "a+");
+	}
+	if (!_file || SDL_RWwrite(_file, batch.c_str(), batch.size(), 1) != 1)
+	{
+		// can't log the failure, it would come right back here
+		std::string err = "Failed to append to '" + _filename + "': " + SDL_GetError() + "\n";
+		fwrite(err.c_str(), err.size(), 1, stderr);
+		fwrite(batch.c_str(), batch.size(), 1, stderr);
+		fflush(stderr);
+	}
+}
+
+/**
+ * Wakes up when the ring fills up or every now and then,
+ * and writes out whatever was queued since.
+ */
+void LogWriter::work()
+{
+	std::unique_lock<std::mutex> lock(_wakeMutex);
+	while (!_quit)
+	{
+		_wake.wait_for(lock, std::chrono::milliseconds(50));
+		lock.unlock();
+		{
+			std::lock_guard<std::mutex> fileLock(_fileMutex);
+			drain();
+		}
+		lock.lock();
+	}
+}
+
+/**
+ * Queues a message for the writer thread. Doesn't wait unless
+ * the ring is full, then the message queue is written out here.
+ * @param text Formatted message, with the line break.
+ * @param echo Also copy the message to stderr?
+ */
+void LogWriter::write(std::string &&text, bool echo)
+{
+	while (!push(text, echo))
+	{
+		std::lock_guard<std::mutex> fileLock(_fileMutex);
+		drain();
+	}
+	if (_tail.load(std::memory_order_relaxed) - _head.load(std::memory_order_relaxed) > CAPACITY / 4)
+	{
+		_wake.notify_one();
+	}
+}
+
+/**
+ * Writes out all the queued messages and closes the file,
+ * so nothing is left in buffers if the game is about to die.
+ * The file is opened again for the next messages.
+ */
+void LogWriter::flush()
+{
+	std::lock_guard<std::mutex> fileLock(_fileMutex);
+	drainAll();
+}
+
+/**
+ * Writes out the queued messages when the game is crashing.
+ * Whoever holds the file lock may be the thread that crashed
+ * or may never let go, so if it's taken this doesn't wait: the
+ * ring is emptied through a file handle of its own instead,
+ * since the lock holder could be halfway through using the
+ * shared one.
+ */
+void LogWriter::flushOnCrash()
+{
+	std::unique_lock<std::mutex> fileLock(_fileMutex, std::try_to_lock);
+	if (fileLock.owns_lock())
+	{
+		drainAll();
+		return;
+	}
+	SDL_RWops *file = SDL_RWFromFile(_filename.c_str(), "a+");
+	std::string text;
+	bool echo;
+	while (pop(text, echo))
+	{
+		bool written = file && SDL_RWwrite(file, text.c_str(), text.size(), 1) == 1;
+		if (echo || !written)
+		{
+			fwrite(text.c_str(), text.size(), 1, stderr);
+		}
+	}
+	fflush(stderr);
+	if (file)
+	{
+		SDL_RWclose(file);
+	}
+}
+
+/**
+ * Writes out all the queued messages and closes the file.
+ */
+void LogWriter::drainAll()
+{
+	while (_head.load(std::memory_order_relaxed) != _tail.load(std::memory_order_relaxed))
+	{
+		size_t before = _head.load(std::memory_order_relaxed);
+		drain();
+		if (_head.load(std::memory_order_relaxed) == before)
+		{
+			// a message is still being copied in, it'll be written next time
+			break;
+		}
+	}
+	if (_file)
+	{
+		SDL_RWclose(_file);
+		_file = 0;
+	}
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Appends log messages to the log file on a thread of its own.
+ * Messages go through a fixed size ring that threads add to without
+ * locking, the writer thread takes them out in batches and writes
+ * them to the file, which stays open. When the ring is full the
+ * thread logging writes out the queue itself instead of waiting.
+ */
+class LogWriter
+{
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		std::string text;
+		bool echo;
+	};
+	static const size_t CAPACITY = 4096;
+	std::unique_ptr<Cell[]> _cells;
+	std::atomic<size_t> _head, _tail;
+	std::string _filename;
+	SDL_RWops *_file;
+	std::mutex _fileMutex, _wakeMutex;
+	std::condition_variable _wake;
+	bool _quit;
+	std::thread _thread;
+
+	/// Adds a message to the ring, returns false if it's full.
+	bool push(std::string &text, bool echo);
+	/// Takes the oldest message out of the ring, returns false if it's empty.
+	bool pop(std::string &text, bool &echo);
+	/// Writes out the queued messages, the file lock must be held.
+	void drain();
+	/// Writes out all the queued messages and closes the file, the file lock must be held.
+	void drainAll();
+	/// Writes messages as they come in.
+	void work();
+public:
+	/// Opens the log file and starts the writer thread.
+	LogWriter(const std::string &filename);
+	/// Writes out what's left and stops the thread.
+	~LogWriter();
+	LogWriter(const LogWriter&) = delete;
+	LogWriter &operator=(const LogWriter&) = delete;
+	/// Checks if the log file could be opened.
+	bool isOpen() const { return _thread.joinable(); }
+	/// Queues a formatted message, also copying it to stderr if echo is set.
+	void write(std::string &&text, bool echo);
+	/// Writes out all the queued messages and closes the file until the next ones.
+	void flush();
+	/// Writes out the queued messages without waiting for the file lock.
+	void flushOnCrash();
+};
+
+}
@@ -23,7 +23,6 @@
 #include "Unicode.h"
 #include "FileMap.h"
 #include "SDL2Helpers.h"
-#include "Adlib/adlplayer.h"
 #include "AdlibMusic.h"
 
 namespace OpenXcom
@@ -106,7 +105,7 @@ void Music::stop()
 #ifndef __NO_MUSIC
 	if (!Options::mute)
 	{
-		func_mute();
+		AdlibMusic::mute();
 		Mix_HookMusic(NULL, NULL);
 		Mix_HaltMusic();
 	}
@@ -56,6 +56,8 @@ std::string _masterMod;
 int _passwordCheck = -1;
 bool _loadLastSave = false;
 bool _loadLastSaveExpended = false;
+std::string _replayBattle;
+bool _replayBattleExpended = false;
 
 /**
  * Sets up the options by creating their OptionInfo metadata.
@@ -78,6 +80,7 @@ void create()
 
 	_info.push_back(OptionInfo("maxFrameSkip", &maxFrameSkip, 0));
 	_info.push_back(OptionInfo("traceAI", &traceAI, false));
+	_info.push_back(OptionInfo("recordBattles", &recordBattles, false));
 	_info.push_back(OptionInfo("verboseLogging", &verboseLogging, false));
 	_info.push_back(OptionInfo("StereoSound", &StereoSound, true));
 	//_info.push_back(OptionInfo("baseXResolution", &baseXResolution, Screen::ORIGINAL_WIDTH));
@@ -142,6 +145,7 @@ void create()
 	_info.push_back(OptionInfo("preferredVideo", (int*)&preferredVideo, VIDEO_FMV));
 	_info.push_back(OptionInfo("wordwrap", (int*)&wordwrap, WRAP_AUTO));
 	_info.push_back(OptionInfo("musicAlwaysLoop", &musicAlwaysLoop, false));
+	_info.push_back(OptionInfo("adlibPreRender", &adlibPreRender, false));
 	_info.push_back(OptionInfo("touchEnabled", &touchEnabled, false));
 	_info.push_back(OptionInfo("rootWindowedMode", &rootWindowedMode, false));
 	_info.push_back(OptionInfo("backgroundMute", &backgroundMute, false));
@@ -276,6 +280,8 @@ void create()
 	_info.push_back(OptionInfo("oxceEmbeddedOnly", &oxceEmbeddedOnly, true));
 	_info.push_back(OptionInfo("oxceListVFSContents", &oxceListVFSContents, false));
 	_info.push_back(OptionInfo("oxceRawScreenShots", &oxceRawScreenShots, false));
+	_info.push_back(OptionInfo("oxceAssetCache", &oxceAssetCache, false));
+	_info.push_back(OptionInfo("oxceAliasWeightedChoice", &oxceAliasWeightedChoice, false));
 	_info.push_back(OptionInfo("oxceFirstPersonViewFisheyeProjection", &oxceFirstPersonViewFisheyeProjection, false));
 	_info.push_back(OptionInfo("oxceThumbButtons", &oxceThumbButtons, true));
 
@@ -564,6 +570,10 @@ static void loadArgs()
 				{
 					_masterMod = argv[i];
 				}
+				else if (argname == "replay")
+				{
+					_replayBattle = argv[i];
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -596,6 +606,8 @@ static bool showHelp()
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-master MOD" << std::endl;
 	help << "        set MOD to the current master mod (eg. -master xcom2)" << std::endl << std::endl;
+	help << "-replay NAME" << std::endl;
+	help << "        replay the battle recording NAME from the recordings subfolder of the User Folder without rendering and quit" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        override option KEY with VALUE (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -965,6 +977,21 @@ void expendLoadLastSave()
 	_loadLastSaveExpended = true;
 }
 
+const std::string &getReplayBattle()
+{
+	return _replayBattle;
+}
+
+bool getReplayBattleExpended()
+{
+	return _replayBattleExpended;
+}
+
+void expendReplayBattle()
+{
+	_replayBattleExpended = true;
+}
+
 /**
  * Sets up the game's Data folder where the data files
  * are loaded from and the User folder and Config
@@ -122,6 +122,12 @@ namespace Options
 	bool getLoadLastSave();
 	/// And do it only at startup
 	void expendLoadLastSave();
+	/// Gets the battle recording to replay instead of playing, if any.
+	const std::string &getReplayBattle();
+	/// If the replay was already loaded, so the game should close.
+	bool getReplayBattleExpended();
+	/// Marks the replay as loaded.
+	void expendReplayBattle();
 }
 
 }
@@ -112,12 +112,13 @@ void Screen::makeVideoFlags()
  * Initializes a new display screen for the game to render contents to.
  * The screen is set up based on the current options.
  */
-Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false)
+Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false), _lastFrameValid(false), _paletteChanged(false)
 {
 	_flickerFix = Options::oxceEnablePaletteFlickerFix;
 
 	resetDisplay();
 	memset(deferredPalette, 0, 256*sizeof(SDL_Color));
+	memset(_lastPalette, 0, 256*sizeof(SDL_Color));
 }
 
 /**
@@ -181,15 +182,52 @@ void Screen::handle(Action *action)
 }
 
 
+/**
+ * Compares the buffer and its palette with the last frame put on screen,
+ * and keeps a copy of them if they changed. Scaling and presenting are
+ * by far the most expensive part of a frame, and most screens show
+ * the same picture for long stretches, so this is well worth a compare.
+ * @return True if the frame needs to be put on screen.
+ */
+bool Screen::updateLastFrame()
+{
+	SDL_Surface *surface = _surface.get();
+	size_t size = (size_t)surface->pitch * surface->h;
+	const Uint8 *pixels = (const Uint8*)surface->pixels;
+	SDL_Palette *palette = surface->format->palette;
+	// getSurface() raises _pushPalette on every blit, only real palette changes count here
+	bool changed = !_lastFrameValid || _paletteChanged || _lastFrame.size() != size;
+	changed = changed || memcmp(_lastFrame.data(), pixels, size) != 0;
+	changed = changed || (palette && memcmp(_lastPalette, palette->colors, palette->ncolors * sizeof(SDL_Color)) != 0);
+	if (changed)
+	{
+		_lastFrame.assign(pixels, pixels + size);
+		if (palette)
+		{
+			memcpy(_lastPalette, palette->colors, palette->ncolors * sizeof(SDL_Color));
+		}
+		_lastFrameValid = true;
+		_paletteChanged = false;
+	}
+	return changed;
+}
+
 /**
  * Renders the buffer's contents onto the screen, applying
  * any necessary filters or conversions in the process.
  * If the scaling factor is bigger than 1, the entire contents
  * of the buffer are resized by that factor (eg. 2 = doubled)
  * before being put on screen.
+ * Frames identical to the last one are skipped, the window keeps showing it.
  */
 void Screen::flip()
 {
+	if (!updateLastFrame())
+	{
+		return;
+	}
+	Surface::CleanSdlSurface(_screen);
+
 	// perform any requested palette update
 	if (_flickerFix && _pushPalette && _numColors && _screen->format->BitsPerPixel == 8)
 	{
@@ -235,7 +273,6 @@ void Screen::flip()
 void Screen::clear()
 {
 	Surface::CleanSdlSurface(_surface.get());
-	Surface::CleanSdlSurface(_screen);
 }
 
 /**
@@ -263,6 +300,7 @@ void Screen::setPalette(const SDL_Color* colors, int firstcolor, int ncolors, bo
 	}
 
 	SDL_SetColors(_surface.get(), const_cast<SDL_Color *>(colors), firstcolor, ncolors);
+	_paletteChanged = true;
 
 	// defer actual update of screen until SDL_Flip()
 	if (immediately && _screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, const_cast<SDL_Color *>(colors), firstcolor, ncolors) == 0)
@@ -328,6 +366,7 @@ void Screen::resetDisplay(bool resetVideo, bool noShaders)
 	Uint32 oldFlags = _flags;
 #endif
 	makeVideoFlags();
+	invalidate();
 
 	if (!_surface || (_surface->format->BitsPerPixel != _bpp ||
 		_surface->w != _baseWidth ||
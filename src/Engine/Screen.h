@@ -19,6 +19,7 @@
  */
 #include <SDL.h>
 #include <string>
+#include <vector>
 #include "OpenGL.h"
 #include "Surface.h"
 
@@ -52,6 +53,12 @@ private:
 	OpenGL glOutput;
 	Surface::UniqueBufferPtr _buffer;
 	Surface::UniqueSurfacePtr _surface;
+	std::vector<Uint8> _lastFrame;
+	SDL_Color _lastPalette[256];
+	bool _lastFrameValid;
+	bool _paletteChanged;
+	/// Checks if the buffer differs from the last frame put on screen.
+	bool updateLastFrame();
 	/// Sets the _flags and _bpp variables based on game options; needed in more than one place now
 	void makeVideoFlags();
 public:
@@ -74,6 +81,8 @@ public:
 	void flip();
 	/// Clears the screen.
 	void clear();
+	/// Makes the next flip put the frame on screen even if it didn't change.
+	void invalidate() { _lastFrameValid = false; }
 	/// Sets the screen's 8bpp palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256, bool immediately = false);
 	/// Gets the screen's 8bpp palette.
@@ -3276,6 +3276,13 @@ ScriptParserEventsBase::ScriptParserEventsBase(ScriptGlobal* shared, const std::
  */
 void ScriptParserEventsBase::parseNode(ScriptContainerEventsBase& container, const std::string& type, const YAML::Node& node) const
 {
+	if (const YAML::Node& scripts = node["scripts"])
+	{
+		if (scripts[getName()])
+		{
+			container._custom = true;
+		}
+	}
 	ScriptParserBase::parseNode(container._current, type, node);
 	container._events = getEvents();
 }
@@ -3285,6 +3292,10 @@ void ScriptParserEventsBase::parseNode(ScriptContainerEventsBase& container, con
  */
 void ScriptParserEventsBase::parseCode(ScriptContainerEventsBase& container, const std::string& type, const std::string& srcCode) const
 {
+	if (!srcCode.empty())
+	{
+		container._custom = true;
+	}
 	ScriptParserBase::parseCode(container._current, type, srcCode);
 	container._events = getEvents();
 }
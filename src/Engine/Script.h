@@ -431,6 +431,7 @@ class ScriptContainerEventsBase
 	friend class ScriptParserEventsBase;
 	ScriptContainerBase _current;
 	const ScriptContainerBase* _events = nullptr;
+	bool _custom = false;
 
 public:
 	/// Test if is any script there.
@@ -438,6 +439,11 @@ public:
 	{
 		return true;
 	}
+	/// Test if only the default script of the parser is there, without any global events.
+	bool isDefault() const
+	{
+		return !_custom && (!_events || (!_events[0] && !_events[1]));
+	}
 
 	/// Get pointer to proc data.
 	const Uint8* data() const
@@ -21,6 +21,7 @@
 #include "Sound.h"
 #include "Logger.h"
 #include "SDL2Helpers.h"
+#include "AssetCache.h"
 #include <climits>
 #include <cassert>
 
@@ -63,8 +64,9 @@ static const Uint8 header[] = {  'R',  'I',  'F',  'F', 0x00, 0x00, 0x00, 0x00,
  * @param sound sound data
  * @param size  size of sound data
  * @param resample if resampling is needed.
+ * @return size of the whole WAV.
  */
-void SoundSet::writeWAV(SDL_RWops *dest, Uint8 *sound, size_t size, bool resample) const {
+size_t SoundSet::writeWAV(SDL_RWops *dest, Uint8 *sound, size_t size, bool resample) const {
 	SDL_RWwrite(dest, header, sizeof(header), 1);
 	int newsize = size;
 
@@ -82,6 +84,7 @@ void SoundSet::writeWAV(SDL_RWops *dest, Uint8 *sound, size_t size, bool resampl
 	SDL_WriteLE32(dest, newsize + 36);
 	SDL_RWseek(dest, 40, RW_SEEK_SET); 	// write data subchunk size
 	SDL_WriteLE32(dest, newsize);
+	return sizeof(header) + newsize;
 }
 
 /**
@@ -197,6 +200,21 @@ void SoundSet::loadCatByIndex(CatFile &catFile, int index, bool tftd)
 		return;
 	}
 
+	Uint64 cacheKey = 0;
+	if (AssetCache::isEnabled())
+	{
+		cacheKey = AssetCache::makeKey(sound, size, tftd ? 1 : 0);
+		size_t cachedSize;
+		const Uint8 *cached = AssetCache::open("snd", cacheKey, &cachedSize);
+		if (cached)
+		{
+			_sounds[set_index].load(SDL_RWFromConstMem(cached, cachedSize)); // this frees the rwops
+			AssetCache::close(cached, cachedSize);
+			SDL_free(sound);
+			return;
+		}
+	}
+
 	// See if we've got RIFF header here.
 	bool wav = ((sound[0] == 'R') && (sound[1] == 'I') && (sound[2]  == 'F') && (sound[3]  == 'F')
 			 && (sound[8] == 'W') && (sound[9] == 'A') && (sound[10] == 'V') && (sound[11] == 'E'));
@@ -235,11 +253,17 @@ void SoundSet::loadCatByIndex(CatFile &catFile, int index, bool tftd)
 	auto dest_mem = SDL_malloc(dest_size);
 	auto dest_rwops = SDL_RWFromMem(dest_mem, dest_size);
 
+	size_t wav_size = size;
 	if (do_resample) {
-		writeWAV(dest_rwops, samples, samplecount, !tftd);
+		wav_size = writeWAV(dest_rwops, samples, samplecount, !tftd);
 	} else { // nothing to do.
 		SDL_RWwrite(dest_rwops, sound, size, 1);
 	}
+	if (cacheKey && do_resample) // otherwise it is the CAT entry as is
+	{
+		std::vector<Uint8> wavData((Uint8 *)dest_mem, (Uint8 *)dest_mem + wav_size);
+		AssetCache::store("snd", cacheKey, wavData);
+	}
 	SDL_RWseek(dest_rwops, 0, RW_SEEK_SET);
 	_sounds[set_index].load(dest_rwops);  // this frees the dest_rwops
 	SDL_free(dest_mem);
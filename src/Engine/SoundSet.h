@@ -38,7 +38,7 @@ private:
 	int _sharedSounds;
 
 	int convertSampleRate(Uint8 *oldsound, size_t oldsize, Uint8 *newsound) const;
-	void writeWAV(SDL_RWops *dest, Uint8 *sound, size_t size, bool resample) const;
+	size_t writeWAV(SDL_RWops *dest, Uint8 *sound, size_t size, bool resample) const;
 
 public:
 	/// Crates a sound set.
@@ -29,6 +29,7 @@
 #include "Logger.h"
 #include "SDL2Helpers.h"
 #include "FileMap.h"
+#include "AssetCache.h"
 #ifdef _WIN32
 #include <malloc.h>
 #endif
@@ -366,6 +367,24 @@ void Surface::loadImage(const std::string &filename)
 	auto rw = FileMap::getRWops(filename);
 	if (!rw) { return; } // relevant message gets logged in FileMap.
 
+	Uint64 cacheKey = 0;
+	if (AssetCache::isEnabled())
+	{
+		size_t size;
+		void *data = SDL_LoadFile_RW(rw, &size, SDL_FALSE);
+		if (data)
+		{
+			cacheKey = AssetCache::makeKey(data, size, CrossPlatform::compareExt(filename, "png") ? 1 : 0);
+			SDL_free(data);
+			if (loadCachedImage(cacheKey, filename))
+			{
+				SDL_RWclose(rw);
+				return;
+			}
+		}
+		SDL_RWseek(rw, RW_SEEK_SET, 0);
+	}
+
 	// Try loading with LodePNG first
 	if (CrossPlatform::compareExt(filename, "png"))
 	{
@@ -414,6 +433,10 @@ void Surface::loadImage(const std::string &filename)
 					{
 						Log(LOG_WARNING) << "Image " << filename << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
 					}
+					if (cacheKey)
+					{
+						storeCachedImage(cacheKey, transparent, false);
+					}
 				}
 			} else {
 				Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(error);
@@ -448,7 +471,102 @@ void Surface::loadImage(const std::string &filename)
 		{
 			Log(LOG_WARNING) << "Image " << filename << " (from SDL) has incorrect transparent color index " << surface->format->colorkey << " (instead of 0).";
 		}
+		if (cacheKey)
+		{
+			storeCachedImage(cacheKey, surface->format->colorkey, true);
+		}
+	}
+}
+
+namespace
+{
+
+/**
+ * Layout of a decoded image in the asset cache,
+ * followed by the palette and the pixels without padding.
+ */
+struct CachedImageHeader
+{
+	Uint32 width, height, colors, transparent, fromSdl;
+};
+
+} //namespace
+
+/**
+ * Loads a decoded image from the asset cache. The pixels were stored
+ * with the transparent color already fixed.
+ * @param key Cache key of the image file contents.
+ * @param filename Filename of the image, for the log.
+ * @return True if the image was found in the cache.
+ */
+bool Surface::loadCachedImage(Uint64 key, const std::string &filename)
+{
+	size_t size;
+	const Uint8 *data = AssetCache::open("img", key, &size);
+	if (data == NULL)
+	{
+		return false;
+	}
+	CachedImageHeader header;
+	bool valid = size >= sizeof(header);
+	if (valid)
+	{
+		memcpy(&header, data, sizeof(header));
+		valid = header.colors <= 256 && size == sizeof(header) + header.colors * sizeof(SDL_Color) + (size_t)header.width * header.height;
+	}
+	if (valid)
+	{
+		const Uint8 *palette = data + sizeof(header);
+		const Uint8 *pixels = palette + header.colors * sizeof(SDL_Color);
+		*this = Surface(header.width, header.height, 0, 0);
+		if (header.colors)
+		{
+			SDL_Color colors[256];
+			memcpy(colors, palette, header.colors * sizeof(SDL_Color));
+			setPalette(colors, 0, header.colors);
+		}
+		for (Uint32 y = 0; y < header.height; ++y)
+		{
+			memcpy((Uint8 *)_surface->pixels + y * _surface->pitch, pixels + y * header.width, header.width);
+		}
+		if (header.transparent != 0)
+		{
+			Log(LOG_WARNING) << "Image " << filename << " (from " << (header.fromSdl ? "SDL" : "lodepng") << ") has incorrect transparent color index " << header.transparent << " (instead of 0).";
+		}
+	}
+	AssetCache::close(data, size);
+	return valid;
+}
+
+/**
+ * Saves a freshly decoded image to the asset cache.
+ * @param key Cache key of the image file contents.
+ * @param transparent Transparent color index of the file, for the log.
+ * @param fromSdl Was the image decoded by SDL_image, for the log.
+ */
+void Surface::storeCachedImage(Uint64 key, int transparent, bool fromSdl) const
+{
+	CachedImageHeader header;
+	header.width = _surface->w;
+	header.height = _surface->h;
+	header.colors = _surface->format->palette ? _surface->format->palette->ncolors : 0;
+	header.transparent = transparent;
+	header.fromSdl = fromSdl;
+
+	std::vector<Uint8> payload(sizeof(header) + header.colors * sizeof(SDL_Color) + (size_t)header.width * header.height);
+	Uint8 *out = payload.data();
+	memcpy(out, &header, sizeof(header));
+	out += sizeof(header);
+	if (header.colors)
+	{
+		memcpy(out, _surface->format->palette->colors, header.colors * sizeof(SDL_Color));
+		out += header.colors * sizeof(SDL_Color);
+	}
+	for (Uint32 y = 0; y < header.height; ++y)
+	{
+		memcpy(out + y * header.width, (const Uint8 *)_surface->pixels + y * _surface->pitch, header.width);
 	}
+	AssetCache::store("img", key, payload);
 }
 
 /**
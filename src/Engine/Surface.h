@@ -95,6 +95,10 @@ protected:
 	void rawCopy(const std::vector<T> &bytes);
 	/// Resizes the surface.
 	void resize(int width, int height);
+	/// Loads a decoded image from the asset cache.
+	bool loadCachedImage(Uint64 key, const std::string &filename);
+	/// Saves a decoded image to the asset cache.
+	void storeCachedImage(Uint64 key, int transparent, bool fromSdl) const;
 public:
 	/// Default empty surface.
 	Surface();
@@ -146,6 +146,15 @@ void Timer::setInterval(Uint32 interval)
 	_interval = interval;
 }
 
+/**
+ * Gets the time between calls of the timer's function.
+ * @return Interval in milliseconds.
+ */
+Uint32 Timer::getInterval() const
+{
+	return _interval;
+}
+
 /**
  * Sets a state function for the timer to call every interval.
  * @param handler Event handler.
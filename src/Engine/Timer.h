@@ -63,6 +63,8 @@ public:
 	void think(State* state, Surface* surface);
 	/// Sets the timer's interval.
 	void setInterval(Uint32 interval);
+	/// Gets the timer's interval.
+	Uint32 getInterval() const;
 	/// Hooks a state action handler to the timer interval.
 	void onTimer(StateHandler handler);
 	/// Hooks a surface action handler to the timer interval.
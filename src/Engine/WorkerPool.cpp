@@ -0,0 +1,143 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WorkerPool.h"
+#include <algorithm>
+
+namespace OpenXcom
+{
+
+/**
+ * Starts the worker threads, which wait for jobs.
+ * @param workers Number of threads besides the one calling run().
+ */
+WorkerPool::WorkerPool(int workers) : _job(0), _count(0), _band(1), _busy(0), _next(0), _generation(0), _quit(false)
+{
+	for (int i = 0; i < workers; ++i)
+	{
+		_workers.push_back(std::thread(&WorkerPool::work, this));
+	}
+}
+
+/**
+ * Stops and joins the worker threads.
+ */
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_quit = true;
+	}
+	_wake.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+/**
+ * Worker thread body: sleeps until there is a new job,
+ * works on it and reports back when out of bands.
+ */
+void WorkerPool::work()
+{
+	unsigned int seen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [&]{ return _quit || _generation != seen; });
+			if (_quit)
+			{
+				return;
+			}
+			seen = _generation;
+		}
+		runBands();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_busy == 0)
+			{
+				_done.notify_one();
+			}
+		}
+	}
+}
+
+/**
+ * Takes bands of the current job until the whole range is handed out.
+ */
+void WorkerPool::runBands()
+{
+	while (true)
+	{
+		int first = _next.fetch_add(_band);
+		if (first >= _count)
+		{
+			return;
+		}
+		(*_job)(first, std::min(first + _band, _count));
+	}
+}
+
+/**
+ * Runs a job over a range of items, split into bands that are
+ * handed out to the workers and the calling thread as they get free.
+ * Small ranges or pools without workers just run on the calling thread.
+ * @param count Number of items.
+ * @param band Number of items to hand out at once.
+ * @param job Function to call with the half-open item ranges [first, last).
+ */
+void WorkerPool::run(int count, int band, const std::function<void(int, int)> &job)
+{
+	band = std::max(band, 1);
+	if (_workers.empty() || count <= band)
+	{
+		job(0, count);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_job = &job;
+		_count = count;
+		_band = band;
+		_next = 0;
+		_busy = (int)_workers.size();
+		++_generation;
+	}
+	_wake.notify_all();
+	runBands();
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [&]{ return _busy == 0; });
+	_job = 0;
+}
+
+/**
+ * Gets the pool shared by the jobs run from the main thread, like scaling
+ * and explosions. They never overlap, so they can all use the same threads.
+ * Leaves a core for the rest of the system, and more than 8 threads
+ * don't pay off for jobs this size.
+ * @return The shared pool.
+ */
+WorkerPool &WorkerPool::getShared()
+{
+	static WorkerPool pool(std::min(std::max((int)std::thread::hardware_concurrency(), 1) - 1, 7));
+	return pool;
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * A set of threads that stay around between jobs, for work that
+ * has to be split up again and again, like scaling every frame.
+ * A job covers a range of items which gets handed out in bands,
+ * the calling thread works on it too and only returns when it's done.
+ * Jobs must not throw.
+ */
+class WorkerPool
+{
+private:
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _wake, _done;
+	const std::function<void(int, int)> *_job;
+	int _count, _band, _busy;
+	std::atomic<int> _next;
+	unsigned int _generation;
+	bool _quit;
+	/// Waits for jobs and helps with them.
+	void work();
+	/// Runs bands of the current job until there are none left.
+	void runBands();
+public:
+	/// Creates a pool with the given number of extra threads.
+	WorkerPool(int workers);
+	/// Stops the threads.
+	~WorkerPool();
+	/// Gets how many threads work on a job, including the caller.
+	int getThreads() const { return (int)_workers.size() + 1; }
+	/// Runs a job over the items [0, count) in bands of the given size.
+	void run(int count, int band, const std::function<void(int, int)> &job);
+	/// Gets the pool shared by the jobs run from the main thread.
+	static WorkerPool &getShared();
+};
+
+}
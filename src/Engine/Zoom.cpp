@@ -25,6 +25,7 @@
 #include "Screen.h"
 
 #include "OpenGL.h"
+#include "WorkerPool.h"
 
 // Scale2X
 #include "Scalers/scalebit.h"
@@ -61,6 +62,27 @@
 namespace OpenXcom
 {
 
+/**
+ * Gets the threads the filters run on, the main thread helps out.
+ * @return The scaler thread pool.
+ */
+static WorkerPool &scalerPool()
+{
+	return WorkerPool::getShared();
+}
+
+/**
+ * Gets how many source rows to hand to a scaler thread at once:
+ * a few bands per thread to even out the load, but not so thin
+ * that the filters spend their time on the rows around each band.
+ * @param height Height of the source image.
+ * @return Number of rows per band.
+ */
+static int scalerBand(int height)
+{
+	return std::max(16, height / (scalerPool().getThreads() * 2));
+}
+
 
 /**
  * Optimized 8-bit zoomer for resizing by a factor of 2. Doesn't flip.
@@ -738,7 +760,10 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 			{
 				if (dst->w == src->w * (int)factor && dst->h == src->h * (int)factor)
 				{
-					xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB);
+					scalerPool().run(src->h, scalerBand(src->h), [&](int yFirst, int yLast)
+					{
+						xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB, xbrz::ScalerCfg(), yFirst, yLast);
+					});
 					return 0;
 				}
 			}
@@ -754,23 +779,32 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 				initDone = true;
 			}
 
-			// HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height );
+			// HQX_API void HQX_CALLCONV hq2x_32_rb_slice( uint32_t * src, uint32_t src_rowBytes, uint32_t * dest, uint32_t dest_rowBytes, int width, int height, int yFirst, int yLast );
 
 			if (dst->w == src->w * 2 && dst->h == src->h * 2)
 			{
-				hq2x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				scalerPool().run(src->h, scalerBand(src->h), [&](int yFirst, int yLast)
+				{
+					hq2x_32_rb_slice((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h, yFirst, yLast);
+				});
 				return 0;
 			}
 
 			if (dst->w == src->w * 3 && dst->h == src->h * 3)
 			{
-				hq3x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				scalerPool().run(src->h, scalerBand(src->h), [&](int yFirst, int yLast)
+				{
+					hq3x_32_rb_slice((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h, yFirst, yLast);
+				});
 				return 0;
 			}
 
 			if (dst->w == src->w * 4 && dst->h == src->h * 4)
 			{
-				hq4x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				scalerPool().run(src->h, scalerBand(src->h), [&](int yFirst, int yLast)
+				{
+					hq4x_32_rb_slice((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h, yFirst, yLast);
+				});
 				return 0;
 			}
 		}
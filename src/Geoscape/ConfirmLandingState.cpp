@@ -35,12 +35,15 @@
 #include "../Savegame/AlienBase.h"
 #include "../Battlescape/BriefingState.h"
 #include "../Battlescape/BattlescapeGenerator.h"
+#include "../Battlescape/TerrainPrefetcher.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
 #include "../Mod/RuleStartingCondition.h"
 #include "../Mod/AlienDeployment.h"
 #include "../Mod/AlienRace.h"
 #include "../Mod/Mod.h"
+#include "../Mod/RuleCraft.h"
+#include "../Mod/RuleUfo.h"
 #include "../Mod/Texture.h"
 
 namespace OpenXcom
@@ -53,7 +56,7 @@ namespace OpenXcom
  * @param globeTexture Globe texture of the landing site.
  * @param shade Shade of the landing site.
  */
-ConfirmLandingState::ConfirmLandingState(Craft *craft, Texture *missionTexture, Texture *globeTexture, int shade) : _craft(craft), _missionTexture(missionTexture), _globeTexture(globeTexture), _shade(shade)
+ConfirmLandingState::ConfirmLandingState(Craft *craft, Texture *missionTexture, Texture *globeTexture, int shade) : _craft(craft), _missionTexture(missionTexture), _globeTexture(globeTexture), _shade(shade), _prefetch(0)
 {
 	_screen = false;
 
@@ -131,14 +134,18 @@ ConfirmLandingState::ConfirmLandingState(Craft *craft, Texture *missionTexture,
 			sprites->getFrame(2)->blitNShade(_sprite, 0, 0);
 		}
 	}
+
+	prefetchTerrain();
 }
 
 /**
- *
+ * Stops the terrain prefetch, if still running.
  */
 ConfirmLandingState::~ConfirmLandingState()
 {
-
+	SavedGame *save = _game->getSavedGame();
+	_prefetch->finish(save ? save->getSavedBattle() : 0);
+	delete _prefetch;
 }
 
 /*
@@ -153,9 +160,10 @@ void ConfirmLandingState::init()
 }
 
 /**
-* Checks the starting condition.
-*/
-std::string ConfirmLandingState::checkStartingCondition()
+ * Gets the deployment of the mission at the craft's destination.
+ * @return Pointer to the deployment or null if there's no mission.
+ */
+AlienDeployment *ConfirmLandingState::getMissionDeployment() const
 {
 	Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
 	MissionSite* m = dynamic_cast<MissionSite*>(_craft->getDestination());
@@ -181,12 +189,16 @@ std::string ConfirmLandingState::checkStartingCondition()
 		ruleDeploy = _game->getMod()->getDeployment(race->getBaseCustomMission());
 		if (!ruleDeploy) ruleDeploy = _game->getMod()->getDeployment(b->getDeployment()->getType());
 	}
-	else
-	{
-		// irrelevant for this check
-		return "";
-	}
+	return ruleDeploy;
+}
 
+/**
+* Checks the starting condition.
+*/
+std::string ConfirmLandingState::checkStartingCondition()
+{
+	Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
+	AlienDeployment *ruleDeploy = getMissionDeployment();
 	if (ruleDeploy == 0)
 	{
 		// just in case
@@ -298,9 +310,53 @@ void ConfirmLandingState::btnYesClick(Action *)
 		throw Exception("No mission available!");
 	}
 	bgen.run();
+	_prefetch->finish(bgame);
 	_game->pushState(new BriefingState(_craft));
 }
 
+/**
+ * Starts decoding the terrains the mission may be generated with,
+ * so that the generator doesn't have to wait for them (as much)
+ * once the player confirms. Terrain choice is random, so every
+ * candidate is loaded; the unused ones are dropped afterwards.
+ */
+void ConfirmLandingState::prefetchTerrain()
+{
+	Mod *mod = _game->getMod();
+	_prefetch = new TerrainPrefetcher(mod);
+
+	AlienDeployment *ruleDeploy = getMissionDeployment();
+	if (!ruleDeploy)
+	{
+		// not landing anywhere interesting
+		return;
+	}
+	AlienBase* b = dynamic_cast<AlienBase*>(_craft->getDestination());
+	if (!ruleDeploy->getTerrains().empty())
+	{
+		for (const auto& name : ruleDeploy->getTerrains())
+		{
+			_prefetch->add(mod->getTerrain(name));
+		}
+	}
+	else if (_missionTexture && !b)
+	{
+		for (const auto& criteria : *_missionTexture->getTerrain())
+		{
+			_prefetch->add(mod->getTerrain(criteria.name));
+		}
+	}
+
+	Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
+	if (u)
+	{
+		_prefetch->add(u->getRules()->getBattlescapeTerrainData());
+	}
+	_prefetch->add(_craft->getRules()->getBattlescapeTerrainData());
+
+	_prefetch->start();
+}
+
 /**
  * Returns the craft to base and closes the window.
  * @param action Pointer to an action.
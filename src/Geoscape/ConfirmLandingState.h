@@ -28,6 +28,8 @@ class TextButton;
 class Craft;
 class Texture;
 class Surface;
+class AlienDeployment;
+class TerrainPrefetcher;
 
 /**
  * Window that allows the player
@@ -43,8 +45,13 @@ private:
 	Text *_txtMessage, *_txtBegin;
 	TextButton *_btnYes, *_btnNo;
 	Surface *_sprite;
+	TerrainPrefetcher *_prefetch;
+	// Gets the deployment of the mission at the destination
+	AlienDeployment *getMissionDeployment() const;
 	// Checks the starting condition
 	std::string checkStartingCondition();
+	// Starts loading the terrains the mission may need
+	void prefetchTerrain();
 public:
 	/// Creates the Confirm Landing state.
 	ConfirmLandingState(Craft *craft, Texture *missionTexture, Texture *globeTexture, int shade);
@@ -0,0 +1,1597 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DogfightSimulation.h"
+#include <algorithm>
+#include "GeoscapeState.h"
+#include "Globe.h"
+#include "../Engine/Game.h"
+#include "../Engine/Collections.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Engine/Sound.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/Soldier.h"
+#include "../Mod/RuleSoldier.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/CraftWeapon.h"
+#include "../Mod/RuleCraftWeapon.h"
+#include "../Savegame/Ufo.h"
+#include "../Mod/RuleUfo.h"
+#include "../Mod/AlienRace.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/CraftWeaponProjectile.h"
+#include "../Savegame/Country.h"
+#include "../Mod/RuleCountry.h"
+#include "../Savegame/Region.h"
+#include "../Mod/RuleRegion.h"
+#include "../Savegame/AlienMission.h"
+#include "../Mod/Mod.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Sets up the dogfight between a craft and an UFO.
+ * @param game Pointer to the core game.
+ * @param state Pointer to the Geoscape.
+ * @param craft Pointer to the craft intercepting.
+ * @param ufo Pointer to the UFO being intercepted.
+ * @param ufoIsAttacking Is UFO the aggressor?
+ */
+DogfightSimulation::DogfightSimulation(Game *game, GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking) :
+	_game(game), _state(state), _view(0), _craft(craft), _ufo(ufo), _mode(ufoIsAttacking ? DFM_AGGRESSIVE : DFM_STANDOFF),
+	_ufoIsAttacking(ufoIsAttacking), _disableDisengage(false), _disableCautious(false), _craftIsDefenseless(false), _selfDestructPressed(false),
+	_timeout(50), _currentDist(640), _targetDist(560),
+	_end(false), _endUfoHandled(false), _endCraftHandled(false), _ufoBreakingOff(false), _destroyUfo(false), _destroyCraft(false),
+	_minimized(false), _endDogfight(false), _animatingHit(false), _ufoSize(0), _interceptionNumber(0),
+	_firedAtLeastOnce(false), _experienceAwarded(false)
+{
+	_craft->setInDogfight(true);
+	_weaponNum = _craft->getRules()->getWeapons();
+	if (_weaponNum > RuleCraft::WeaponMax)
+		_weaponNum = RuleCraft::WeaponMax;
+
+	for (int i = 0; i < _weaponNum; ++i)
+	{
+		_weaponEnabled[i] = true;
+		_weaponFireCountdown[i] = 0;
+		_tractorLockedOn[i] = false;
+
+		CraftWeapon* w = _craft->getWeapons()->at(i);
+		if (w)
+		{
+			_weaponEnabled[i] = !w->isDisabled();
+		}
+	}
+
+	// pilot modifiers
+	const std::vector<Soldier*> pilots = _craft->getPilotList(false);
+
+	for (auto* pilot : pilots)
+	{
+		pilot->prepareStatsWithBonuses(_game->getMod()); // refresh soldier bonuses
+	}
+	_pilotAccuracyBonus = _craft->getPilotAccuracyBonus(pilots, _game->getMod());
+	_pilotDodgeBonus = _craft->getPilotDodgeBonus(pilots, _game->getMod());
+	_pilotApproachSpeedModifier = _craft->getPilotApproachSpeedModifier(pilots, _game->getMod());
+
+	_craftAccelerationBonus = 2; // vanilla
+	if (!pilots.empty())
+	{
+		_craftAccelerationBonus = std::min(4, (_craft->getCraftStats().accel / 3) + 1);
+	}
+
+	// HK options
+	if (_ufoIsAttacking)
+	{
+		if (_ufo->getCraftStats().speedMax >= _craft->getCraftStats().speedMax)
+		{
+			_disableDisengage = true;
+		}
+		if (_weaponNum == 0)
+		{
+			_disableCautious = true;
+		}
+		// make sure the HK attacks its primary target first!
+		{
+			Craft* target = dynamic_cast<Craft*>(_ufo->getDestination());
+			if (target)
+			{
+				if (_craft != target)
+				{
+					// push secondary targets a tiny bit away from the HK
+					_currentDist += 16;
+				}
+				else
+				{
+					// approach primary target at maximum approach speed
+					_pilotApproachSpeedModifier = 4;
+				}
+			}
+		}
+		setMode(DFM_AGGRESSIVE);
+	}
+
+	// don't set these variables if the ufo is already engaged in a dogfight
+	if (!_ufo->getEscapeCountdown())
+	{
+		_ufo->setFireCountdown(0);
+		int escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime()) - 30 * _game->getSavedGame()->getDifficultyCoefficient();
+		{
+			int diff = _game->getSavedGame()->getDifficulty();
+			auto& custom = _game->getMod()->getUfoEscapeCountdownCoefficients();
+			if (custom.size() > (size_t)diff)
+			{
+				escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime());
+				escapeCountdown = escapeCountdown * custom[diff] / 100;
+			}
+		}
+		_ufo->setEscapeCountdown(std::max(1, escapeCountdown));
+	}
+
+	for (int i = 0; i < _weaponNum; ++i)
+	{
+		if (_craft->getWeapons()->at(i))
+		{
+			if (!_ufoIsAttacking)
+			{
+				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getStandardReload();
+			}
+			else
+			{
+				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getAggressiveReload();
+			}
+		}
+	}
+
+	// Set UFO size - going to be moved to Ufo class to implement simultaneous dogfights.
+	std::string ufoSize = _ufo->getRules()->getSize();
+	if (ufoSize.compare("STR_VERY_SMALL") == 0)
+	{
+		_ufoSize = 0;
+	}
+	else if (ufoSize.compare("STR_SMALL") == 0)
+	{
+		_ufoSize = 1;
+	}
+	else if (ufoSize.compare("STR_MEDIUM_UC") == 0)
+	{
+		_ufoSize = 2;
+	}
+	else if (ufoSize.compare("STR_LARGE") == 0)
+	{
+		_ufoSize = 3;
+	}
+	else
+	{
+		_ufoSize = 4;
+	}
+
+	// Set this as the interception handling UFO shield recharge if no other is doing it
+	if (_ufo->getShieldRechargeHandle() == 0)
+	{
+		_ufo->setShieldRechargeHandle(_interceptionNumber);
+	}
+}
+
+/**
+ * Cleans up the dogfight simulation.
+ */
+DogfightSimulation::~DogfightSimulation()
+{
+	while (!_projectiles.empty())
+	{
+		delete _projectiles.back();
+		_projectiles.pop_back();
+	}
+}
+
+/**
+ * Attaches the view that shows the dogfight. Without one the
+ * dogfight keeps running, just nothing gets drawn.
+ * @param view Pointer to the view, or null to detach it.
+ */
+void DogfightSimulation::setView(DogfightView *view)
+{
+	_view = view;
+}
+
+/**
+ * Runs one step of the dogfight and ends it
+ * if the craft stopped chasing the UFO.
+ */
+void DogfightSimulation::think()
+{
+	if (!_endDogfight)
+	{
+		update();
+	}
+	if (!_ufoIsAttacking || _ufo->getStatus() == Ufo::LANDED)
+	{
+		if (!_craft->isInDogfight() || _craft->getDestination() != _ufo || _ufo->getStatus() == Ufo::LANDED)
+		{
+			endDogfight();
+		}
+	}
+}
+
+/**
+ * Clears the status message after a while and
+ * advances the UFO hit and crash animations.
+ */
+void DogfightSimulation::animate()
+{
+	// Clears text after a while
+	if (_timeout == 0)
+	{
+		if (!_status.empty())
+		{
+			_status.clear();
+			if (_view)
+			{
+				_view->statusChanged(_status);
+			}
+		}
+	}
+	else
+	{
+		_timeout--;
+	}
+
+	// Animate UFO hit.
+	bool lastHitAnimFrame = false;
+	if (_animatingHit && _ufo->getHitFrame() > 0)
+	{
+		_ufo->setHitFrame(_ufo->getHitFrame() - 1);
+		if (_ufo->getHitFrame() == 0)
+		{
+			_animatingHit = false;
+			lastHitAnimFrame = true;
+		}
+	}
+
+	// Animate UFO crash landing.
+	if (_ufo->isCrashed() && _ufo->getHitFrame() == 0 && !lastHitAnimFrame)
+	{
+		--_ufoSize;
+	}
+}
+
+/**
+ * Updates all the elements in the dogfight, including ufo movement,
+ * weapons fire, projectile movement, ufo escape conditions,
+ * craft and ufo destruction conditions, and retaliation mission generation, as applicable.
+ */
+void DogfightSimulation::update()
+{
+	bool finalRun = false;
+	// Check if craft is not low on fuel when window minimized, and
+	// Check if crafts destination hasn't been changed when window minimized.
+	if (!_ufoIsAttacking)
+	{
+		Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
+		if (u != _ufo || !_craft->isInDogfight() || _craft->getLowFuel() || (_minimized && _ufo->isCrashed()))
+		{
+			endDogfight();
+			return;
+		}
+	}
+
+	if (!_minimized)
+	{
+		if (_view)
+		{
+			_view->drawFrame();
+		}
+		animate();
+		if (!_ufo->isCrashed() && !_ufo->isDestroyed() && !_craft->isDestroyed() && !_ufo->getInterceptionProcessed())
+		{
+			_ufo->setInterceptionProcessed(true);
+			int escapeCounter = _ufo->getEscapeCountdown();
+			if (_ufoIsAttacking)
+			{
+				if (_disableDisengage && _ufo->getSoftlockShotCounter() >= _ufo->getRules()->getSoftlockThreshold())
+				{
+					escapeCounter = 1; // game is in softlock, stop being a hunter-killer and disengage!
+				}
+				else if (_ufo->getDamage() > _ufo->getCraftStats().damageMax / 3 && _ufo->getHuntBehavior() != 1)
+				{
+					// TODO: rethink: unhardcode run away thresholds?
+					if (_craft->getDamage() > _craft->getDamageMax() / 2)
+					{
+						escapeCounter = 999; // it's gonna be tight, continue shooting...
+					}
+					else
+					{
+						escapeCounter = 1; // we're badly hurt and xcom isn't, abort immediately!
+					}
+				}
+				else
+				{
+					escapeCounter = 999; // we're still ok, continue shooting...
+				}
+			}
+			else if (Options::dogfightAI)
+			{
+				int maxRange = 0;
+				for (CraftWeapon *wpn : *(_craft->getWeapons()))
+				{
+					if (wpn == NULL)
+						continue;
+					if (wpn->getAmmo() == 0)
+						continue;
+					if (wpn->getRules()->getRange() > maxRange)
+						maxRange = wpn->getRules()->getRange();
+				}
+				int speedMinusTractors = std::max(0, _ufo->getCraftStats().speedMax - _ufo->getTractorBeamSlowdown());
+				if (speedMinusTractors > _craft->getCraftStats().speedMax && _currentDist <= maxRange * 8)
+				{
+					if (_targetDist > _ufo->getRules()->getWeaponRange() * 8)
+					{
+						_targetDist = _ufo->getRules()->getWeaponRange() * 8;
+						setStatus("STR_CANT_KEEP_DISTANCE");
+					}
+				}
+			}
+
+			if (escapeCounter > 0)
+			{
+				escapeCounter--;
+				_ufo->setEscapeCountdown(escapeCounter);
+				// Check if UFO is breaking off.
+				if (escapeCounter == 0)
+				{
+					_ufo->setSpeed(_ufo->getCraftStats().speedMax);
+					if (_ufoIsAttacking && _ufo->isHunterKiller())
+					{
+						// stop being a hunter-killer and run away!
+						_ufo->resetOriginalDestination(_craft);
+						_ufo->setHunterKiller(false);
+					}
+				}
+			}
+			if (_ufo->getFireCountdown() > 0)
+			{
+				_ufo->setFireCountdown(_ufo->getFireCountdown() - 1);
+			}
+		}
+	}
+	// Crappy craft is chasing UFO.
+	int speedMinusTractors = std::max(0, _ufo->getSpeed() - _ufo->getTractorBeamSlowdown());
+	if (speedMinusTractors > _craft->getCraftStats().speedMax)
+	{
+		if (!_ufoIsAttacking || !_ufo->isHunterKiller())
+		{
+			_ufoBreakingOff = true;
+			finalRun = true;
+			setStatus("STR_UFO_OUTRUNNING_INTERCEPTOR");
+		}
+	}
+	else
+	{
+		_ufoBreakingOff = false;
+	}
+
+	bool projectileInFlight = false;
+	if (!_minimized)
+	{
+		int distanceChange = 0;
+
+		// Update distance
+		if (!_ufoBreakingOff)
+		{
+			if (_currentDist < _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
+			{
+				distanceChange = 2 * _craftAccelerationBonus; // disengage speed
+				if (_currentDist + distanceChange >_targetDist)
+				{
+					distanceChange = _targetDist - _currentDist;
+				}
+			}
+			else if (_currentDist > _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
+			{
+				distanceChange = -1 * _pilotApproachSpeedModifier; // engage speed
+			}
+
+			// don't let the interceptor mystically push or pull its fired projectiles
+			for (auto* cwp : _projectiles)
+			{
+				if (cwp->getGlobalType() != CWPGT_BEAM && cwp->getDirection() == D_UP)
+				{
+					cwp->setPosition(cwp->getPosition() + distanceChange);
+				}
+			}
+		}
+		else
+		{
+			distanceChange = 4; // ufo breaking off speed
+
+			// UFOs can try to outrun our missiles, don't adjust projectile positions here
+			// If UFOs ever fire anything but beams, those positions need to be adjust here though.
+		}
+
+		_currentDist += distanceChange;
+
+		if (_view)
+		{
+			_view->distanceChanged(_currentDist);
+		}
+
+		// Check and recharge craft shields
+		// Check if the UFO's shields are being handled by an interception window
+		if (_ufo->getShieldRechargeHandle() == 0)
+		{
+			_ufo->setShieldRechargeHandle(_interceptionNumber);
+		}
+
+		// UFO shields
+		if ((_ufo->getShield() != 0) && (_interceptionNumber == _ufo->getShieldRechargeHandle()))
+		{
+			int total = _ufo->getCraftStats().shieldRecharge / 100;
+			if (RNG::percent(_ufo->getCraftStats().shieldRecharge % 100))
+				total++;
+			_ufo->setShield(_ufo->getShield() + total);
+		}
+
+		// Player craft shields
+		if (_craft->getShield() != 0)
+		{
+			int total = _craft->getCraftStats().shieldRecharge / 100;
+			if (RNG::percent(_craft->getCraftStats().shieldRecharge % 100))
+				total++;
+			if (total != 0)
+			{
+				_craft->setShield(_craft->getShield() + total);
+				if (_view)
+				{
+					_view->craftShieldChanged();
+				}
+			}
+		}
+
+		// Move projectiles and check for hits.
+		for (auto* p : _projectiles)
+		{
+			p->move();
+			// Projectiles fired by interceptor.
+			if (p->getDirection() == D_UP)
+			{
+				// Projectile reached the UFO - determine if it's been hit.
+				if (((p->getPosition() >= _currentDist) || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved())) && !_ufo->isCrashed() && !p->getMissed())
+				{
+					// UFO hit.
+					int chanceToHit = (p->getAccuracy() * (100 + 300 / (5 - _ufoSize)) + 100) / 200; // vanilla xcom
+					chanceToHit -= _ufo->getCraftStats().avoidBonus;
+					chanceToHit += _craft->getCraftStats().hitBonus;
+					chanceToHit += _pilotAccuracyBonus;
+					if (RNG::percent(chanceToHit))
+					{
+						// Formula delivered by Volutar, altered by Extended version.
+						int power = p->getDamage() * (_craft->getCraftStats().powerBonus + 100) / 100;
+
+						// Handle UFO shields
+						int damage = RNG::generate(power / 2, power);
+						int shieldDamage = 0;
+						if (_ufo->getShield() != 0)
+						{
+							shieldDamage = damage * p->getShieldDamageModifier() / 100;
+							if (p->getShieldDamageModifier() == 0)
+							{
+								damage = 0;
+							}
+							else
+							{
+								// scale down by bleed-through factor and scale up by shield-effectiveness factor
+								damage = std::max(0, shieldDamage - _ufo->getShield()) * _ufo->getCraftStats().shieldBleedThrough / p->getShieldDamageModifier();
+							}
+							_ufo->setShield(_ufo->getShield() - shieldDamage);
+						}
+
+						damage = std::max(0, damage - _ufo->getCraftStats().armor);
+						_ufo->setDamage(_ufo->getDamage() + damage, _game->getMod());
+						_state->handleDogfightExperience(); // called after setDamage
+						if (_ufo->isCrashed())
+						{
+							_ufo->setShotDownByCraftId(_craft->getUniqueId());
+							_ufo->setSpeed(0);
+							_ufo->setDestination(0);
+							// if the ufo got destroyed here, these no longer apply
+							_ufoBreakingOff = false;
+							finalRun = false;
+							_end = false;
+						}
+						if (_ufo->getHitFrame() == 0)
+						{
+							_animatingHit = true;
+							_ufo->setHitFrame(3);
+						}
+
+						// How hard was the ufo hit?
+						if (_ufo->getShield() != 0)
+						{
+							setStatus("STR_UFO_SHIELD_HIT");
+						}
+						else
+						{
+							if (damage == 0)
+							{
+								if (shieldDamage == 0)
+								{
+									setStatus("STR_UFO_HIT_NO_DAMAGE");
+								}
+								else
+								{
+									setStatus("STR_UFO_SHIELD_DOWN");
+								}
+							}
+							else
+							{
+								if (damage < _ufo->getCraftStats().damageMax / 2 * _game->getMod()->getUfoGlancingHitThreshold() / 100)
+								{
+									setStatus("STR_UFO_HIT_GLANCING");
+								}
+								else
+								{
+									setStatus("STR_UFO_HIT");
+								}
+							}
+						}
+
+						_game->getMod()->getSound("GEO.CAT", Mod::UFO_HIT)->play();
+						p->remove();
+					}
+					// Missed.
+					else
+					{
+						if (p->getGlobalType() == CWPGT_BEAM)
+						{
+							p->remove();
+						}
+						else
+						{
+							p->setMissed(true);
+						}
+					}
+				}
+				// Check if projectile passed it's maximum range.
+				if (p->getGlobalType() == CWPGT_MISSILE && p->getPosition() / 8 >= p->getRange())
+				{
+					p->remove();
+				}
+				else if (!_ufo->isCrashed())
+				{
+					projectileInFlight = true;
+				}
+			}
+			// Projectiles fired by UFO.
+			else if (p->getDirection() == D_DOWN)
+			{
+				if (p->getGlobalType() == CWPGT_MISSILE || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved()))
+				{
+					int chancetoHit = p->getAccuracy(); // vanilla xcom
+					chancetoHit -= _craft->getCraftStats().avoidBonus;
+					chancetoHit += _ufo->getCraftStats().hitBonus;
+					chancetoHit -= _pilotDodgeBonus;
+					// evasive maneuvers
+					if (_ufoIsAttacking && _mode == DFM_CAUTIOUS)
+					{
+						// HK's chance to hit is halved, but craft's reload time is doubled too
+						chancetoHit = chancetoHit / 2;
+					}
+					if (RNG::percent(chancetoHit) || _selfDestructPressed)
+					{
+						// Formula delivered by Volutar, altered by Extended version.
+						int power = p->getDamage() * (_ufo->getCraftStats().powerBonus + 100) / 100;
+						int damage = RNG::generate(0, power);
+
+						if (_craft->getShield() != 0)
+						{
+							int shieldBleedThroughDamage = std::max(0, damage - _craft->getShield()) * _craft->getCraftStats().shieldBleedThrough / 100;
+							_craft->setShield(_craft->getShield() - damage);
+							damage = shieldBleedThroughDamage;
+							if (_view)
+							{
+								_view->craftShieldChanged();
+							}
+							setStatus("STR_INTERCEPTOR_SHIELD_HIT");
+						}
+
+						damage = std::max(0, damage - _craft->getCraftStats().armor);
+
+						// if a totally crappy HK is attacking a completely defenseless craft, avoid endless fight
+						if (_selfDestructPressed)
+						{
+							damage = _craft->getCraftStats().damageMax;
+						}
+
+						if (damage)
+						{
+							_craft->setDamage(_craft->getDamage() + damage);
+							if (_view)
+							{
+								_view->craftDamaged();
+							}
+							setStatus("STR_INTERCEPTOR_DAMAGED");
+							_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_HIT)->play(); //10
+							if (_mode == DFM_CAUTIOUS && _craft->getDamagePercentage() >= 50 && !_ufoIsAttacking)
+							{
+								_targetDist = STANDOFF_DIST;
+							}
+						}
+					}
+					p->remove();
+				}
+			}
+		}
+
+		// Remove projectiles that hit or missed their target.
+		Collections::deleteIf(_projectiles, _projectiles.size(),
+			[&](CraftWeaponProjectile* cwp)
+			{
+				return cwp->toBeRemoved() == true || (cwp->getMissed() == true && cwp->getPosition() <= 0);
+			}
+		);
+
+		// Check if the situation is hopeless for the craft
+		if (_disableDisengage && !_craftIsDefenseless)
+		{
+			if (_projectiles.empty())
+			{
+				bool hasNoAmmo = true;
+				for (auto cw : *_craft->getWeapons())
+				{
+					if (cw && cw->getAmmo() > 0)
+					{
+						hasNoAmmo = false;
+						break;
+					}
+				}
+				// no projectiles in the air and no ammo left
+				if (hasNoAmmo)
+				{
+					_craftIsDefenseless = true;
+					if (_view)
+					{
+						_view->craftDefenseless();
+					}
+				}
+			}
+		}
+
+		// Handle weapons and craft distance.
+		for (int i = 0; i < _weaponNum; ++i)
+		{
+			CraftWeapon *w = _craft->getWeapons()->at(i);
+			if (w == 0)
+			{
+				continue;
+			}
+			int wTimer = _weaponFireCountdown[i];
+
+			// Handle weapon firing
+			if (wTimer == 0 && _currentDist <= w->getRules()->getRange() * 8 && w->getAmmo() > 0 && _mode != DFM_STANDOFF
+				&& _mode != DFM_DISENGAGE && !_ufo->isCrashed() && !_craft->isDestroyed())
+			{
+				if (_weaponEnabled[i])
+				{
+					fireWeapon(i);
+					projectileInFlight = true;
+				}
+			}
+			else if (wTimer > 0)
+			{
+				--_weaponFireCountdown[i];
+			}
+
+			// Handle craft tractor beams
+			if (w->getRules()->getTractorBeamPower() != 0)
+			{
+				if (_currentDist <= w->getRules()->getRange() * 8 && _mode != DFM_STANDOFF
+					&& _mode != DFM_DISENGAGE && !_ufo->isCrashed() && !_craft->isDestroyed()
+					&& _weaponEnabled[i])
+				{
+					if (!_tractorLockedOn[i])
+					{
+						_tractorLockedOn[i] = true;
+						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
+						tractorBeamSlowdown += w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
+						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
+						setStatus("STR_TRACTOR_BEAM_ENGAGED");
+					}
+				}
+				else
+				{
+					if (_tractorLockedOn[i])
+					{
+						_tractorLockedOn[i] = false;
+						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
+						tractorBeamSlowdown -= w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
+						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
+						setStatus("STR_TRACTOR_BEAM_DISENGAGED");
+					}
+				}
+			}
+
+			if (w->getAmmo() == 0 && !projectileInFlight && !_craft->isDestroyed())
+			{
+				// Handle craft distance according to option set by user and available ammo.
+				if (_mode == DFM_CAUTIOUS && !_ufoIsAttacking)
+				{
+					minimumDistance();
+				}
+				else if (_mode == DFM_STANDARD)
+				{
+					maximumDistance();
+				}
+			}
+		}
+
+		// Handle UFO firing.
+		if (_currentDist <= _ufo->getRules()->getWeaponRange() * 8 && !_ufo->isCrashed() && !_craft->isDestroyed())
+		{
+			if (_ufo->getShootingAt() == 0)
+			{
+				_ufo->setShootingAt(_interceptionNumber);
+			}
+			if (_ufo->getShootingAt() == _interceptionNumber)
+			{
+				if (_ufo->getFireCountdown() == 0)
+				{
+					ufoFireWeapon();
+				}
+			}
+		}
+		else if (_ufo->getShootingAt() == _interceptionNumber)
+		{
+			_ufo->setShootingAt(0);
+		}
+	}
+
+	// Check when battle is over.
+	if (_end == true && (((_currentDist > 640 || _minimized) && (_mode == DFM_DISENGAGE || _ufoBreakingOff == true)) || (_timeout == 0 && (_ufo->isCrashed() || _craft->isDestroyed()))))
+	{
+		if (_ufoBreakingOff)
+		{
+			_ufo->move();
+			// TODO: rethink: give hunter-killers opportunity to escape?
+			if (!_ufoIsAttacking)
+			{
+				_craft->setDestination(_ufo);
+			}
+		}
+		if (!_destroyCraft && (_destroyUfo || _mode == DFM_DISENGAGE))
+		{
+			// keep original target if attacked by a HK (and didn't disengage manually)
+			bool keepOriginalTarget = _ufoIsAttacking && _craft->getDestination() != _ufo;
+			if (!keepOriginalTarget || _mode == DFM_DISENGAGE)
+			{
+				_craft->returnToBase();
+			}
+
+			// Need to give the craft at least one step advantage over the hunter-killer (to be able to escape)
+			if (_ufoIsAttacking)
+			{
+				bool returnedToBase = _craft->think();
+				if (returnedToBase)
+				{
+					_game->getSavedGame()->stopHuntingXcomCraft(_craft); // hiding in the base is good enough, obviously
+				}
+			}
+		}
+		if (_ufo->isCrashed())
+		{
+			for (auto* follower : _ufo->getCraftFollowers())
+			{
+				if (follower->getNumTotalUnits() == 0 || !follower->getRules()->getAllowLanding())
+				{
+					follower->returnToBase();
+				}
+			}
+		}
+		endDogfight();
+	}
+
+	if (_currentDist > 640 && _ufoBreakingOff)
+	{
+		finalRun = true;
+	}
+
+	if (!_end)
+	{
+		if (_endCraftHandled)
+		{
+			finalRun = true;
+		}
+		else if (_craft->isDestroyed())
+		{
+			// End dogfight if craft is destroyed.
+			setStatus("STR_INTERCEPTOR_DESTROYED");
+			if (_ufoIsAttacking)
+			{
+				_craft->evacuateCrew(_game->getMod());
+			}
+			_timeout += 30;
+			_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_EXPLODE)->play();
+			finalRun = true;
+			_destroyCraft = true;
+			_endCraftHandled = true;
+			_ufo->setShootingAt(0);
+		}
+
+		if (_endUfoHandled)
+		{
+			finalRun = true;
+		}
+		else if (_ufo->isCrashed())
+		{
+			// End dogfight if UFO is crashed or destroyed.
+			_endUfoHandled = true;
+
+			if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+			{
+				AlienRace *race = _game->getMod()->getAlienRace(_ufo->getAlienRace());
+				AlienMission *mission = _ufo->getMission();
+				mission->ufoShotDown(*_ufo);
+				// Check for retaliation trigger.
+				int retaliationOdds = mission->getRules().getRetaliationOdds();
+				if (retaliationOdds == -1)
+				{
+					retaliationOdds = 100 - (4 * (24 - _game->getSavedGame()->getDifficultyCoefficient()) - race->getRetaliationAggression());
+					{
+						int diff = _game->getSavedGame()->getDifficulty();
+						auto& custom = _game->getMod()->getRetaliationTriggerOdds();
+						if (custom.size() > (size_t)diff)
+						{
+							retaliationOdds = custom[diff] + race->getRetaliationAggression();
+						}
+					}
+				}
+				// Have mercy on beginners
+				if (_game->getSavedGame()->getMonthsPassed() < Mod::DIFFICULTY_BASED_RETAL_DELAY[_game->getSavedGame()->getDifficulty()])
+				{
+					retaliationOdds = 0;
+				}
+
+				if (RNG::percent(retaliationOdds))
+				{
+					// Spawn retaliation mission.
+					std::string targetRegion;
+					int retaliationUfoMissionRegionOdds = 50 - 6 * _game->getSavedGame()->getDifficultyCoefficient();
+					{
+						int diff = _game->getSavedGame()->getDifficulty();
+						auto& custom = _game->getMod()->getRetaliationBaseRegionOdds();
+						if (custom.size() > (size_t)diff)
+						{
+							retaliationUfoMissionRegionOdds = 100 - custom[diff];
+						}
+					}
+					if (RNG::percent(retaliationUfoMissionRegionOdds))
+					{
+						// Attack on UFO's mission region
+						targetRegion = _ufo->getMission()->getRegion();
+					}
+					else
+					{
+						// Try to find and attack the originating base.
+						targetRegion = _game->getSavedGame()->locateRegion(*_craft->getBase())->getRules()->getType();
+						// TODO: If the base is removed, the mission is canceled.
+					}
+					// Difference from original: No retaliation until final UFO lands (Original: Is spawned).
+					if (!_game->getSavedGame()->findAlienMission(targetRegion, OBJECTIVE_RETALIATION, race))
+					{
+						auto* retalWeights = race->retaliationMissionWeights(_game->getSavedGame()->getMonthsPassed());
+						std::string retalMission = retalWeights ? retalWeights->choose() : "";
+						const RuleAlienMission *rule = _game->getMod()->getAlienMission(retalMission, false);
+						if (!rule)
+						{
+							rule = _game->getMod()->getRandomMission(OBJECTIVE_RETALIATION, _game->getSavedGame()->getMonthsPassed());
+						}
+
+						if (rule)
+						{
+							AlienMission *newMission = new AlienMission(*rule);
+							newMission->setId(_game->getSavedGame()->getId("ALIEN_MISSIONS"));
+							newMission->setRegion(targetRegion, *_game->getMod());
+							newMission->setRace(_ufo->getAlienRace());
+							newMission->start(*_game, *_state->getGlobe(), newMission->getRules().getWave(0).spawnTimer); // fixed delay for first scout
+							_game->getSavedGame()->getAlienMissions().push_back(newMission);
+						}
+					}
+				}
+			}
+
+			if (_ufo->isDestroyed())
+			{
+				if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+				{
+					for (auto* country : *_game->getSavedGame()->getCountries())
+					{
+						if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
+						{
+							country->addActivityXcom(_ufo->getRules()->getScore()*2);
+							break;
+						}
+					}
+					for (auto* region : *_game->getSavedGame()->getRegions())
+					{
+						if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
+						{
+							region->addActivityXcom(_ufo->getRules()->getScore()*2);
+							break;
+						}
+					}
+					setStatus("STR_UFO_DESTROYED");
+					_game->getMod()->getSound("GEO.CAT", Mod::UFO_EXPLODE)->play(); //11
+				}
+				_destroyUfo = true;
+			}
+			else
+			{
+				if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
+				{
+					setStatus("STR_UFO_CRASH_LANDS");
+					_game->getMod()->getSound("GEO.CAT", Mod::UFO_CRASH)->play(); //10
+					for (auto* country : *_game->getSavedGame()->getCountries())
+					{
+						if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
+						{
+							country->addActivityXcom(_ufo->getRules()->getScore());
+							break;
+						}
+					}
+					for (auto* region : *_game->getSavedGame()->getRegions())
+					{
+						if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
+						{
+							region->addActivityXcom(_ufo->getRules()->getScore());
+							break;
+						}
+					}
+				}
+				bool survived = true;
+				bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
+				if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
+				{
+					survived = false; // destroyed on real water
+				}
+				else if (fakeUnderwaterTexture)
+				{
+					if (RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
+					{
+						setStatus("STR_UFO_SURVIVED_SPLASHDOWN");
+					}
+					else
+					{
+						survived = false; // destroyed on fake water
+						setStatus("STR_UFO_DESTROYED_BY_SPLASHDOWN");
+					}
+				}
+				if (!survived)
+				{
+					_ufo->setStatus(Ufo::DESTROYED);
+					_destroyUfo = true;
+				}
+				else
+				{
+					_ufo->setSecondsRemaining(RNG::generate(24, 96)*3600);
+					_ufo->setAltitude("STR_GROUND");
+					if (_ufo->getCrashId() == 0)
+					{
+						_ufo->setCrashId(_game->getSavedGame()->getId("STR_CRASH_SITE"));
+						if (_ufo->isHunterKiller())
+						{
+							// stop being a hunter-killer
+							_ufo->resetOriginalDestination(_craft);
+							_ufo->setHunterKiller(false);
+						}
+					}
+				}
+			}
+			_timeout += 30;
+			if (_ufo->getShotDownByCraftId() != _craft->getUniqueId())
+			{
+				_timeout += 50;
+				_ufo->setHitFrame(3);
+			}
+			finalRun = true;
+
+			if (_ufo->getStatus() == Ufo::LANDED)
+			{
+				_timeout += 30;
+				finalRun = true;
+				_ufo->setShootingAt(0);
+			}
+		}
+		else if (_ufo->getCraftStats().speedMax - _ufo->getTractorBeamSlowdown() == 0) // UFO brought down by tractor beam
+		{
+			_endUfoHandled = true;
+
+			bool survived = true;
+			if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
+			{
+				survived = false; // destroyed on real water
+			}
+			else
+			{
+				bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
+				if (fakeUnderwaterTexture && !RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
+				{
+					survived = false; // destroyed on fake water
+				}
+			}
+			if (_ufo->getRules()->isUnmanned())
+			{
+				survived = false; // unmanned UFOs (drones, missiles, etc.) can't be forced to land
+			}
+			if (!survived) // Brought it down over water (and didn't survive splashdown)
+			{
+				finalRun = true;
+				_ufo->setDamage(_ufo->getCraftStats().damageMax, _game->getMod());
+				_state->handleDogfightExperience(); // called after setDamage
+				_ufo->setShotDownByCraftId(_craft->getUniqueId());
+				_ufo->setSpeed(0);
+				_ufo->setStatus(Ufo::DESTROYED);
+				_destroyUfo = true;
+				for (auto* country : *_game->getSavedGame()->getCountries())
+				{
+					if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
+					{
+						country->addActivityXcom(_ufo->getRules()->getScore());
+						break;
+					}
+				}
+				for (auto* region : *_game->getSavedGame()->getRegions())
+				{
+					if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
+					{
+						region->addActivityXcom(_ufo->getRules()->getScore());
+						break;
+					}
+				}
+			}
+			else // Brought it down over land (or survived splashdown)
+			{
+				finalRun = true;
+				_ufo->setSecondsRemaining(RNG::generate(30, 120)*60);
+				_ufo->setShootingAt(0);
+				_ufo->setStatus(Ufo::LANDED);
+				_ufo->setAltitude("STR_GROUND");
+				_ufo->setSpeed(0);
+				_ufo->setTractorBeamSlowdown(0);
+				if (_ufo->getLandId() == 0)
+				{
+					_ufo->setLandId(_game->getSavedGame()->getId("STR_LANDING_SITE"));
+				}
+			}
+		}
+	}
+
+	if (!projectileInFlight && finalRun)
+	{
+		_end = true;
+	}
+}
+
+/**
+ * Fires a shot from the first weapon
+ * equipped on the craft.
+ */
+void DogfightSimulation::fireWeapon(int i)
+{
+	CraftWeapon *w1 = _craft->getWeapons()->at(i);
+	if (w1->setAmmo(w1->getAmmo() - 1))
+	{
+		_weaponFireCountdown[i] = _weaponFireInterval[i];
+
+		if (_view)
+		{
+			_view->ammoChanged(i, w1->getAmmo());
+		}
+
+		CraftWeaponProjectile *p = w1->fire();
+		p->setDirection(D_UP);
+		p->setHorizontalPosition((i % 2 ? HP_RIGHT : HP_LEFT) * (1 + 2 * (i / 2)));
+		_projectiles.push_back(p);
+
+		_game->getMod()->getSound("GEO.CAT", w1->getRules()->getSound())->play();
+		_firedAtLeastOnce = true;
+	}
+}
+
+/**
+ *	Each time a UFO will try to fire it's cannons
+ *	a calculation is made. There's only 10% chance
+ *	that it will actually fire.
+ */
+void DogfightSimulation::ufoFireWeapon()
+{
+	int fireCountdown = std::max(1, (_ufo->getRules()->getWeaponReload() - 2 * _game->getSavedGame()->getDifficultyCoefficient()));
+	{
+		int diff = _game->getSavedGame()->getDifficulty();
+		auto& custom = _game->getMod()->getUfoFiringRateCoefficients();
+		if (custom.size() > (size_t)diff)
+		{
+			fireCountdown = std::max(1, _ufo->getRules()->getWeaponReload() * custom[diff] / 100);
+		}
+	}
+	_ufo->setFireCountdown(RNG::generate(0, fireCountdown) + fireCountdown);
+
+	setStatus("STR_UFO_RETURN_FIRE");
+	CraftWeaponProjectile *p = new CraftWeaponProjectile();
+	p->setType(CWPT_PLASMA_BEAM);
+	p->setAccuracy(60);
+	p->setDamage(_ufo->getRules()->getWeaponPower());
+	p->setDirection(D_DOWN);
+	p->setHorizontalPosition(HP_CENTER);
+	p->setPosition(_currentDist - (_ufo->getRules()->getRadius() / 2));
+	_projectiles.push_back(p);
+	if (_ufoIsAttacking && _disableDisengage)
+	{
+		_ufo->increaseSoftlockShotCounter();
+	}
+
+	if (_ufo->getRules()->getFireSound() == -1)
+	{
+		_game->getMod()->getSound("GEO.CAT", Mod::UFO_FIRE)->play();
+	}
+	else
+	{
+		_game->getMod()->getSound("GEO.CAT", _ufo->getRules()->getFireSound())->play();
+	}
+}
+
+/**
+ * Sets the craft to the minimum distance
+ * required to fire a weapon.
+ */
+void DogfightSimulation::minimumDistance()
+{
+	int max = 0;
+	for (auto* cw : *_craft->getWeapons())
+	{
+		if (cw == 0)
+			continue;
+		if (cw->getRules()->getRange() > max && cw->getAmmo() > 0)
+		{
+			max = cw->getRules()->getRange();
+		}
+	}
+	if (max == 0)
+	{
+		_targetDist = STANDOFF_DIST;
+	}
+	else
+	{
+		_targetDist = max * 8;
+	}
+}
+
+/**
+ * Sets the craft to the maximum distance
+ * required to fire a weapon.
+ */
+void DogfightSimulation::maximumDistance()
+{
+	int min = 1000;
+	for (auto* cw : *_craft->getWeapons())
+	{
+		if (cw == 0)
+			continue;
+		if (cw->getRules()->getRange() < min && cw->getAmmo() > 0)
+		{
+			min = cw->getRules()->getRange();
+		}
+	}
+	if (_ufoIsAttacking)
+	{
+		// If the UFO is actively hunting us, consider its weapon range too
+		if (_ufo->getRules()->getWeaponRange() > 0 && _ufo->getRules()->getWeaponRange() < min)
+		{
+			min = _ufo->getRules()->getWeaponRange();
+		}
+	}
+	if (min == 1000)
+	{
+		_targetDist = STANDOFF_DIST;
+	}
+	else
+	{
+		_targetDist = min * 8;
+	}
+}
+
+/**
+ * Sets the craft to the distance relevant for aggressive attack.
+ */
+void DogfightSimulation::aggressiveDistance()
+{
+	maximumDistance();
+	if (_targetDist > AGGRESSIVE_DIST)
+	{
+		_targetDist = AGGRESSIVE_DIST;
+	}
+}
+
+/**
+ * Updates the status message and restarts
+ * the message timeout counter.
+ * @param status New status string ID.
+ */
+void DogfightSimulation::setStatus(const std::string &status)
+{
+	_status = status;
+	_timeout = 50;
+	if (_view)
+	{
+		_view->statusChanged(_status);
+	}
+}
+
+/**
+ * Gets the status message, empty once it timed out.
+ * @return Status string ID.
+ */
+const std::string &DogfightSimulation::getStatus() const
+{
+	return _status;
+}
+
+/**
+ * Changes the attack mode. The mode always changes,
+ * but the craft only acts on it while it can still fight.
+ * @param mode New attack mode.
+ */
+void DogfightSimulation::setMode(DogfightMode mode)
+{
+	_mode = mode;
+	if (!canChangeMode())
+	{
+		return;
+	}
+	switch (mode)
+	{
+	case DFM_STANDOFF:
+		_end = false;
+		setStatus("STR_STANDOFF");
+		_targetDist = STANDOFF_DIST;
+		break;
+	case DFM_CAUTIOUS:
+		_end = false;
+		if (!_ufoIsAttacking)
+		{
+			setStatus("STR_CAUTIOUS_ATTACK");
+			for (int i = 0; i < _weaponNum; ++i)
+			{
+				CraftWeapon* w = _craft->getWeapons()->at(i);
+				if (w != 0)
+				{
+					_weaponFireInterval[i] = w->getRules()->getCautiousReload();
+				}
+			}
+			minimumDistance();
+		}
+		else
+		{
+			setStatus("STR_EVASIVE_MANEUVERS");
+			for (int i = 0; i < _weaponNum; ++i)
+			{
+				CraftWeapon* w = _craft->getWeapons()->at(i);
+				if (w != 0)
+				{
+					// double the craft's reload time to balance halving the HK's chance to hit
+					_weaponFireInterval[i] = w->getRules()->getAggressiveReload() * 2;
+				}
+			}
+			// same distance as aggressive (by design)
+			aggressiveDistance();
+		}
+		break;
+	case DFM_STANDARD:
+		_end = false;
+		setStatus("STR_STANDARD_ATTACK");
+		for (int i = 0; i < _weaponNum; ++i)
+		{
+			CraftWeapon* w = _craft->getWeapons()->at(i);
+			if (w != 0)
+			{
+				_weaponFireInterval[i] = w->getRules()->getStandardReload();
+			}
+		}
+		maximumDistance();
+		break;
+	case DFM_AGGRESSIVE:
+		_end = false;
+		setStatus("STR_AGGRESSIVE_ATTACK");
+		for (int i = 0; i < _weaponNum; ++i)
+		{
+			CraftWeapon* w = _craft->getWeapons()->at(i);
+			if (w != 0)
+			{
+				_weaponFireInterval[i] = w->getRules()->getAggressiveReload();
+			}
+		}
+		aggressiveDistance();
+		break;
+	case DFM_DISENGAGE:
+		_end = true;
+		setStatus("STR_DISENGAGING");
+		_targetDist = 800;
+		break;
+	}
+}
+
+/**
+ * Gets the attack mode.
+ * @return Attack mode.
+ */
+DogfightMode DogfightSimulation::getMode() const
+{
+	return _mode;
+}
+
+/**
+ * Checks if the craft still takes orders, that is
+ * nobody got shot down and the UFO isn't getting away.
+ * @return True if the attack mode can be changed.
+ */
+bool DogfightSimulation::canChangeMode() const
+{
+	return !_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff;
+}
+
+/**
+ * Toggles the self-destruct of a craft that has nothing left to fight with.
+ */
+void DogfightSimulation::toggleSelfDestruct()
+{
+	_selfDestructPressed = !_selfDestructPressed;
+	if (_selfDestructPressed)
+		setStatus("STR_SELF_DESTRUCT_ACTIVATED");
+	else
+		setStatus("STR_SELF_DESTRUCT_CANCELLED");
+}
+
+/**
+ * Checks if the self-destruct is on.
+ * @return True if the craft will go down with the next UFO shot.
+ */
+bool DogfightSimulation::isSelfDestructPressed() const
+{
+	return _selfDestructPressed;
+}
+
+/**
+ * Checks if the craft has no ammo and no projectiles left.
+ * @return True if the craft is defenseless.
+ */
+bool DogfightSimulation::isCraftDefenseless() const
+{
+	return _craftIsDefenseless;
+}
+
+/**
+ * Checks if the craft is too slow to disengage from a hunter-killer.
+ * @return True if disengaging is disabled.
+ */
+bool DogfightSimulation::isDisengageDisabled() const
+{
+	return _disableDisengage;
+}
+
+/**
+ * Checks if the craft has no weapons to attack a hunter-killer cautiously.
+ * @return True if the cautious attack is disabled.
+ */
+bool DogfightSimulation::isCautiousDisabled() const
+{
+	return _disableCautious;
+}
+
+/**
+ * Returns true if this is a hunter-killer dogfight. Otherwise returns false.
+ * @return Is this a hunter-killer dogfight?
+ */
+bool DogfightSimulation::isUfoAttacking() const
+{
+	return _ufoIsAttacking;
+}
+
+/**
+ * Returns true if the dogfight is minimized. Minimized dogfights
+ * don't move or shoot, they only check if the dogfight is over.
+ * @return Is the dogfight minimized?
+ */
+bool DogfightSimulation::isMinimized() const
+{
+	return _minimized;
+}
+
+/**
+ * Sets the dogfight minimized or maximized.
+ * @param minimized Is the dogfight minimized?
+ */
+void DogfightSimulation::setMinimized(bool minimized)
+{
+	_minimized = minimized;
+}
+
+/**
+ * Gets the number of weapon slots in use.
+ * @return Number of weapons.
+ */
+int DogfightSimulation::getWeaponNum() const
+{
+	return _weaponNum;
+}
+
+/**
+ * Checks if a weapon is enabled.
+ * @param i Weapon slot.
+ * @return True if the weapon fires.
+ */
+bool DogfightSimulation::isWeaponEnabled(int i) const
+{
+	return _weaponEnabled[i];
+}
+
+/**
+ * Enables or disables a weapon.
+ * @param i Weapon slot.
+ * @param enabled Should the weapon fire?
+ */
+void DogfightSimulation::setWeaponEnabled(int i, bool enabled)
+{
+	_weaponEnabled[i] = enabled;
+}
+
+/**
+ * Gets the current distance between the craft and the UFO.
+ * @return Distance (8 per km).
+ */
+int DogfightSimulation::getCurrentDist() const
+{
+	return _currentDist;
+}
+
+/**
+ * Gets the UFO size shown on the radar. Goes below zero
+ * when a crashing UFO disappeared from the radar.
+ * @return UFO size.
+ */
+int DogfightSimulation::getUfoSize() const
+{
+	return _ufoSize;
+}
+
+/**
+ * Gets the projectiles in flight.
+ * @return List of projectiles.
+ */
+const std::vector<CraftWeaponProjectile*> &DogfightSimulation::getProjectiles() const
+{
+	return _projectiles;
+}
+
+/**
+ * Returns interception number.
+ * @return interception number
+ */
+int DogfightSimulation::getInterceptionNumber() const
+{
+	return _interceptionNumber;
+}
+
+/**
+ * Sets interception number.
+ * @param number ID number.
+ */
+void DogfightSimulation::setInterceptionNumber(int number)
+{
+	_interceptionNumber = number;
+}
+
+/**
+ * Checks whether the dogfight should end.
+ * @return Returns true if the dogfight should end, otherwise returns false.
+ */
+bool DogfightSimulation::dogfightEnded() const
+{
+	return _endDogfight;
+}
+
+/**
+ * Returns the UFO associated to this dogfight.
+ * @return Returns pointer to UFO object associated to this dogfight.
+ */
+Ufo *DogfightSimulation::getUfo() const
+{
+	return _ufo;
+}
+
+/**
+ * Returns the craft associated to this dogfight.
+ * @return Returns pointer to craft object associated to this dogfight.
+ */
+Craft *DogfightSimulation::getCraft() const
+{
+	return _craft;
+}
+
+/**
+ * Ends the dogfight.
+ */
+void DogfightSimulation::endDogfight()
+{
+	if (_endDogfight)
+		return;
+	if (_craft)
+	{
+		_craft->setInDogfight(false);
+		_craft->setInterceptionOrder(0);
+	}
+	// set the ufo as "free" for the next engagement (as applicable)
+	if (_ufo)
+	{
+		_ufo->setInterceptionProcessed(false);
+		_ufo->setShieldRechargeHandle(0);
+	}
+	_endDogfight = true;
+}
+
+/**
+ * Awards experience to the pilots once the UFO went down.
+ */
+void DogfightSimulation::awardExperienceToPilots()
+{
+	if (_firedAtLeastOnce && !_experienceAwarded && _craft && _ufo && (_ufo->isCrashed() || _ufo->isDestroyed()))
+	{
+		bool psiStrengthEval = (Options::psiStrengthEval && _game->getSavedGame()->isResearched(_game->getMod()->getPsiRequirements()));
+		for (auto* pilot : _craft->getPilotList(false))
+		{
+			if (pilot->getCurrentStats()->firing < pilot->getRules()->getStatCaps().firing)
+			{
+				if (RNG::percent(pilot->getRules()->getDogfightExperience().firing))
+				{
+					pilot->getCurrentStatsEditable()->firing++;
+					pilot->getDailyDogfightExperienceCache()->firing++;
+				}
+			}
+			if (pilot->getCurrentStats()->reactions < pilot->getRules()->getStatCaps().reactions)
+			{
+				if (RNG::percent(pilot->getRules()->getDogfightExperience().reactions))
+				{
+					pilot->getCurrentStatsEditable()->reactions++;
+					pilot->getDailyDogfightExperienceCache()->reactions++;
+				}
+			}
+			if (pilot->getCurrentStats()->bravery < pilot->getRules()->getStatCaps().bravery)
+			{
+				if (RNG::percent(pilot->getRules()->getDogfightExperience().bravery))
+				{
+					pilot->getCurrentStatsEditable()->bravery += 10; // increase by 10 to keep OCD at bay
+					pilot->getDailyDogfightExperienceCache()->bravery += 10;
+				}
+			}
+			pilot->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
+		}
+		_experienceAwarded = true;
+	}
+}
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../Mod/RuleCraft.h"
+#include <vector>
+#include <string>
+
+namespace OpenXcom
+{
+
+const int STANDOFF_DIST = 560;
+const int AGGRESSIVE_DIST = 64;
+enum DogfightMode { DFM_STANDOFF, DFM_CAUTIOUS, DFM_STANDARD, DFM_AGGRESSIVE, DFM_DISENGAGE };
+
+class Game;
+class GeoscapeState;
+class Craft;
+class Ufo;
+class CraftWeaponProjectile;
+
+/**
+ * Receives the changes of a dogfight that need to be shown on screen.
+ * Only attached while the interception window is open.
+ */
+class DogfightView
+{
+public:
+	/// Cleans up the view.
+	virtual ~DogfightView() = default;
+	/// Draws the radar for the current step, before the animations advance.
+	virtual void drawFrame() = 0;
+	/// Shows a new status message, or clears it if empty.
+	virtual void statusChanged(const std::string &status) = 0;
+	/// Shows the new distance to the UFO.
+	virtual void distanceChanged(int distance) = 0;
+	/// Shows the remaining ammo of a weapon.
+	virtual void ammoChanged(int weapon, int ammo) = 0;
+	/// Redraws the craft shield.
+	virtual void craftShieldChanged() = 0;
+	/// Redraws the craft damage.
+	virtual void craftDamaged() = 0;
+	/// Offers the self-destruct button.
+	virtual void craftDefenseless() = 0;
+};
+
+/**
+ * The rules of a dogfight (interception) between a player craft and an UFO,
+ * without any widgets, so it can be stepped while no window is shown.
+ */
+class DogfightSimulation
+{
+private:
+	Game *_game;
+	GeoscapeState *_state;
+	DogfightView *_view;
+	Craft *_craft;
+	Ufo *_ufo;
+	DogfightMode _mode;
+	std::string _status;
+	bool _ufoIsAttacking, _disableDisengage, _disableCautious, _craftIsDefenseless, _selfDestructPressed;
+	int _timeout, _currentDist, _targetDist, _weaponFireInterval[RuleCraft::WeaponMax], _weaponFireCountdown[RuleCraft::WeaponMax];
+	bool _end, _endUfoHandled, _endCraftHandled, _ufoBreakingOff, _destroyUfo, _destroyCraft, _weaponEnabled[RuleCraft::WeaponMax];
+	bool _minimized, _endDogfight, _animatingHit;
+	std::vector<CraftWeaponProjectile*> _projectiles;
+	int _ufoSize, _interceptionNumber;
+	int _weaponNum;
+	int _pilotAccuracyBonus, _pilotDodgeBonus, _pilotApproachSpeedModifier, _craftAccelerationBonus;
+	bool _firedAtLeastOnce, _experienceAwarded;
+	bool _tractorLockedOn[RuleCraft::WeaponMax];
+
+	/// Advances the status timeout and the UFO animations.
+	void animate();
+	/// Fires a craft weapon.
+	void fireWeapon(int i);
+	/// Fires the UFO weapon.
+	void ufoFireWeapon();
+	/// Sets the craft to minimum distance.
+	void minimumDistance();
+	/// Sets the craft to maximum distance.
+	void maximumDistance();
+	/// Sets the craft to maximum distance or 8 km, whichever is smaller.
+	void aggressiveDistance();
+public:
+	/// Creates a dogfight simulation.
+	DogfightSimulation(Game *game, GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking);
+	/// Cleans up the dogfight simulation.
+	~DogfightSimulation();
+	DogfightSimulation(const DogfightSimulation&) = delete;
+	DogfightSimulation &operator=(const DogfightSimulation&) = delete;
+
+	/// Attaches a view, or detaches it if null.
+	void setView(DogfightView *view);
+	/// Runs one step of the dogfight.
+	void think();
+	/// Moves the craft, projectiles and checks the end conditions.
+	void update();
+	/// Ends the dogfight.
+	void endDogfight();
+	/// Checks if the dogfight has ended.
+	bool dogfightEnded() const;
+	/// Changes the status message.
+	void setStatus(const std::string &status);
+	/// Gets the status message.
+	const std::string &getStatus() const;
+	/// Changes the attack mode.
+	void setMode(DogfightMode mode);
+	/// Gets the attack mode.
+	DogfightMode getMode() const;
+	/// Checks if the craft can still be given orders.
+	bool canChangeMode() const;
+	/// Toggles the self-destruct of a defenseless craft.
+	void toggleSelfDestruct();
+	/// Checks if the self-destruct is on.
+	bool isSelfDestructPressed() const;
+	/// Checks if the craft has nothing left to fight with.
+	bool isCraftDefenseless() const;
+	/// Checks if the craft can't disengage.
+	bool isDisengageDisabled() const;
+	/// Checks if the craft can't attack cautiously.
+	bool isCautiousDisabled() const;
+	/// Checks if the UFO is the aggressor.
+	bool isUfoAttacking() const;
+	/// Checks if the dogfight is minimized.
+	bool isMinimized() const;
+	/// Sets the dogfight minimized.
+	void setMinimized(bool minimized);
+	/// Gets the number of weapon slots.
+	int getWeaponNum() const;
+	/// Checks if a weapon is enabled.
+	bool isWeaponEnabled(int i) const;
+	/// Enables or disables a weapon.
+	void setWeaponEnabled(int i, bool enabled);
+	/// Gets the current distance to the UFO.
+	int getCurrentDist() const;
+	/// Gets the UFO size shown on the radar.
+	int getUfoSize() const;
+	/// Gets the projectiles in flight.
+	const std::vector<CraftWeaponProjectile*> &getProjectiles() const;
+	/// Gets interception number.
+	int getInterceptionNumber() const;
+	/// Sets interception number.
+	void setInterceptionNumber(int number);
+	/// Gets pointer to the UFO in this dogfight.
+	Ufo *getUfo() const;
+	/// Gets pointer to the craft in this dogfight.
+	Craft *getCraft() const;
+	/// Award experience to the pilots.
+	void awardExperienceToPilots();
+};
+
+}
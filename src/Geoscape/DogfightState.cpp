@@ -29,27 +29,18 @@
 #include "../Interface/ImageButton.h"
 #include "../Interface/Text.h"
 #include "../Engine/Timer.h"
-#include "../Engine/Collections.h"
 #include "Globe.h"
 #include "../Savegame/SavedGame.h"
-#include "../Savegame/Soldier.h"
-#include "../Mod/RuleSoldier.h"
 #include "../Savegame/Craft.h"
 #include "../Mod/RuleCraft.h"
 #include "../Savegame/CraftWeapon.h"
 #include "../Mod/RuleCraftWeapon.h"
 #include "../Savegame/Ufo.h"
 #include "../Mod/RuleUfo.h"
-#include "../Mod/AlienRace.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Sound.h"
 #include "../Savegame/Base.h"
 #include "../Savegame/CraftWeaponProjectile.h"
-#include "../Savegame/Country.h"
-#include "../Mod/RuleCountry.h"
-#include "../Savegame/Region.h"
-#include "../Mod/RuleRegion.h"
-#include "../Savegame/AlienMission.h"
 #include "DogfightErrorState.h"
 #include "../Mod/RuleInterface.h"
 #include "../Mod/Mod.h"
@@ -240,78 +231,13 @@ const int DogfightState::_projectileBlobs[4][6][3] =
  */
 DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking) :
 	_state(state), _craft(craft), _ufo(ufo),
-	_ufoIsAttacking(ufoIsAttacking), _disableDisengage(false), _disableCautious(false), _craftIsDefenseless(false), _selfDestructPressed(false),
-	_timeout(50), _currentDist(640), _targetDist(560),
-	_end(false), _endUfoHandled(false), _endCraftHandled(false), _ufoBreakingOff(false), _destroyUfo(false), _destroyCraft(false),
-	_minimized(false), _endDogfight(false), _animatingHit(false), _waitForPoly(false), _waitForAltitude(false), _ufoSize(0), _craftHeight(0), _currentCraftDamageColor(0),
-	_interceptionNumber(0), _interceptionsCount(0), _x(0), _y(0), _minimizedIconX(0), _minimizedIconY(0), _firedAtLeastOnce(false), _experienceAwarded(false),
+	_waitForPoly(false), _waitForAltitude(false), _craftHeight(0), _currentCraftDamageColor(0),
+	_interceptionsCount(0), _x(0), _y(0), _minimizedIconX(0), _minimizedIconY(0),
 	_delayedRecolorDone(false)
 {
 	_screen = false;
-	_craft->setInDogfight(true);
-	_weaponNum = _craft->getRules()->getWeapons();
-	if (_weaponNum > RuleCraft::WeaponMax)
-		_weaponNum = RuleCraft::WeaponMax;
-
-	for (int i = 0; i < _weaponNum; ++i)
-	{
-		_weaponEnabled[i] = true;
-		_weaponFireCountdown[i] = 0;
-		_tractorLockedOn[i] = false;
-
-		CraftWeapon* w = _craft->getWeapons()->at(i);
-		if (w)
-		{
-			_weaponEnabled[i] = !w->isDisabled();
-		}
-	}
-
-	// pilot modifiers
-	const std::vector<Soldier*> pilots = _craft->getPilotList(false);
-
-	for (auto* pilot : pilots)
-	{
-		pilot->prepareStatsWithBonuses(_game->getMod()); // refresh soldier bonuses
-	}
-	_pilotAccuracyBonus = _craft->getPilotAccuracyBonus(pilots, _game->getMod());
-	_pilotDodgeBonus = _craft->getPilotDodgeBonus(pilots, _game->getMod());
-	_pilotApproachSpeedModifier = _craft->getPilotApproachSpeedModifier(pilots, _game->getMod());
-
-	_craftAccelerationBonus = 2; // vanilla
-	if (!pilots.empty())
-	{
-		_craftAccelerationBonus = std::min(4, (_craft->getCraftStats().accel / 3) + 1);
-	}
-
-	// HK options
-	if (_ufoIsAttacking)
-	{
-		if (_ufo->getCraftStats().speedMax >= _craft->getCraftStats().speedMax)
-		{
-			_disableDisengage = true;
-		}
-		if (_weaponNum == 0)
-		{
-			_disableCautious = true;
-		}
-		// make sure the HK attacks its primary target first!
-		{
-			Craft* target = dynamic_cast<Craft*>(_ufo->getDestination());
-			if (target)
-			{
-				if (_craft != target)
-				{
-					// push secondary targets a tiny bit away from the HK
-					_currentDist += 16;
-				}
-				else
-				{
-					// approach primary target at maximum approach speed
-					_pilotApproachSpeedModifier = 4;
-				}
-			}
-		}
-	}
+	_sim = new DogfightSimulation(_game, state, craft, ufo, ufoIsAttacking);
+	_weaponNum = _sim->getWeaponNum();
 
 	// Create objects
 	_window = new Surface(160, 96, _x, _y);
@@ -343,7 +269,7 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 	_btnMinimizedIcon = new InteractiveSurface(32, 20, _minimizedIconX, _minimizedIconY);
 	_txtInterceptionNumber = new Text(16, 9, _minimizedIconX + 18, _minimizedIconY + 6);
 
-	_mode = _ufoIsAttacking ? _btnAggressive : _btnStandoff;
+	_mode = _sim->isUfoAttacking() ? _btnAggressive : _btnStandoff;
 	_craftDamageAnimTimer = new Timer(500);
 
 	moveWindow();
@@ -398,15 +324,15 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 	_window->drawRect(crop.getCrop(), 15);
 	crop.blit(_window);
 
-	if (_ufoIsAttacking)
+	if (_sim->isUfoAttacking())
 	{
 		_window->drawRect(_btnStandoff->getX() + 2, _btnStandoff->getY() + 2, _btnStandoff->getWidth() - 4, _btnStandoff->getHeight() - 4, dogfightInterface->getElement("standoffButton")->color + 4);
-		if (_disableCautious)
+		if (_sim->isCautiousDisabled())
 		{
 			_window->drawRect(_btnCautious->getX() + 2, _btnCautious->getY() + 2, _btnCautious->getWidth() - 4, _btnCautious->getHeight() - 4, dogfightInterface->getElement("cautiousButton")->color + 4);
 		}
 		_window->drawRect(_btnStandard->getX() + 2, _btnStandard->getY() + 2, _btnStandard->getWidth() - 4, _btnStandard->getHeight() - 4, dogfightInterface->getElement("standardButton")->color + 4);
-		if (_disableDisengage)
+		if (_sim->isDisengageDisabled())
 		{
 			_window->drawRect(_btnDisengage->getX() + 2, _btnDisengage->getY() + 2, _btnDisengage->getWidth() - 4, _btnDisengage->getHeight() - 4, dogfightInterface->getElement("disengageButton")->color + 4);
 		}
@@ -440,47 +366,43 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 	_preview->onMouseClick((ActionHandler)&DogfightState::previewClick);
 
 	_btnMinimize->onMouseClick((ActionHandler)&DogfightState::btnMinimizeClick);
-	_btnMinimize->setVisible(!_ufoIsAttacking);
+	_btnMinimize->setVisible(!_sim->isUfoAttacking());
 
 	_btnStandoff->copy(_window);
 	_btnStandoff->setGroup(&_mode);
 	_btnStandoff->onMousePress((ActionHandler)&DogfightState::btnStandoffPress);
 	_btnStandoff->onMousePress((ActionHandler)&DogfightState::btnStandoffRightPress, SDL_BUTTON_RIGHT);
-	_btnStandoff->setVisible(!_ufoIsAttacking);
+	_btnStandoff->setVisible(!_sim->isUfoAttacking());
 
 	_btnCautious->copy(_window);
 	_btnCautious->setGroup(&_mode);
 	_btnCautious->onMousePress((ActionHandler)&DogfightState::btnCautiousPress);
 	_btnCautious->onMousePress((ActionHandler)&DogfightState::btnCautiousRightPress, SDL_BUTTON_RIGHT);
-	_btnCautious->setVisible(!_disableCautious);
+	_btnCautious->setVisible(!_sim->isCautiousDisabled());
 
 	_btnStandard->copy(_window);
 	_btnStandard->setGroup(&_mode);
 	_btnStandard->onMousePress((ActionHandler)&DogfightState::btnStandardPress);
 	_btnStandard->onMousePress((ActionHandler)&DogfightState::btnStandardRightPress, SDL_BUTTON_RIGHT);
-	_btnStandard->setVisible(!_ufoIsAttacking);
+	_btnStandard->setVisible(!_sim->isUfoAttacking());
 
 	_btnAggressive->copy(_window);
 	_btnAggressive->setGroup(&_mode);
 	_btnAggressive->onMousePress((ActionHandler)&DogfightState::btnAggressivePress);
 	_btnAggressive->onMousePress((ActionHandler)&DogfightState::btnAggressiveRightPress, SDL_BUTTON_RIGHT);
-	if (_ufoIsAttacking)
-	{
-		btnAggressivePress(0);
-	}
 
 	_btnDisengage->copy(_window);
 	_btnDisengage->onMousePress((ActionHandler)&DogfightState::btnDisengagePress);
 	_btnDisengage->onMousePress((ActionHandler)&DogfightState::btnDisengageRightPress, SDL_BUTTON_RIGHT);
 	_btnDisengage->setGroup(&_mode);
-	_btnDisengage->setVisible(!_disableDisengage);
+	_btnDisengage->setVisible(!_sim->isDisengageDisabled());
 
 	_btnUfo->copy(_window);
 	_btnUfo->onMouseClick((ActionHandler)&DogfightState::btnUfoClick);
 
 	_txtDistance->setText("640");
 
-	if (_ufoIsAttacking)
+	if (_sim->isUfoAttacking())
 		_txtStatus->setText(tr("STR_AGGRESSIVE_ATTACK"));
 	else
 		_txtStatus->setText(tr("STR_STANDOFF"));
@@ -623,61 +545,6 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 
 	_craftDamageAnimTimer->onTimer((StateHandler)&DogfightState::animateCraftDamage);
 
-	// don't set these variables if the ufo is already engaged in a dogfight
-	if (!_ufo->getEscapeCountdown())
-	{
-		_ufo->setFireCountdown(0);
-		int escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime()) - 30 * _game->getSavedGame()->getDifficultyCoefficient();
-		{
-			int diff = _game->getSavedGame()->getDifficulty();
-			auto& custom = _game->getMod()->getUfoEscapeCountdownCoefficients();
-			if (custom.size() > (size_t)diff)
-			{
-				escapeCountdown = _ufo->getRules()->getBreakOffTime() + RNG::generate(0, _ufo->getRules()->getBreakOffTime());
-				escapeCountdown = escapeCountdown * custom[diff] / 100;
-			}
-		}
-		_ufo->setEscapeCountdown(std::max(1, escapeCountdown));
-	}
-
-	for (int i = 0; i < _weaponNum; ++i)
-	{
-		if (_craft->getWeapons()->at(i))
-		{
-			if (!_ufoIsAttacking)
-			{
-				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getStandardReload();
-			}
-			else
-			{
-				_weaponFireInterval[i] = _craft->getWeapons()->at(i)->getRules()->getAggressiveReload();
-			}
-		}
-	}
-
-	// Set UFO size - going to be moved to Ufo class to implement simultaneous dogfights.
-	std::string ufoSize = _ufo->getRules()->getSize();
-	if (ufoSize.compare("STR_VERY_SMALL") == 0)
-	{
-		_ufoSize = 0;
-	}
-	else if (ufoSize.compare("STR_SMALL") == 0)
-	{
-		_ufoSize = 1;
-	}
-	else if (ufoSize.compare("STR_MEDIUM_UC") == 0)
-	{
-		_ufoSize = 2;
-	}
-	else if (ufoSize.compare("STR_LARGE") == 0)
-	{
-		_ufoSize = 3;
-	}
-	else
-	{
-		_ufoSize = 4;
-	}
-
 	// Get crafts height. Used for damage indication.
 	for (int y = 0; y < _craftSprite->getHeight(); ++y)
 	{
@@ -695,11 +562,8 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 	drawCraftDamage();
 	drawCraftShield();
 
-	// Set this as the interception handling UFO shield recharge if no other is doing it
-	if (_ufo->getShieldRechargeHandle() == 0)
-	{
-		_ufo->setShieldRechargeHandle(_interceptionNumber);
-	}
+	_sim->setView(this);
+	statusChanged(_sim->getStatus());
 }
 
 /**
@@ -708,11 +572,7 @@ DogfightState::DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool
 DogfightState::~DogfightState()
 {
 	delete _craftDamageAnimTimer;
-	while (!_projectiles.empty())
-	{
-		delete _projectiles.back();
-		_projectiles.pop_back();
-	}
+	delete _sim;
 }
 
 /**
@@ -721,7 +581,7 @@ DogfightState::~DogfightState()
  */
 bool DogfightState::isUfoAttacking() const
 {
-	return _ufoIsAttacking;
+	return _sim->isUfoAttacking();
 }
 
 /**
@@ -734,9 +594,9 @@ void DogfightState::think()
 		// can't be done in the constructor (recoloring the ammo text doesn't work)
 		for (int i = 0; i < _weaponNum; ++i)
 		{
-			if (_craft->getWeapons()->at(i) && !_weaponEnabled[i])
+			if (_craft->getWeapons()->at(i) && !_sim->isWeaponEnabled(i))
 			{
-				recolor(i, _weaponEnabled[i]);
+				recolor(i, false);
 			}
 		}
 		_delayedRecolorDone = true;
@@ -752,18 +612,12 @@ void DogfightState::think()
 			}
 		}
 	}
-	if (!_endDogfight)
+	bool running = !_sim->dogfightEnded();
+	_sim->think();
+	if (running)
 	{
-		update();
 		_craftDamageAnimTimer->think(this, 0);
 	}
-	if (!_ufoIsAttacking || _ufo->getStatus() == Ufo::LANDED)
-	{
-		if (!_craft->isInDogfight() || _craft->getDestination() != _ufo || _ufo->getStatus() == Ufo::LANDED)
-		{
-			endDogfight();
-		}
-	}
 }
 
 /**
@@ -771,7 +625,7 @@ void DogfightState::think()
  */
 void DogfightState::animateCraftDamage()
 {
-	if (_minimized)
+	if (_sim->isMinimized())
 	{
 		return;
 	}
@@ -865,9 +719,10 @@ void DogfightState::drawCraftShield()
 }
 
 /**
- * Animates the window with a palette effect.
+ * Animates the window with a palette effect
+ * and draws the UFO and projectiles on the radar.
  */
-void DogfightState::animate()
+void DogfightState::drawFrame()
 {
 	// Animate radar waves and other stuff.
 	for (int x = 0; x < _window->getWidth(); ++x)
@@ -896,997 +751,82 @@ void DogfightState::animate()
 	}
 
 	// Draw projectiles.
-	for (auto* cwp : _projectiles)
+	for (auto* cwp : _sim->getProjectiles())
 	{
 		drawProjectile(cwp);
 	}
-
-	// Clears text after a while
-	if (_timeout == 0)
-	{
-		_txtStatus->setText("");
-	}
-	else
-	{
-		_timeout--;
-	}
-
-	// Animate UFO hit.
-	bool lastHitAnimFrame = false;
-	if (_animatingHit && _ufo->getHitFrame() > 0)
-	{
-		_ufo->setHitFrame(_ufo->getHitFrame() - 1);
-		if (_ufo->getHitFrame() == 0)
-		{
-			_animatingHit = false;
-			lastHitAnimFrame = true;
-		}
-	}
-
-	// Animate UFO crash landing.
-	if (_ufo->isCrashed() && _ufo->getHitFrame() == 0 && !lastHitAnimFrame)
-	{
-		--_ufoSize;
-	}
 }
 
 /**
- * Updates all the elements in the dogfight, including ufo movement,
- * weapons fire, projectile movement, ufo escape conditions,
- * craft and ufo destruction conditions, and retaliation mission generation, as applicable.
+ * Shows the dogfight status message.
+ * @param status Status string ID, or empty to clear it.
  */
-void DogfightState::update()
+void DogfightState::statusChanged(const std::string &status)
 {
-	bool finalRun = false;
-	// Check if craft is not low on fuel when window minimized, and
-	// Check if crafts destination hasn't been changed when window minimized.
-	if (!_ufoIsAttacking)
+	if (status.empty())
 	{
-		Ufo* u = dynamic_cast<Ufo*>(_craft->getDestination());
-		if (u != _ufo || !_craft->isInDogfight() || _craft->getLowFuel() || (_minimized && _ufo->isCrashed()))
-		{
-			endDogfight();
-			return;
-		}
-	}
-
-	if (!_minimized)
-	{
-		animate();
-		if (!_ufo->isCrashed() && !_ufo->isDestroyed() && !_craft->isDestroyed() && !_ufo->getInterceptionProcessed())
-		{
-			_ufo->setInterceptionProcessed(true);
-			int escapeCounter = _ufo->getEscapeCountdown();
-			if (_ufoIsAttacking)
-			{
-				if (_disableDisengage && _ufo->getSoftlockShotCounter() >= _ufo->getRules()->getSoftlockThreshold())
-				{
-					escapeCounter = 1; // game is in softlock, stop being a hunter-killer and disengage!
-				}
-				else if (_ufo->getDamage() > _ufo->getCraftStats().damageMax / 3 && _ufo->getHuntBehavior() != 1)
-				{
-					// TODO: rethink: unhardcode run away thresholds?
-					if (_craft->getDamage() > _craft->getDamageMax() / 2)
-					{
-						escapeCounter = 999; // it's gonna be tight, continue shooting...
-					}
-					else
-					{
-						escapeCounter = 1; // we're badly hurt and xcom isn't, abort immediately!
-					}
-				}
-				else
-				{
-					escapeCounter = 999; // we're still ok, continue shooting...
-				}
-			}
-			else if (Options::dogfightAI)
-			{
-				int maxRange = 0;
-				for (CraftWeapon *wpn : *(_craft->getWeapons()))
-				{
-					if (wpn == NULL)
-						continue;
-					if (wpn->getAmmo() == 0)
-						continue;
-					if (wpn->getRules()->getRange() > maxRange)
-						maxRange = wpn->getRules()->getRange();
-				}
-				int speedMinusTractors = std::max(0, _ufo->getCraftStats().speedMax - _ufo->getTractorBeamSlowdown());
-				if (speedMinusTractors > _craft->getCraftStats().speedMax && _currentDist <= maxRange * 8)
-				{
-					if (_targetDist > _ufo->getRules()->getWeaponRange() * 8)
-					{
-						_targetDist = _ufo->getRules()->getWeaponRange() * 8;
-						setStatus("STR_CANT_KEEP_DISTANCE");
-					}
-				}
-			}
-
-			if (escapeCounter > 0)
-			{
-				escapeCounter--;
-				_ufo->setEscapeCountdown(escapeCounter);
-				// Check if UFO is breaking off.
-				if (escapeCounter == 0)
-				{
-					_ufo->setSpeed(_ufo->getCraftStats().speedMax);
-					if (_ufoIsAttacking && _ufo->isHunterKiller())
-					{
-						// stop being a hunter-killer and run away!
-						_ufo->resetOriginalDestination(_craft);
-						_ufo->setHunterKiller(false);
-					}
-				}
-			}
-			if (_ufo->getFireCountdown() > 0)
-			{
-				_ufo->setFireCountdown(_ufo->getFireCountdown() - 1);
-			}
-		}
-	}
-	// Crappy craft is chasing UFO.
-	int speedMinusTractors = std::max(0, _ufo->getSpeed() - _ufo->getTractorBeamSlowdown());
-	if (speedMinusTractors > _craft->getCraftStats().speedMax)
-	{
-		if (!_ufoIsAttacking || !_ufo->isHunterKiller())
-		{
-			_ufoBreakingOff = true;
-			finalRun = true;
-			setStatus("STR_UFO_OUTRUNNING_INTERCEPTOR");
-		}
+		_txtStatus->setText("");
 	}
 	else
 	{
-		_ufoBreakingOff = false;
-	}
-
-	bool projectileInFlight = false;
-	if (!_minimized)
-	{
-		int distanceChange = 0;
-
-		// Update distance
-		if (!_ufoBreakingOff)
-		{
-			if (_currentDist < _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
-			{
-				distanceChange = 2 * _craftAccelerationBonus; // disengage speed
-				if (_currentDist + distanceChange >_targetDist)
-				{
-					distanceChange = _targetDist - _currentDist;
-				}
-			}
-			else if (_currentDist > _targetDist && !_ufo->isCrashed() && !_craft->isDestroyed())
-			{
-				distanceChange = -1 * _pilotApproachSpeedModifier; // engage speed
-			}
-
-			// don't let the interceptor mystically push or pull its fired projectiles
-			for (auto* cwp : _projectiles)
-			{
-				if (cwp->getGlobalType() != CWPGT_BEAM && cwp->getDirection() == D_UP)
-				{
-					cwp->setPosition(cwp->getPosition() + distanceChange);
-				}
-			}
-		}
-		else
-		{
-			distanceChange = 4; // ufo breaking off speed
-
-			// UFOs can try to outrun our missiles, don't adjust projectile positions here
-			// If UFOs ever fire anything but beams, those positions need to be adjust here though.
-		}
-
-		_currentDist += distanceChange;
-
-		if (_game->getMod()->getShowDogfightDistanceInKm())
-		{
-			_txtDistance->setText(tr("STR_KILOMETERS").arg(_currentDist / 8));
-		}
-		else
-		{
-			std::ostringstream ss;
-			ss << _currentDist;
-			_txtDistance->setText(ss.str());
-		}
-
-		// Check and recharge craft shields
-		// Check if the UFO's shields are being handled by an interception window
-		if (_ufo->getShieldRechargeHandle() == 0)
-		{
-			_ufo->setShieldRechargeHandle(_interceptionNumber);
-		}
-
-		// UFO shields
-		if ((_ufo->getShield() != 0) && (_interceptionNumber == _ufo->getShieldRechargeHandle()))
-		{
-			int total = _ufo->getCraftStats().shieldRecharge / 100;
-			if (RNG::percent(_ufo->getCraftStats().shieldRecharge % 100))
-				total++;
-			_ufo->setShield(_ufo->getShield() + total);
-		}
-
-		// Player craft shields
-		if (_craft->getShield() != 0)
-		{
-			int total = _craft->getCraftStats().shieldRecharge / 100;
-			if (RNG::percent(_craft->getCraftStats().shieldRecharge % 100))
-				total++;
-			if (total != 0)
-			{
-				_craft->setShield(_craft->getShield() + total);
-				drawCraftShield();
-			}
-		}
-
-		// Move projectiles and check for hits.
-		for (auto* p : _projectiles)
-		{
-			p->move();
-			// Projectiles fired by interceptor.
-			if (p->getDirection() == D_UP)
-			{
-				// Projectile reached the UFO - determine if it's been hit.
-				if (((p->getPosition() >= _currentDist) || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved())) && !_ufo->isCrashed() && !p->getMissed())
-				{
-					// UFO hit.
-					int chanceToHit = (p->getAccuracy() * (100 + 300 / (5 - _ufoSize)) + 100) / 200; // vanilla xcom
-					chanceToHit -= _ufo->getCraftStats().avoidBonus;
-					chanceToHit += _craft->getCraftStats().hitBonus;
-					chanceToHit += _pilotAccuracyBonus;
-					if (RNG::percent(chanceToHit))
-					{
-						// Formula delivered by Volutar, altered by Extended version.
-						int power = p->getDamage() * (_craft->getCraftStats().powerBonus + 100) / 100;
-
-						// Handle UFO shields
-						int damage = RNG::generate(power / 2, power);
-						int shieldDamage = 0;
-						if (_ufo->getShield() != 0)
-						{
-							shieldDamage = damage * p->getShieldDamageModifier() / 100;
-							if (p->getShieldDamageModifier() == 0)
-							{
-								damage = 0;
-							}
-							else
-							{
-								// scale down by bleed-through factor and scale up by shield-effectiveness factor
-								damage = std::max(0, shieldDamage - _ufo->getShield()) * _ufo->getCraftStats().shieldBleedThrough / p->getShieldDamageModifier();
-							}
-							_ufo->setShield(_ufo->getShield() - shieldDamage);
-						}
-
-						damage = std::max(0, damage - _ufo->getCraftStats().armor);
-						_ufo->setDamage(_ufo->getDamage() + damage, _game->getMod());
-						_state->handleDogfightExperience(); // called after setDamage
-						if (_ufo->isCrashed())
-						{
-							_ufo->setShotDownByCraftId(_craft->getUniqueId());
-							_ufo->setSpeed(0);
-							_ufo->setDestination(0);
-							// if the ufo got destroyed here, these no longer apply
-							_ufoBreakingOff = false;
-							finalRun = false;
-							_end = false;
-						}
-						if (_ufo->getHitFrame() == 0)
-						{
-							_animatingHit = true;
-							_ufo->setHitFrame(3);
-						}
-
-						// How hard was the ufo hit?
-						if (_ufo->getShield() != 0)
-						{
-							setStatus("STR_UFO_SHIELD_HIT");
-						}
-						else
-						{
-							if (damage == 0)
-							{
-								if (shieldDamage == 0)
-								{
-									setStatus("STR_UFO_HIT_NO_DAMAGE");
-								}
-								else
-								{
-									setStatus("STR_UFO_SHIELD_DOWN");
-								}
-							}
-							else
-							{
-								if (damage < _ufo->getCraftStats().damageMax / 2 * _game->getMod()->getUfoGlancingHitThreshold() / 100)
-								{
-									setStatus("STR_UFO_HIT_GLANCING");
-								}
-								else
-								{
-									setStatus("STR_UFO_HIT");
-								}
-							}
-						}
-
-						_game->getMod()->getSound("GEO.CAT", Mod::UFO_HIT)->play();
-						p->remove();
-					}
-					// Missed.
-					else
-					{
-						if (p->getGlobalType() == CWPGT_BEAM)
-						{
-							p->remove();
-						}
-						else
-						{
-							p->setMissed(true);
-						}
-					}
-				}
-				// Check if projectile passed it's maximum range.
-				if (p->getGlobalType() == CWPGT_MISSILE && p->getPosition() / 8 >= p->getRange())
-				{
-					p->remove();
-				}
-				else if (!_ufo->isCrashed())
-				{
-					projectileInFlight = true;
-				}
-			}
-			// Projectiles fired by UFO.
-			else if (p->getDirection() == D_DOWN)
-			{
-				if (p->getGlobalType() == CWPGT_MISSILE || (p->getGlobalType() == CWPGT_BEAM && p->toBeRemoved()))
-				{
-					int chancetoHit = p->getAccuracy(); // vanilla xcom
-					chancetoHit -= _craft->getCraftStats().avoidBonus;
-					chancetoHit += _ufo->getCraftStats().hitBonus;
-					chancetoHit -= _pilotDodgeBonus;
-					// evasive maneuvers
-					if (_ufoIsAttacking && _mode == _btnCautious)
-					{
-						// HK's chance to hit is halved, but craft's reload time is doubled too
-						chancetoHit = chancetoHit / 2;
-					}
-					if (RNG::percent(chancetoHit) || _selfDestructPressed)
-					{
-						// Formula delivered by Volutar, altered by Extended version.
-						int power = p->getDamage() * (_ufo->getCraftStats().powerBonus + 100) / 100;
-						int damage = RNG::generate(0, power);
-
-						if (_craft->getShield() != 0)
-						{
-							int shieldBleedThroughDamage = std::max(0, damage - _craft->getShield()) * _craft->getCraftStats().shieldBleedThrough / 100;
-							_craft->setShield(_craft->getShield() - damage);
-							damage = shieldBleedThroughDamage;
-							drawCraftShield();
-							setStatus("STR_INTERCEPTOR_SHIELD_HIT");
-						}
-
-						damage = std::max(0, damage - _craft->getCraftStats().armor);
-
-						// if a totally crappy HK is attacking a completely defenseless craft, avoid endless fight
-						if (_selfDestructPressed)
-						{
-							damage = _craft->getCraftStats().damageMax;
-						}
-
-						if (damage)
-						{
-							_craft->setDamage(_craft->getDamage() + damage);
-							drawCraftDamage();
-							setStatus("STR_INTERCEPTOR_DAMAGED");
-							_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_HIT)->play(); //10
-							if (_mode == _btnCautious && _craft->getDamagePercentage() >= 50 && !_ufoIsAttacking)
-							{
-								_targetDist = STANDOFF_DIST;
-							}
-						}
-					}
-					p->remove();
-				}
-			}
-		}
-
-		// Remove projectiles that hit or missed their target.
-		Collections::deleteIf(_projectiles, _projectiles.size(),
-			[&](CraftWeaponProjectile* cwp)
-			{
-				return cwp->toBeRemoved() == true || (cwp->getMissed() == true && cwp->getPosition() <= 0);
-			}
-		);
-
-		// Check if the situation is hopeless for the craft
-		if (_disableDisengage && !_craftIsDefenseless)
-		{
-			if (_projectiles.empty())
-			{
-				bool hasNoAmmo = true;
-				for (auto cw : *_craft->getWeapons())
-				{
-					if (cw && cw->getAmmo() > 0)
-					{
-						hasNoAmmo = false;
-						break;
-					}
-				}
-				// no projectiles in the air and no ammo left
-				if (hasNoAmmo)
-				{
-					_craftIsDefenseless = true;
-
-					// self-destruct button
-					int offset = _game->getMod()->getInterface("dogfight")->getElement("minimizeButtonDummy")->TFTDMode ? 1 : 0;
-					_btnMinimize->drawRect(1 + offset, 1, _btnMinimize->getWidth() - 2 - offset, _btnMinimize->getHeight() - 2, _colors[DAMAGE_MAX]);
-					_btnMinimize->setVisible(true);
-				}
-			}
-		}
-
-		// Handle weapons and craft distance.
-		for (int i = 0; i < _weaponNum; ++i)
-		{
-			CraftWeapon *w = _craft->getWeapons()->at(i);
-			if (w == 0)
-			{
-				continue;
-			}
-			int wTimer = _weaponFireCountdown[i];
-
-			// Handle weapon firing
-			if (wTimer == 0 && _currentDist <= w->getRules()->getRange() * 8 && w->getAmmo() > 0 && _mode != _btnStandoff
-				&& _mode != _btnDisengage && !_ufo->isCrashed() && !_craft->isDestroyed())
-			{
-				if (_weaponEnabled[i])
-				{
-					fireWeapon(i);
-					projectileInFlight = true;
-				}
-			}
-			else if (wTimer > 0)
-			{
-				--_weaponFireCountdown[i];
-			}
-
-			// Handle craft tractor beams
-			if (w->getRules()->getTractorBeamPower() != 0)
-			{
-				if (_currentDist <= w->getRules()->getRange() * 8 && _mode != _btnStandoff
-					&& _mode != _btnDisengage && !_ufo->isCrashed() && !_craft->isDestroyed()
-					&& _weaponEnabled[i])
-				{
-					if (!_tractorLockedOn[i])
-					{
-						_tractorLockedOn[i] = true;
-						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
-						tractorBeamSlowdown += w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
-						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
-						setStatus("STR_TRACTOR_BEAM_ENGAGED");
-					}
-				}
-				else
-				{
-					if (_tractorLockedOn[i])
-					{
-						_tractorLockedOn[i] = false;
-						int tractorBeamSlowdown = _ufo->getTractorBeamSlowdown();
-						tractorBeamSlowdown -= w->getRules()->getTractorBeamPower() * _game->getMod()->getUfoTractorBeamSizeModifier(_ufoSize) / 100;
-						_ufo->setTractorBeamSlowdown(tractorBeamSlowdown);
-						setStatus("STR_TRACTOR_BEAM_DISENGAGED");
-					}
-				}
-			}
-
-			if (w->getAmmo() == 0 && !projectileInFlight && !_craft->isDestroyed())
-			{
-				// Handle craft distance according to option set by user and available ammo.
-				if (_mode == _btnCautious && !_ufoIsAttacking)
-				{
-					minimumDistance();
-				}
-				else if (_mode == _btnStandard)
-				{
-					maximumDistance();
-				}
-			}
-		}
-
-		// Handle UFO firing.
-		if (_currentDist <= _ufo->getRules()->getWeaponRange() * 8 && !_ufo->isCrashed() && !_craft->isDestroyed())
-		{
-			if (_ufo->getShootingAt() == 0)
-			{
-				_ufo->setShootingAt(_interceptionNumber);
-			}
-			if (_ufo->getShootingAt() == _interceptionNumber)
-			{
-				if (_ufo->getFireCountdown() == 0)
-				{
-					ufoFireWeapon();
-				}
-			}
-		}
-		else if (_ufo->getShootingAt() == _interceptionNumber)
-		{
-			_ufo->setShootingAt(0);
-		}
-	}
-
-	// Check when battle is over.
-	if (_end == true && (((_currentDist > 640 || _minimized) && (_mode == _btnDisengage || _ufoBreakingOff == true)) || (_timeout == 0 && (_ufo->isCrashed() || _craft->isDestroyed()))))
-	{
-		if (_ufoBreakingOff)
-		{
-			_ufo->move();
-			// TODO: rethink: give hunter-killers opportunity to escape?
-			if (!_ufoIsAttacking)
-			{
-				_craft->setDestination(_ufo);
-			}
-		}
-		if (!_destroyCraft && (_destroyUfo || _mode == _btnDisengage))
-		{
-			// keep original target if attacked by a HK (and didn't disengage manually)
-			bool keepOriginalTarget = _ufoIsAttacking && _craft->getDestination() != _ufo;
-			if (!keepOriginalTarget || _mode == _btnDisengage)
-			{
-				_craft->returnToBase();
-			}
-
-			// Need to give the craft at least one step advantage over the hunter-killer (to be able to escape)
-			if (_ufoIsAttacking)
-			{
-				bool returnedToBase = _craft->think();
-				if (returnedToBase)
-				{
-					_game->getSavedGame()->stopHuntingXcomCraft(_craft); // hiding in the base is good enough, obviously
-				}
-			}
-		}
-		if (_ufo->isCrashed())
-		{
-			for (auto* follower : _ufo->getCraftFollowers())
-			{
-				if (follower->getNumTotalUnits() == 0 || !follower->getRules()->getAllowLanding())
-				{
-					follower->returnToBase();
-				}
-			}
-		}
-		endDogfight();
-	}
-
-	if (_currentDist > 640 && _ufoBreakingOff)
-	{
-		finalRun = true;
-	}
-
-	if (!_end)
-	{
-		if (_endCraftHandled)
-		{
-			finalRun = true;
-		}
-		else if (_craft->isDestroyed())
-		{
-			// End dogfight if craft is destroyed.
-			setStatus("STR_INTERCEPTOR_DESTROYED");
-			if (_ufoIsAttacking)
-			{
-				_craft->evacuateCrew(_game->getMod());
-			}
-			_timeout += 30;
-			_game->getMod()->getSound("GEO.CAT", Mod::INTERCEPTOR_EXPLODE)->play();
-			finalRun = true;
-			_destroyCraft = true;
-			_endCraftHandled = true;
-			_ufo->setShootingAt(0);
-		}
-
-		if (_endUfoHandled)
-		{
-			finalRun = true;
-		}
-		else if (_ufo->isCrashed())
-		{
-			// End dogfight if UFO is crashed or destroyed.
-			_endUfoHandled = true;
-
-			if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
-			{
-				AlienRace *race = _game->getMod()->getAlienRace(_ufo->getAlienRace());
-				AlienMission *mission = _ufo->getMission();
-				mission->ufoShotDown(*_ufo);
-				// Check for retaliation trigger.
-				int retaliationOdds = mission->getRules().getRetaliationOdds();
-				if (retaliationOdds == -1)
-				{
-					retaliationOdds = 100 - (4 * (24 - _game->getSavedGame()->getDifficultyCoefficient()) - race->getRetaliationAggression());
-					{
-						int diff = _game->getSavedGame()->getDifficulty();
-						auto& custom = _game->getMod()->getRetaliationTriggerOdds();
-						if (custom.size() > (size_t)diff)
-						{
-							retaliationOdds = custom[diff] + race->getRetaliationAggression();
-						}
-					}
-				}
-				// Have mercy on beginners
-				if (_game->getSavedGame()->getMonthsPassed() < Mod::DIFFICULTY_BASED_RETAL_DELAY[_game->getSavedGame()->getDifficulty()])
-				{
-					retaliationOdds = 0;
-				}
-
-				if (RNG::percent(retaliationOdds))
-				{
-					// Spawn retaliation mission.
-					std::string targetRegion;
-					int retaliationUfoMissionRegionOdds = 50 - 6 * _game->getSavedGame()->getDifficultyCoefficient();
-					{
-						int diff = _game->getSavedGame()->getDifficulty();
-						auto& custom = _game->getMod()->getRetaliationBaseRegionOdds();
-						if (custom.size() > (size_t)diff)
-						{
-							retaliationUfoMissionRegionOdds = 100 - custom[diff];
-						}
-					}
-					if (RNG::percent(retaliationUfoMissionRegionOdds))
-					{
-						// Attack on UFO's mission region
-						targetRegion = _ufo->getMission()->getRegion();
-					}
-					else
-					{
-						// Try to find and attack the originating base.
-						targetRegion = _game->getSavedGame()->locateRegion(*_craft->getBase())->getRules()->getType();
-						// TODO: If the base is removed, the mission is canceled.
-					}
-					// Difference from original: No retaliation until final UFO lands (Original: Is spawned).
-					if (!_game->getSavedGame()->findAlienMission(targetRegion, OBJECTIVE_RETALIATION, race))
-					{
-						auto* retalWeights = race->retaliationMissionWeights(_game->getSavedGame()->getMonthsPassed());
-						std::string retalMission = retalWeights ? retalWeights->choose() : "";
-						const RuleAlienMission *rule = _game->getMod()->getAlienMission(retalMission, false);
-						if (!rule)
-						{
-							rule = _game->getMod()->getRandomMission(OBJECTIVE_RETALIATION, _game->getSavedGame()->getMonthsPassed());
-						}
-
-						if (rule)
-						{
-							AlienMission *newMission = new AlienMission(*rule);
-							newMission->setId(_game->getSavedGame()->getId("ALIEN_MISSIONS"));
-							newMission->setRegion(targetRegion, *_game->getMod());
-							newMission->setRace(_ufo->getAlienRace());
-							newMission->start(*_game, *_state->getGlobe(), newMission->getRules().getWave(0).spawnTimer); // fixed delay for first scout
-							_game->getSavedGame()->getAlienMissions().push_back(newMission);
-						}
-					}
-				}
-			}
-
-			if (_ufo->isDestroyed())
-			{
-				if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
-				{
-					for (auto* country : *_game->getSavedGame()->getCountries())
-					{
-						if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							country->addActivityXcom(_ufo->getRules()->getScore()*2);
-							break;
-						}
-					}
-					for (auto* region : *_game->getSavedGame()->getRegions())
-					{
-						if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							region->addActivityXcom(_ufo->getRules()->getScore()*2);
-							break;
-						}
-					}
-					setStatus("STR_UFO_DESTROYED");
-					_game->getMod()->getSound("GEO.CAT", Mod::UFO_EXPLODE)->play(); //11
-				}
-				_destroyUfo = true;
-			}
-			else
-			{
-				if (_ufo->getShotDownByCraftId() == _craft->getUniqueId())
-				{
-					setStatus("STR_UFO_CRASH_LANDS");
-					_game->getMod()->getSound("GEO.CAT", Mod::UFO_CRASH)->play(); //10
-					for (auto* country : *_game->getSavedGame()->getCountries())
-					{
-						if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							country->addActivityXcom(_ufo->getRules()->getScore());
-							break;
-						}
-					}
-					for (auto* region : *_game->getSavedGame()->getRegions())
-					{
-						if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
-						{
-							region->addActivityXcom(_ufo->getRules()->getScore());
-							break;
-						}
-					}
-				}
-				bool survived = true;
-				bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
-				if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
-				{
-					survived = false; // destroyed on real water
-				}
-				else if (fakeUnderwaterTexture)
-				{
-					if (RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
-					{
-						setStatus("STR_UFO_SURVIVED_SPLASHDOWN");
-					}
-					else
-					{
-						survived = false; // destroyed on fake water
-						setStatus("STR_UFO_DESTROYED_BY_SPLASHDOWN");
-					}
-				}
-				if (!survived)
-				{
-					_ufo->setStatus(Ufo::DESTROYED);
-					_destroyUfo = true;
-				}
-				else
-				{
-					_ufo->setSecondsRemaining(RNG::generate(24, 96)*3600);
-					_ufo->setAltitude("STR_GROUND");
-					if (_ufo->getCrashId() == 0)
-					{
-						_ufo->setCrashId(_game->getSavedGame()->getId("STR_CRASH_SITE"));
-						if (_ufo->isHunterKiller())
-						{
-							// stop being a hunter-killer
-							_ufo->resetOriginalDestination(_craft);
-							_ufo->setHunterKiller(false);
-						}
-					}
-				}
-			}
-			_timeout += 30;
-			if (_ufo->getShotDownByCraftId() != _craft->getUniqueId())
-			{
-				_timeout += 50;
-				_ufo->setHitFrame(3);
-			}
-			finalRun = true;
-
-			if (_ufo->getStatus() == Ufo::LANDED)
-			{
-				_timeout += 30;
-				finalRun = true;
-				_ufo->setShootingAt(0);
-			}
-		}
-		else if (_ufo->getCraftStats().speedMax - _ufo->getTractorBeamSlowdown() == 0) // UFO brought down by tractor beam
-		{
-			_endUfoHandled = true;
-
-			bool survived = true;
-			if (!_state->getGlobe()->insideLand(_ufo->getLongitude(), _ufo->getLatitude()))
-			{
-				survived = false; // destroyed on real water
-			}
-			else
-			{
-				bool fakeUnderwaterTexture = _state->getGlobe()->insideFakeUnderwaterTexture(_ufo->getLongitude(), _ufo->getLatitude());
-				if (fakeUnderwaterTexture && !RNG::percent(_ufo->getRules()->getSplashdownSurvivalChance()))
-				{
-					survived = false; // destroyed on fake water
-				}
-			}
-			if (_ufo->getRules()->isUnmanned())
-			{
-				survived = false; // unmanned UFOs (drones, missiles, etc.) can't be forced to land
-			}
-			if (!survived) // Brought it down over water (and didn't survive splashdown)
-			{
-				finalRun = true;
-				_ufo->setDamage(_ufo->getCraftStats().damageMax, _game->getMod());
-				_state->handleDogfightExperience(); // called after setDamage
-				_ufo->setShotDownByCraftId(_craft->getUniqueId());
-				_ufo->setSpeed(0);
-				_ufo->setStatus(Ufo::DESTROYED);
-				_destroyUfo = true;
-				for (auto* country : *_game->getSavedGame()->getCountries())
-				{
-					if (country->getRules()->insideCountry(_ufo->getLongitude(), _ufo->getLatitude()))
-					{
-						country->addActivityXcom(_ufo->getRules()->getScore());
-						break;
-					}
-				}
-				for (auto* region : *_game->getSavedGame()->getRegions())
-				{
-					if (region->getRules()->insideRegion(_ufo->getLongitude(), _ufo->getLatitude()))
-					{
-						region->addActivityXcom(_ufo->getRules()->getScore());
-						break;
-					}
-				}
-			}
-			else // Brought it down over land (or survived splashdown)
-			{
-				finalRun = true;
-				_ufo->setSecondsRemaining(RNG::generate(30, 120)*60);
-				_ufo->setShootingAt(0);
-				_ufo->setStatus(Ufo::LANDED);
-				_ufo->setAltitude("STR_GROUND");
-				_ufo->setSpeed(0);
-				_ufo->setTractorBeamSlowdown(0);
-				if (_ufo->getLandId() == 0)
-				{
-					_ufo->setLandId(_game->getSavedGame()->getId("STR_LANDING_SITE"));
-				}
-			}
-		}
-	}
-
-	if (!projectileInFlight && finalRun)
-	{
-		_end = true;
+		_txtStatus->setText(tr(status));
 	}
 }
 
 /**
- * Fires a shot from the first weapon
- * equipped on the craft.
+ * Shows the distance to the UFO.
+ * @param distance Distance (8 per km).
  */
-void DogfightState::fireWeapon(int i)
+void DogfightState::distanceChanged(int distance)
 {
-	CraftWeapon *w1 = _craft->getWeapons()->at(i);
-	if (w1->setAmmo(w1->getAmmo() - 1))
+	if (_game->getMod()->getShowDogfightDistanceInKm())
 	{
-		_weaponFireCountdown[i] = _weaponFireInterval[i];
-
-		std::ostringstream ss;
-		ss << w1->getAmmo();
-		_txtAmmo[i]->setText(ss.str());
-
-		CraftWeaponProjectile *p = w1->fire();
-		p->setDirection(D_UP);
-		p->setHorizontalPosition((i % 2 ? HP_RIGHT : HP_LEFT) * (1 + 2 * (i / 2)));
-		_projectiles.push_back(p);
-
-		_game->getMod()->getSound("GEO.CAT", w1->getRules()->getSound())->play();
-		_firedAtLeastOnce = true;
-	}
-}
-
-/**
- *	Each time a UFO will try to fire it's cannons
- *	a calculation is made. There's only 10% chance
- *	that it will actually fire.
- */
-void DogfightState::ufoFireWeapon()
-{
-	int fireCountdown = std::max(1, (_ufo->getRules()->getWeaponReload() - 2 * _game->getSavedGame()->getDifficultyCoefficient()));
-	{
-		int diff = _game->getSavedGame()->getDifficulty();
-		auto& custom = _game->getMod()->getUfoFiringRateCoefficients();
-		if (custom.size() > (size_t)diff)
-		{
-			fireCountdown = std::max(1, _ufo->getRules()->getWeaponReload() * custom[diff] / 100);
-		}
-	}
-	_ufo->setFireCountdown(RNG::generate(0, fireCountdown) + fireCountdown);
-
-	setStatus("STR_UFO_RETURN_FIRE");
-	CraftWeaponProjectile *p = new CraftWeaponProjectile();
-	p->setType(CWPT_PLASMA_BEAM);
-	p->setAccuracy(60);
-	p->setDamage(_ufo->getRules()->getWeaponPower());
-	p->setDirection(D_DOWN);
-	p->setHorizontalPosition(HP_CENTER);
-	p->setPosition(_currentDist - (_ufo->getRules()->getRadius() / 2));
-	_projectiles.push_back(p);
-	if (_ufoIsAttacking && _disableDisengage)
-	{
-		_ufo->increaseSoftlockShotCounter();
-	}
-
-	if (_ufo->getRules()->getFireSound() == -1)
-	{
-		_game->getMod()->getSound("GEO.CAT", Mod::UFO_FIRE)->play();
+		_txtDistance->setText(tr("STR_KILOMETERS").arg(distance / 8));
 	}
 	else
 	{
-		_game->getMod()->getSound("GEO.CAT", _ufo->getRules()->getFireSound())->play();
+		std::ostringstream ss;
+		ss << distance;
+		_txtDistance->setText(ss.str());
 	}
 }
 
 /**
- * Sets the craft to the minimum distance
- * required to fire a weapon.
+ * Shows the remaining ammo of a weapon.
+ * @param weapon Weapon slot.
+ * @param ammo Ammo left.
  */
-void DogfightState::minimumDistance()
+void DogfightState::ammoChanged(int weapon, int ammo)
 {
-	int max = 0;
-	for (auto* cw : *_craft->getWeapons())
-	{
-		if (cw == 0)
-			continue;
-		if (cw->getRules()->getRange() > max && cw->getAmmo() > 0)
-		{
-			max = cw->getRules()->getRange();
-		}
-	}
-	if (max == 0)
-	{
-		_targetDist = STANDOFF_DIST;
-	}
-	else
-	{
-		_targetDist = max * 8;
-	}
+	std::ostringstream ss;
+	ss << ammo;
+	_txtAmmo[weapon]->setText(ss.str());
 }
 
 /**
- * Sets the craft to the maximum distance
- * required to fire a weapon.
+ * Redraws the craft shield.
  */
-void DogfightState::maximumDistance()
+void DogfightState::craftShieldChanged()
 {
-	int min = 1000;
-	for (auto* cw : *_craft->getWeapons())
-	{
-		if (cw == 0)
-			continue;
-		if (cw->getRules()->getRange() < min && cw->getAmmo() > 0)
-		{
-			min = cw->getRules()->getRange();
-		}
-	}
-	if (_ufoIsAttacking)
-	{
-		// If the UFO is actively hunting us, consider its weapon range too
-		if (_ufo->getRules()->getWeaponRange() > 0 && _ufo->getRules()->getWeaponRange() < min)
-		{
-			min = _ufo->getRules()->getWeaponRange();
-		}
-	}
-	if (min == 1000)
-	{
-		_targetDist = STANDOFF_DIST;
-	}
-	else
-	{
-		_targetDist = min * 8;
-	}
+	drawCraftShield();
 }
 
 /**
- * Sets the craft to the distance relevant for aggressive attack.
+ * Redraws the craft damage.
  */
-void DogfightState::aggressiveDistance()
+void DogfightState::craftDamaged()
 {
-	maximumDistance();
-	if (_targetDist > AGGRESSIVE_DIST)
-	{
-		_targetDist = AGGRESSIVE_DIST;
-	}
+	drawCraftDamage();
 }
 
 /**
- * Updates the status text and restarts
- * the text timeout counter.
- * @param status New status text.
+ * Turns the minimize button into the self-destruct button.
  */
-void DogfightState::setStatus(const std::string &status)
+void DogfightState::craftDefenseless()
 {
-	_txtStatus->setText(tr(status));
-	_timeout = 50;
+	int offset = _game->getMod()->getInterface("dogfight")->getElement("minimizeButtonDummy")->TFTDMode ? 1 : 0;
+	_btnMinimize->drawRect(1 + offset, 1, _btnMinimize->getWidth() - 2 - offset, _btnMinimize->getHeight() - 2, _colors[DAMAGE_MAX]);
+	_btnMinimize->setVisible(true);
 }
 
 /**
@@ -1895,29 +835,25 @@ void DogfightState::setStatus(const std::string &status)
  */
 void DogfightState::btnMinimizeClick(Action *)
 {
-	if (_craftIsDefenseless)
+	if (_sim->isCraftDefenseless())
 	{
-		_selfDestructPressed = !_selfDestructPressed;
-		if (_selfDestructPressed)
-			setStatus("STR_SELF_DESTRUCT_ACTIVATED");
-		else
-			setStatus("STR_SELF_DESTRUCT_CANCELLED");
+		_sim->toggleSelfDestruct();
 		int offset = _game->getMod()->getInterface("dogfight")->getElement("minimizeButtonDummy")->TFTDMode ? 1 : 0;
-		int color = _selfDestructPressed ? DAMAGE_MIN : DAMAGE_MAX;
+		int color = _sim->isSelfDestructPressed() ? DAMAGE_MIN : DAMAGE_MAX;
 		_btnMinimize->drawRect(1 + offset, 1, _btnMinimize->getWidth() - 2 - offset, _btnMinimize->getHeight() - 2, _colors[color]);
 		return;
 	}
 
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
+	if (_sim->canChangeMode())
 	{
-		if (_currentDist >= STANDOFF_DIST)
+		if (_sim->getCurrentDist() >= STANDOFF_DIST)
 		{
 			setMinimized(true);
 			_ufo->setShieldRechargeHandle(0);
 		}
 		else
 		{
-			setStatus("STR_MINIMISE_AT_STANDOFF_RANGE_ONLY");
+			_sim->setStatus("STR_MINIMISE_AT_STANDOFF_RANGE_ONLY");
 		}
 	}
 }
@@ -1928,12 +864,7 @@ void DogfightState::btnMinimizeClick(Action *)
  */
 void DogfightState::btnStandoffPress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
-	{
-		_end = false;
-		setStatus("STR_STANDOFF");
-		_targetDist = STANDOFF_DIST;
-	}
+	_sim->setMode(DFM_STANDOFF);
 }
 
 void DogfightState::btnStandoffRightPress(Action *)
@@ -1955,38 +886,7 @@ void DogfightState::btnStandoffSimulateLeftPress(Action *action)
  */
 void DogfightState::btnCautiousPress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
-	{
-		_end = false;
-		if (!_ufoIsAttacking)
-		{
-			setStatus("STR_CAUTIOUS_ATTACK");
-			for (int i = 0; i < _weaponNum; ++i)
-			{
-				CraftWeapon* w = _craft->getWeapons()->at(i);
-				if (w != 0)
-				{
-					_weaponFireInterval[i] = w->getRules()->getCautiousReload();
-				}
-			}
-			minimumDistance();
-		}
-		else
-		{
-			setStatus("STR_EVASIVE_MANEUVERS");
-			for (int i = 0; i < _weaponNum; ++i)
-			{
-				CraftWeapon* w = _craft->getWeapons()->at(i);
-				if (w != 0)
-				{
-					// double the craft's reload time to balance halving the HK's chance to hit
-					_weaponFireInterval[i] = w->getRules()->getAggressiveReload() * 2;
-				}
-			}
-			// same distance as aggressive (by design)
-			aggressiveDistance();
-		}
-	}
+	_sim->setMode(DFM_CAUTIOUS);
 }
 
 void DogfightState::btnCautiousRightPress(Action *)
@@ -2008,20 +908,7 @@ void DogfightState::btnCautiousSimulateLeftPress(Action *action)
  */
 void DogfightState::btnStandardPress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
-	{
-		_end = false;
-		setStatus("STR_STANDARD_ATTACK");
-		for (int i = 0; i < _weaponNum; ++i)
-		{
-			CraftWeapon* w = _craft->getWeapons()->at(i);
-			if (w != 0)
-			{
-				_weaponFireInterval[i] = w->getRules()->getStandardReload();
-			}
-		}
-		maximumDistance();
-	}
+	_sim->setMode(DFM_STANDARD);
 }
 
 void DogfightState::btnStandardRightPress(Action *)
@@ -2043,20 +930,7 @@ void DogfightState::btnStandardSimulateLeftPress(Action *action)
  */
 void DogfightState::btnAggressivePress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
-	{
-		_end = false;
-		setStatus("STR_AGGRESSIVE_ATTACK");
-		for (int i = 0; i < _weaponNum; ++i)
-		{
-			CraftWeapon* w = _craft->getWeapons()->at(i);
-			if (w != 0)
-			{
-				_weaponFireInterval[i] = w->getRules()->getAggressiveReload();
-			}
-		}
-		aggressiveDistance();
-	}
+	_sim->setMode(DFM_AGGRESSIVE);
 }
 
 void DogfightState::btnAggressiveRightPress(Action *)
@@ -2078,12 +952,7 @@ void DogfightState::btnAggressiveSimulateLeftPress(Action *action)
  */
 void DogfightState::btnDisengagePress(Action *)
 {
-	if (!_ufo->isCrashed() && !_craft->isDestroyed() && !_ufoBreakingOff)
-	{
-		_end = true;
-		setStatus("STR_DISENGAGING");
-		_targetDist = 800;
-	}
+	_sim->setMode(DFM_DISENGAGE);
 }
 
 void DogfightState::btnDisengageRightPress(Action *)
@@ -2128,13 +997,13 @@ void DogfightState::previewClick(Action *)
 {
 	_preview->setVisible(false);
 	// Reenable all other buttons to prevent misclicks
-	_btnStandoff->setVisible(!_ufoIsAttacking);
-	_btnCautious->setVisible(!_disableCautious);
-	_btnStandard->setVisible(!_ufoIsAttacking);
+	_btnStandoff->setVisible(!_sim->isUfoAttacking());
+	_btnCautious->setVisible(!_sim->isCautiousDisabled());
+	_btnStandard->setVisible(!_sim->isUfoAttacking());
 	_btnAggressive->setVisible(true);
-	_btnDisengage->setVisible(!_disableDisengage);
+	_btnDisengage->setVisible(!_sim->isDisengageDisabled());
 	_btnUfo->setVisible(true);
-	_btnMinimize->setVisible(!_ufoIsAttacking || _craftIsDefenseless);
+	_btnMinimize->setVisible(!_sim->isUfoAttacking() || _sim->isCraftDefenseless());
 	for (int i = 0; i < _weaponNum; ++i)
 	{
 		_weapon[i]->setVisible(true);
@@ -2148,17 +1017,17 @@ void DogfightState::previewClick(Action *)
  */
 void DogfightState::drawUfo()
 {
-	if (_ufoSize < 0 || _ufo->isDestroyed())
+	if (_sim->getUfoSize() < 0 || _ufo->isDestroyed())
 	{
 		return;
 	}
 	int currentUfoXposition =  _battle->getWidth() / 2 - 6;
-	int currentUfoYposition = _battle->getHeight() - (_currentDist / 8) - 6;
+	int currentUfoYposition = _battle->getHeight() - (_sim->getCurrentDist() / 8) - 6;
 	for (int y = 0; y < 13; ++y)
 	{
 		for (int x = 0; x < 13; ++x)
 		{
-			Uint8 pixelOffset = _ufoBlobs[_ufoSize + _ufo->getHitFrame()][y][x];
+			Uint8 pixelOffset = _ufoBlobs[_sim->getUfoSize() + _ufo->getHitFrame()][y][x];
 			if (pixelOffset == 0)
 			{
 				continue;
@@ -2239,7 +1108,7 @@ void DogfightState::drawProjectile(const CraftWeaponProjectile* p)
 	else if (p->getGlobalType() == CWPGT_BEAM)
 	{
 		int yStart = _battle->getHeight() - 2;
-		int yEnd = _battle->getHeight() - (_currentDist / 8);
+		int yEnd = _battle->getHeight() - (_sim->getCurrentDist() / 8);
 		Uint8 pixelOffset = p->getState();
 		for (int y = yStart; y > yEnd; --y)
 		{
@@ -2279,15 +1148,15 @@ void DogfightState::weaponClick(Action * a)
 	{
 		if (a->getSender() == _weapon[i])
 		{
-			_weaponEnabled[i] = !_weaponEnabled[i];
-			recolor(i, _weaponEnabled[i]);
+			_sim->setWeaponEnabled(i, !_sim->isWeaponEnabled(i));
+			recolor(i, _sim->isWeaponEnabled(i));
 
 			if (Options::oxceRememberDisabledCraftWeapons)
 			{
 				CraftWeapon* w = _craft->getWeapons()->at(i);
 				if (w)
 				{
-					w->setDisabled(!_weaponEnabled[i]);
+					w->setDisabled(!_sim->isWeaponEnabled(i));
 				}
 			}
 			return;
@@ -2326,7 +1195,7 @@ void DogfightState::recolor(const int weaponNo, const bool currentState)
  */
 bool DogfightState::isMinimized() const
 {
-	return _minimized;
+	return _sim->isMinimized();
 }
 
 /**
@@ -2335,8 +1204,15 @@ bool DogfightState::isMinimized() const
  */
 void DogfightState::setMinimized(const bool minimized)
 {
+	// the window only follows the dogfight while it's shown
+	_sim->setMinimized(minimized);
+	_sim->setView(minimized ? 0 : this);
+	if (!minimized)
+	{
+		statusChanged(_sim->getStatus());
+	}
+
 	// set these to the same as the incoming minimized state
-	_minimized = minimized;
 	_btnMinimizedIcon->setVisible(minimized);
 	_txtInterceptionNumber->setVisible(minimized);
 
@@ -2394,7 +1270,7 @@ void DogfightState::btnMinimizedIconClick(Action *)
  */
 void DogfightState::setInterceptionNumber(const int number)
 {
-	_interceptionNumber = number;
+	_sim->setInterceptionNumber(number);
 }
 
 /**
@@ -2414,8 +1290,9 @@ void DogfightState::setInterceptionsCount(const size_t count)
  */
 void DogfightState::calculateWindowPosition()
 {
+	int interceptionNumber = _sim->getInterceptionNumber();
 	_minimizedIconX = 5;
-	_minimizedIconY = (5 * _interceptionNumber) + (16 * (_interceptionNumber - 1));
+	_minimizedIconY = (5 * interceptionNumber) + (16 * (interceptionNumber - 1));
 
 	if (_interceptionsCount == 1)
 	{
@@ -2424,7 +1301,7 @@ void DogfightState::calculateWindowPosition()
 	}
 	else if (_interceptionsCount == 2)
 	{
-		if (_interceptionNumber == 1)
+		if (interceptionNumber == 1)
 		{
 			_x = 80;
 			_y = 0;
@@ -2438,12 +1315,12 @@ void DogfightState::calculateWindowPosition()
 	}
 	else if (_interceptionsCount == 3)
 	{
-		if (_interceptionNumber == 1)
+		if (interceptionNumber == 1)
 		{
 			_x = 80;
 			_y = 0;
 		}
-		else if (_interceptionNumber == 2)
+		else if (interceptionNumber == 2)
 		{
 			_x = 0;
 			//_y = (_game->getScreen()->getHeight() / 2) - 96;
@@ -2459,18 +1336,18 @@ void DogfightState::calculateWindowPosition()
 	}
 	else
 	{
-		if (_interceptionNumber == 1)
+		if (interceptionNumber == 1)
 		{
 			_x = 0;
 			_y = 0;
 		}
-		else if (_interceptionNumber == 2)
+		else if (interceptionNumber == 2)
 		{
 			//_x = (_game->getScreen()->getWidth() / 2) - 160;
 			_x = 320 - _window->getWidth();//160;
 			_y = 0;
 		}
-		else if (_interceptionNumber == 3)
+		else if (interceptionNumber == 3)
 		{
 			_x = 0;
 			//_y = (_game->getScreen()->getHeight() / 2) - 96;
@@ -2512,7 +1389,7 @@ void DogfightState::moveWindow()
  */
 bool DogfightState::dogfightEnded() const
 {
-	return _endDogfight;
+	return _sim->dogfightEnded();
 }
 
 /**
@@ -2533,34 +1410,13 @@ Craft *DogfightState::getCraft() const
 	return _craft;
 }
 
-/**
- * Ends the dogfight.
- */
-void DogfightState::endDogfight()
-{
-	if (_endDogfight)
-		return;
-	if (_craft)
-	{
-		_craft->setInDogfight(false);
-		_craft->setInterceptionOrder(0);
-	}
-	// set the ufo as "free" for the next engagement (as applicable)
-	if (_ufo)
-	{
-		_ufo->setInterceptionProcessed(false);
-		_ufo->setShieldRechargeHandle(0);
-	}
-	_endDogfight = true;
-}
-
 /**
  * Returns interception number.
  * @return interception number
  */
 int DogfightState::getInterceptionNumber() const
 {
-	return _interceptionNumber;
+	return _sim->getInterceptionNumber();
 }
 
 void DogfightState::setWaitForPoly(bool wait)
@@ -2583,41 +1439,12 @@ bool DogfightState::getWaitForAltitude() const
 	return _waitForAltitude;
 }
 
+/**
+ * Awards experience to the pilots once the UFO went down.
+ */
 void DogfightState::awardExperienceToPilots()
 {
-	if (_firedAtLeastOnce && !_experienceAwarded && _craft && _ufo && (_ufo->isCrashed() || _ufo->isDestroyed()))
-	{
-		bool psiStrengthEval = (Options::psiStrengthEval && _game->getSavedGame()->isResearched(_game->getMod()->getPsiRequirements()));
-		for (auto* pilot : _craft->getPilotList(false))
-		{
-			if (pilot->getCurrentStats()->firing < pilot->getRules()->getStatCaps().firing)
-			{
-				if (RNG::percent(pilot->getRules()->getDogfightExperience().firing))
-				{
-					pilot->getCurrentStatsEditable()->firing++;
-					pilot->getDailyDogfightExperienceCache()->firing++;
-				}
-			}
-			if (pilot->getCurrentStats()->reactions < pilot->getRules()->getStatCaps().reactions)
-			{
-				if (RNG::percent(pilot->getRules()->getDogfightExperience().reactions))
-				{
-					pilot->getCurrentStatsEditable()->reactions++;
-					pilot->getDailyDogfightExperienceCache()->reactions++;
-				}
-			}
-			if (pilot->getCurrentStats()->bravery < pilot->getRules()->getStatCaps().bravery)
-			{
-				if (RNG::percent(pilot->getRules()->getDogfightExperience().bravery))
-				{
-					pilot->getCurrentStatsEditable()->bravery += 10; // increase by 10 to keep OCD at bay
-					pilot->getDailyDogfightExperienceCache()->bravery += 10;
-				}
-			}
-			pilot->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
-		}
-		_experienceAwarded = true;
-	}
+	_sim->awardExperienceToPilots();
 }
 
 }
@@ -18,15 +18,12 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../Engine/State.h"
-#include "../Mod/RuleCraft.h"
-#include <vector>
+#include "DogfightSimulation.h"
 #include <string>
 
 namespace OpenXcom
 {
 
-const int STANDOFF_DIST = 560;
-const int AGGRESSIVE_DIST = 64;
 enum ColorNames { CRAFT_MIN, CRAFT_MAX, RADAR_MIN, RADAR_MAX, DAMAGE_MIN, DAMAGE_MAX, BLOB_MIN, RANGE_METER, DISABLED_WEAPON, DISABLED_AMMO, DISABLED_RANGE, SHIELD_MIN, SHIELD_MAX };
 
 class ImageButton;
@@ -43,7 +40,7 @@ class CraftWeaponProjectile;
  * Shows a dogfight (interception) between a
  * player craft and an UFO.
  */
-class DogfightState : public State
+class DogfightState : public State, public DogfightView
 {
 private:
 	GeoscapeState *_state;
@@ -54,27 +51,19 @@ private:
 	ImageButton *_mode;
 	InteractiveSurface *_btnMinimizedIcon;
 	Text *_txtAmmo[RuleCraft::WeaponMax], *_txtDistance, *_txtStatus, *_txtInterceptionNumber;
+	DogfightSimulation *_sim;
 	Craft *_craft;
 	Ufo *_ufo;
-	bool _ufoIsAttacking, _disableDisengage, _disableCautious, _craftIsDefenseless, _selfDestructPressed;
-	int _timeout, _currentDist, _targetDist, _weaponFireInterval[RuleCraft::WeaponMax], _weaponFireCountdown[RuleCraft::WeaponMax];
-	bool _end, _endUfoHandled, _endCraftHandled, _ufoBreakingOff, _destroyUfo, _destroyCraft, _weaponEnabled[RuleCraft::WeaponMax];
-	bool _minimized, _endDogfight, _animatingHit, _waitForPoly, _waitForAltitude;
-	std::vector<CraftWeaponProjectile*> _projectiles;
+	bool _waitForPoly, _waitForAltitude;
 	static const int _ufoBlobs[8][13][13];
 	static const int _projectileBlobs[4][6][3];
-	int _ufoSize, _craftHeight, _currentCraftDamageColor, _interceptionNumber;
+	int _craftHeight, _currentCraftDamageColor;
 	size_t _interceptionsCount;
 	int _x, _y, _minimizedIconX, _minimizedIconY;
 	int _weaponNum;
-	int _pilotAccuracyBonus, _pilotDodgeBonus, _pilotApproachSpeedModifier, _craftAccelerationBonus;
-	bool _firedAtLeastOnce, _experienceAwarded;
 	bool _delayedRecolorDone;
 	// craft min/max, radar min/max, damage min/max, shield min/max
 	int _colors[13];
-	// Ends the dogfight.
-	void endDogfight();
-	bool _tractorLockedOn[RuleCraft::WeaponMax];
 
 public:
 	/// Creates the Dogfight state.
@@ -86,21 +75,19 @@ public:
 	/// Runs the timers.
 	void think() override;
 	/// Animates the window.
-	void animate();
-	/// Moves the craft.
-	void update();
-	// Fires the weapons.
-	void fireWeapon(int i);
-	// Fires UFO weapon.
-	void ufoFireWeapon();
-	// Sets the craft to minimum distance.
-	void minimumDistance();
-	// Sets the craft to maximum distance.
-	void maximumDistance();
-	// Sets the craft to maximum distance or 8 km, whichever is smaller.
-	void aggressiveDistance();
+	void drawFrame() override;
 	/// Changes the status text.
-	void setStatus(const std::string &status);
+	void statusChanged(const std::string &status) override;
+	/// Changes the distance text.
+	void distanceChanged(int distance) override;
+	/// Changes the ammo text of a weapon.
+	void ammoChanged(int weapon, int ammo) override;
+	/// Redraws the craft shield.
+	void craftShieldChanged() override;
+	/// Redraws the craft damage.
+	void craftDamaged() override;
+	/// Shows the self-destruct button.
+	void craftDefenseless() override;
 	/// Handler for clicking the Minimize button.
 	void btnMinimizeClick(Action *action);
 	/// Handler for pressing the Standoff button.
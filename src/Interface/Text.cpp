@@ -316,10 +316,26 @@ void Text::processText()
 		return;
 	}
 
+	_scrollY = 0;
+
+	// Only wrapped text depends on the width and wrapping settings
+	FontLayoutKey key;
+	key.text = _text;
+	key.width = _wrap ? getWidth() : 0;
+	key.small = _small;
+	key.flags = _wrap ? (1 | (_indent ? 2 : 0) | (_ignoreSeparators ? 4 : 0) | (_lang->getTextWrapping() << 3)) : 0;
+	if (const FontTextLayout *layout = _font->findLayout(key))
+	{
+		_processedText = layout->text;
+		_lineWidth = layout->lineWidth;
+		_lineHeight = layout->lineHeight;
+		_redraw = true;
+		return;
+	}
+
 	_processedText = Unicode::convUtf8ToUtf32(_text);
 	_lineWidth.clear();
 	_lineHeight.clear();
-	_scrollY = 0;
 
 	int width = 0, word = 0;
 	size_t space = 0, textIndentation = 0;
@@ -421,6 +437,7 @@ void Text::processText()
 		}
 	}
 
+	_font->storeLayout(std::move(key), FontTextLayout{ _processedText, _lineWidth, _lineHeight });
 	_redraw = true;
 }
 
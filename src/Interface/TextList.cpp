@@ -155,6 +155,11 @@ void TextList::unpress(State *state)
  */
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
+	if (_texts[row].empty())
+	{
+		// virtual row out of view
+		return;
+	}
 	_texts[row][column]->setColor(color);
 	_redraw = true;
 }
@@ -181,6 +186,13 @@ void TextList::setRowColor(size_t row, Uint8 color)
  */
 std::string TextList::getCellText(size_t row, size_t column) const
 {
+	if (_texts[row].empty() && _rowProvider)
+	{
+		TextListRow virtualRow;
+		virtualRow.color = _color;
+		_rowProvider(row, virtualRow);
+		return column < virtualRow.cells.size() ? virtualRow.cells[column] : std::string();
+	}
 	return _texts[row][column]->getText();
 }
 
@@ -192,6 +204,11 @@ std::string TextList::getCellText(size_t row, size_t column) const
  */
 void TextList::setCellText(size_t row, size_t column, const std::string &text)
 {
+	if (_texts[row].empty())
+	{
+		// virtual row out of view
+		return;
+	}
 	_texts[row][column]->setText(text);
 	_redraw = true;
 }
@@ -203,7 +220,8 @@ void TextList::setCellText(size_t row, size_t column, const std::string &text)
  */
 int TextList::getColumnX(size_t column) const
 {
-	return getX() + _texts[0][column]->getX();
+	// the first rows of a virtual list might not exist
+	return getX() + _texts[_rowProvider ? _scroll : 0][column]->getX();
 }
 
 /**
@@ -213,6 +231,11 @@ int TextList::getColumnX(size_t column) const
  */
 int TextList::getRowY(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		// virtual row out of view, placed where it would be created
+		return getY() + (int)row * (_font->getHeight() + _font->getSpacing());
+	}
 	return getY() + _texts[row][0]->getY();
 }
 
@@ -223,6 +246,11 @@ int TextList::getRowY(size_t row) const
  */
 int TextList::getTextHeight(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		// virtual rows are always one line
+		return _font->getCharSize('\n').h;
+	}
 	return _texts[row].front()->getTextHeight();
 }
 
@@ -233,6 +261,11 @@ int TextList::getTextHeight(size_t row) const
  */
 int TextList::getNumTextLines(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		// virtual rows are always one line
+		return 1;
+	}
 	return _texts[row].front()->getNumLines();
 }
 
@@ -273,16 +306,17 @@ size_t TextList::getVisibleRows() const
 }
 
 /**
- * Adds a new row of text to the list, automatically creating
- * the required Text objects lined up where they need to be.
- * @param cols Number of columns.
- * @param ... Text for each cell in the new row.
+ * Creates the Text objects for a row of the list,
+ * lined up where they need to be.
+ * @param cols Number of columns, 0 for a single empty cell.
+ * @param cells Text for each cell.
+ * @param rowY Y position of the row, relative to the list.
+ * @param rows Returns the number of lines the row takes when wrapped.
+ * @return The texts of the row.
  */
-void TextList::addRow(int cols, ...)
+std::vector<Text*> TextList::createRow(int cols, const std::vector<std::string> &cells, int rowY, int &rows)
 {
-	va_list args;
 	int ncols;
-	va_start(args, cols);
 	if (cols > 0)
 	{
 		ncols = cols;
@@ -294,11 +328,8 @@ void TextList::addRow(int cols, ...)
 
 	std::vector<Text*> temp;
 	// Positions are relative to list surface.
-	int rowX = 0, rowY = 0, rows = 1, rowHeight = 0;
-	if (!_texts.empty())
-	{
-		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
-	}
+	int rowX = 0, rowHeight = 0;
+	rows = 1;
 
 	for (int i = 0; i < ncols; ++i)
 	{
@@ -331,12 +362,12 @@ void TextList::addRow(int cols, ...)
 			txt->setSmall();
 		}
 		if (cols > 0)
-			txt->setText(va_arg(args, char*));
+			txt->setText(cells[i]);
 		// grab this before we enable word wrapping so we can use it to calculate
 		// the total row height below
 		int vmargin = _font->getHeight() - txt->getTextHeight();
-		// Wordwrap text if necessary
-		if (_wrap && txt->getTextWidth() > txt->getWidth())
+		// Wordwrap text if necessary, rows of a virtual list are always one line
+		if (_wrap && !_rowProvider && txt->getTextWidth() > txt->getWidth())
 		{
 			txt->setWordWrap(true, true, _ignoreSeparators);
 			rows = std::max(rows, txt->getNumLines());
@@ -380,49 +411,182 @@ void TextList::addRow(int cols, ...)
 	{
 		temp[i]->setHeight(rowHeight);
 	}
+	return temp;
+}
+
+/**
+ * Creates the arrow buttons for another row.
+ * Position defined w.r.t. main window, NOT TextList.
+ */
+void TextList::addArrows()
+{
+	ArrowShape shape1, shape2;
+	if (_arrowType == ARROW_VERTICAL)
+	{
+		shape1 = ARROW_SMALL_UP;
+		shape2 = ARROW_SMALL_DOWN;
+	}
+	else
+	{
+		shape1 = ARROW_SMALL_LEFT;
+		shape2 = ARROW_SMALL_RIGHT;
+	}
+	ArrowButton *a1 = new ArrowButton(shape1, 11, 8, getX() + _arrowPos, getY());
+	a1->setListButton();
+	a1->setPalette(this->getPalette());
+	a1->setColor(_up->getColor());
+	a1->onMouseClick(_leftClick, 0);
+	a1->onMousePress(_leftPress);
+	a1->onMouseRelease(_leftRelease);
+	_arrowLeft.push_back(a1);
+	ArrowButton *a2 = new ArrowButton(shape2, 11, 8, getX() + _arrowPos + 12, getY());
+	a2->setListButton();
+	a2->setPalette(this->getPalette());
+	a2->setColor(_up->getColor());
+	a2->onMouseClick(_rightClick, 0);
+	a2->onMousePress(_rightPress);
+	a2->onMouseRelease(_rightRelease);
+	_arrowRight.push_back(a2);
+}
+
+/**
+ * Gets the arrow buttons used by a row. A virtual list
+ * only has enough of them for the visible rows and
+ * cycles through them as it scrolls.
+ * @param row Row number.
+ * @return Index of the row's arrow buttons.
+ */
+size_t TextList::getArrowIndex(size_t row) const
+{
+	if (_rowProvider)
+	{
+		return row % std::max(_visibleRows, (size_t)1);
+	}
+	return row;
+}
 
-	_texts.push_back(temp);
+/**
+ * Adds a new row of text to the list, automatically creating
+ * the required Text objects lined up where they need to be.
+ * @param cols Number of columns.
+ * @param ... Text for each cell in the new row.
+ */
+void TextList::addRow(int cols, ...)
+{
+	va_list args;
+	va_start(args, cols);
+	std::vector<std::string> cells;
+	for (int i = 0; i < cols; ++i)
+	{
+		cells.push_back(va_arg(args, char*));
+	}
+	va_end(args);
+
+	int rowY = 0, rows = 1;
+	if (!_texts.empty())
+	{
+		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+	}
+	_texts.push_back(createRow(cols, cells, rowY, rows));
 	for (int i = 0; i < rows; ++i)
 	{
 		_rows.push_back(_texts.size() - 1);
 	}
 
 	// Place arrow buttons
-	// Position defined w.r.t. main window, NOT TextList.
 	if (_arrowPos != -1)
 	{
-		ArrowShape shape1, shape2;
-		if (_arrowType == ARROW_VERTICAL)
+		addArrows();
+	}
+
+	_redraw = true;
+	updateArrows();
+}
+
+/**
+ * Fills the list with rows that are only created while they're
+ * visible, so lists with thousands of entries don't need a Text
+ * for every cell. The rows are asked for again every time they
+ * scroll into view, call this again when their contents change.
+ * Word wrapping isn't supported, every row takes one line.
+ * Clearing the list ends the virtual mode.
+ * @param count Number of rows.
+ * @param provider Function that fills in the cells of a row.
+ */
+void TextList::setVirtualRows(size_t count, TextListRowProvider provider)
+{
+	size_t scroll = _scroll;
+	clearList();
+	_rowProvider = provider;
+	_texts.resize(count);
+	_rows.resize(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		_rows[i] = i;
+	}
+	if (count > _visibleRows)
+	{
+		_scroll = std::min(scroll, count - _visibleRows);
+	}
+	updateVirtualRows();
+	_redraw = true;
+	updateArrows();
+}
+
+/**
+ * Creates the texts of the virtual rows that are visible
+ * and deletes the ones that scrolled out of view.
+ */
+void TextList::updateVirtualRows()
+{
+	if (!_rowProvider)
+	{
+		return;
+	}
+	size_t first = _scroll;
+	size_t last = std::min(_texts.size(), _scroll + _visibleRows);
+	for (auto i = _liveRows.begin(); i != _liveRows.end();)
+	{
+		if (*i < first || *i >= last)
 		{
-			shape1 = ARROW_SMALL_UP;
-			shape2 = ARROW_SMALL_DOWN;
+			for (auto* text : _texts[*i])
+			{
+				delete text;
+			}
+			_texts[*i].clear();
+			i = _liveRows.erase(i);
 		}
 		else
 		{
-			shape1 = ARROW_SMALL_LEFT;
-			shape2 = ARROW_SMALL_RIGHT;
+			++i;
+		}
+	}
+	for (size_t i = first; i < last; ++i)
+	{
+		if (_texts[i].empty())
+		{
+			TextListRow row;
+			row.color = _color;
+			_rowProvider(i, row);
+			int rows;
+			_texts[i] = createRow(row.cells.size(), row.cells, i * (_font->getHeight() + _font->getSpacing()), rows);
+			if (row.color != _color)
+			{
+				for (auto* text : _texts[i])
+				{
+					text->setColor(row.color);
+				}
+			}
+			_liveRows.push_back(i);
+		}
+	}
+	if (_arrowPos != -1)
+	{
+		while (_arrowLeft.size() < _visibleRows)
+		{
+			addArrows();
 		}
-		ArrowButton *a1 = new ArrowButton(shape1, 11, 8, getX() + _arrowPos, getY());
-		a1->setListButton();
-		a1->setPalette(this->getPalette());
-		a1->setColor(_up->getColor());
-		a1->onMouseClick(_leftClick, 0);
-		a1->onMousePress(_leftPress);
-		a1->onMouseRelease(_leftRelease);
-		_arrowLeft.push_back(a1);
-		ArrowButton *a2 = new ArrowButton(shape2, 11, 8, getX() + _arrowPos + 12, getY());
-		a2->setListButton();
-		a2->setPalette(this->getPalette());
-		a2->setColor(_up->getColor());
-		a2->onMouseClick(_rightClick, 0);
-		a2->onMousePress(_rightPress);
-		a2->onMouseRelease(_rightRelease);
-		_arrowRight.push_back(a2);
 	}
-
-	_redraw = true;
-	va_end(args);
-	updateArrows();
 }
 
 /**
@@ -883,6 +1047,8 @@ void TextList::onRightArrowRelease(ActionHandler handler)
  */
 void TextList::clearList()
 {
+	_rowProvider = nullptr;
+	_liveRows.clear();
 	for (auto& vec : _texts)
 	{
 		for (auto* text : vec)
@@ -1005,6 +1171,7 @@ void TextList::setScrolling(bool scrolling, int scrollPos)
 void TextList::draw()
 {
 	Surface::draw();
+	updateVirtualRows();
 	int y = 0;
 	if (!_rows.empty())
 	{
@@ -1056,14 +1223,15 @@ void TextList::blit(SDL_Surface *surface)
 			int maxY = getY() + getHeight();
 			for (size_t i = _rows[_scroll]; i < _texts.size() && i < _rows[_scroll] + _visibleRows && y < maxY; ++i)
 			{
-				_arrowLeft[i]->setY(y);
-				_arrowRight[i]->setY(y);
+				size_t arrow = getArrowIndex(i);
+				_arrowLeft[arrow]->setY(y);
+				_arrowRight[arrow]->setY(y);
 
 				if (y >= getY())
 				{
 					// only blit arrows that belong to texts that have their first row on-screen
-					_arrowLeft[i]->blit(surface);
-					_arrowRight[i]->blit(surface);
+					_arrowLeft[arrow]->blit(surface);
+					_arrowRight[arrow]->blit(surface);
 				}
 
 				if (!_texts[i].empty())
@@ -1095,6 +1263,7 @@ void TextList::handle(Action *action, State *state)
 	_scrollbar->handle(action, state);
 	if (_arrowPos != -1 && !_rows.empty())
 	{
+		updateVirtualRows();
 		size_t startArrowIdx = _rows[_scroll];
 		if (0 < _scroll && _rows[_scroll] == _rows[_scroll - 1])
 		{
@@ -1112,8 +1281,8 @@ void TextList::handle(Action *action, State *state)
 		}
 		for (size_t i = startArrowIdx; i < endArrowIdx; ++i)
 		{
-			_arrowLeft[i]->handle(action, state);
-			_arrowRight[i]->handle(action, state);
+			_arrowLeft[getArrowIndex(i)]->handle(action, state);
+			_arrowRight[getArrowIndex(i)]->handle(action, state);
 		}
 	}
 }
@@ -19,6 +19,8 @@
  */
 #include <vector>
 #include <map>
+#include <string>
+#include <functional>
 #include "../Engine/InteractiveSurface.h"
 #include "Text.h"
 
@@ -27,6 +29,18 @@ namespace OpenXcom
 
 enum ArrowOrientation { ARROW_VERTICAL, ARROW_HORIZONTAL };
 
+/**
+ * Contents of a row of a virtual text list.
+ */
+struct TextListRow
+{
+	std::vector<std::string> cells;
+	Uint8 color;
+};
+
+/// Fills in the contents of a row of a virtual text list.
+typedef std::function<void(size_t row, TextListRow &out)> TextListRowProvider;
+
 class ArrowButton;
 class ComboBox;
 class ScrollBar;
@@ -60,7 +74,17 @@ private:
 	int _arrowsLeftEdge, _arrowsRightEdge;
 	int _noScrollLeftEdge, _noScrollRightEdge;
 	ComboBox *_comboBox;
+	TextListRowProvider _rowProvider;
+	std::vector<size_t> _liveRows;
 
+	/// Creates the texts of a row.
+	std::vector<Text*> createRow(int cols, const std::vector<std::string> &cells, int rowY, int &rows);
+	/// Creates the arrow buttons for another row.
+	void addArrows();
+	/// Gets the arrow buttons used by a row.
+	size_t getArrowIndex(size_t row) const;
+	/// Creates the visible rows of a virtual list.
+	void updateVirtualRows();
 	/// Updates the arrow buttons.
 	void updateArrows();
 	/// Updates the visible rows.
@@ -106,6 +130,8 @@ public:
 	size_t getVisibleRows() const;
 	/// Adds a new row to the text list.
 	void addRow(int cols, ...);
+	/// Fills the list with rows created on demand.
+	void setVirtualRows(size_t count, TextListRowProvider provider);
 	/// Removes the last row from the text list.
 	void removeLastRow();
 	/// Sets the columns in the text list.
@@ -20,6 +20,7 @@
 #include <sstream>
 #include "../Engine/Logger.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "../Engine/Game.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
@@ -166,6 +167,8 @@ void LoadGameState::think()
 		SavedGame *s = new SavedGame();
 		try
 		{
+			// it might be the one still being written
+			_game->getSaveWriter()->wait();
 			s->load(_filename, _game->getMod(), _game->getLanguage());
 			_game->setSavedGame(s);
 			if (_game->getSavedGame()->getEnding() != END_NONE)
@@ -229,7 +232,9 @@ void LoadGameState::error(const std::string &msg, SavedGame *save)
 	Log(LOG_ERROR) << msg;
 	std::ostringstream error;
 	error << tr("STR_LOAD_UNSUCCESSFUL") << Unicode::TOK_NL_SMALL << msg;
-	if (_origin != OPT_BATTLESCAPE)
+	if (!Options::getReplayBattle().empty())
+		_game->quit(); // no one is there to read it
+	else if (_origin != OPT_BATTLESCAPE)
 		_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
 	else
 		_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
@@ -29,11 +29,13 @@
 #include "NewGameState.h"
 #include "NewBattleState.h"
 #include "ListLoadState.h"
+#include "LoadGameState.h"
 #include "OptionsVideoState.h"
 #include "ModListState.h"
 #include "../Engine/Options.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/SDL2Helpers.h"
+#include "../Battlescape/BattleRecorder.h"
 #include <fstream>
 
 namespace OpenXcom
@@ -198,7 +200,21 @@ MainMenuState::MainMenuState(bool updateCheck)
 void MainMenuState::init()
 {
 	State::init();
-	if (Options::getLoadLastSave() && _game->getSavedGame()->getList(_game->getLanguage(), true).size() > 0)
+	if (!Options::getReplayBattle().empty())
+	{
+		// a replay loads its battle once, coming back here means it's over
+		if (Options::getReplayBattleExpended())
+		{
+			_game->quit();
+		}
+		else
+		{
+			Log(LOG_INFO) << "Replaying battle recording " << Options::getReplayBattle();
+			Options::expendReplayBattle();
+			_game->pushState(new LoadGameState(OPT_MENU, BattleRecorder::FOLDER + "/" + Options::getReplayBattle() + ".sav", _palette));
+		}
+	}
+	else if (Options::getLoadLastSave() && _game->getSavedGame()->getList(_game->getLanguage(), true).size() > 0)
 	{
 		Log(LOG_INFO) << "Loading last saved game";
 		btnLoadClick(NULL);
@@ -30,6 +30,7 @@
 #include "ErrorMessageState.h"
 #include "MainMenuState.h"
 #include "../Savegame/SavedGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleInterface.h"
 
@@ -168,13 +169,19 @@ void SaveGameState::think()
 		// Save the game
 		try
 		{
-			std::string backup = _filename + ".bak";
-			_game->getSavedGame()->save(backup, _game->getMod());
-			std::string fullPath = Options::getMasterUserFolder() + _filename;
-			std::string bakPath = Options::getMasterUserFolder() + backup;
-			if (!CrossPlatform::moveFile(bakPath, fullPath))
+			// copy the game here, write it out in the background
+			SaveWriter *writer = _game->getSaveWriter();
+			writer->save(_filename, _game->getSavedGame()->snapshot(_game->getMod()));
+			if (_type == SAVE_DEFAULT || _type == SAVE_IRONMAN_END)
 			{
-				throw Exception("Save backed up in " + backup);
+				// the player is waiting for it anyway
+				writer->wait();
+			}
+			// reports any save that failed so far, this one too if it's done
+			std::string writeError = writer->takeError();
+			if (!writeError.empty())
+			{
+				throw Exception(writeError);
 			}
 
 			if (_type == SAVE_IRONMAN_END)
@@ -100,12 +100,19 @@ SurfaceSet *MapDataSet::getSurfaceset() const
 
 /**
  * Loads terrain data in XCom format (MCD & PCK files).
+ * Safe to call from several threads, the late callers wait
+ * for the first one to finish.
  * @sa http://www.ufopaedia.org/index.php?title=MCD
+ * @param patch MCD patch to apply, if any.
+ * @param validate Log invalid MCD references.
+ * @return True if this call did the loading, false if it was already loaded.
  */
-void MapDataSet::loadData(MCDPatch *patch, bool validate)
+bool MapDataSet::loadData(MCDPatch *patch, bool validate)
 {
+	std::lock_guard<std::mutex> lock(_loadMutex);
+
 	// prevents loading twice
-	if (_loaded) return;
+	if (_loaded) return false;
 	_loaded = true;
 
 	int objNumber = 0;
@@ -245,6 +252,18 @@ void MapDataSet::loadData(MCDPatch *patch, bool validate)
 	// Load terrain sprites/surfaces/PCK files into a surfaceset
 	_surfaceSet = new SurfaceSet(32, 40);
 	_surfaceSet->loadPck("TERRAIN/" + _name + ".PCK", "TERRAIN/" + _name + ".TAB");
+	return true;
+}
+
+/**
+ * Checks if the terrain data is loaded,
+ * waiting for any load in progress.
+ * @return True if loaded.
+ */
+bool MapDataSet::isLoaded() const
+{
+	std::lock_guard<std::mutex> lock(_loadMutex);
+	return _loaded;
 }
 
 /**
@@ -252,6 +271,7 @@ void MapDataSet::loadData(MCDPatch *patch, bool validate)
  */
 void MapDataSet::unloadData()
 {
+	std::lock_guard<std::mutex> lock(_loadMutex);
 	if (_loaded)
 	{
 		for (auto* mapdata : _objects)
@@ -260,6 +280,7 @@ void MapDataSet::unloadData()
 		}
 		_objects.clear();
 		delete _surfaceSet;
+		_surfaceSet = 0;
 		_loaded = false;
 	}
 }
@@ -19,6 +19,7 @@
  */
 #include <string>
 #include <vector>
+#include <mutex>
 #include <SDL.h>
 #include <yaml-cpp/yaml.h>
 #include "../Mod/MCDPatch.h"
@@ -42,6 +43,7 @@ private:
 	std::vector<MapData*> _objects;
 	SurfaceSet *_surfaceSet;
 	bool _loaded;
+	mutable std::mutex _loadMutex;
 	static MapData *_blankTile;
 	static MapData *_scorchedTile;
 public:
@@ -60,7 +62,9 @@ public:
 	/// Gets the surfaces in this dataset.
 	SurfaceSet *getSurfaceset() const;
 	/// Loads the objects from an MCD file.
-	void loadData(MCDPatch *patch, bool validate = true);
+	bool loadData(MCDPatch *patch, bool validate = true);
+	/// Checks if the data is loaded.
+	bool isLoaded() const;
 	///	Unloads to free memory.
 	void unloadData();
 	/// Gets a blank floor tile.
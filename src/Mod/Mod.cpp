@@ -2167,6 +2167,31 @@ void Mod::loadAll()
 	afterLoadHelper("craftWeapons", this, _craftWeapons, &RuleCraftWeapon::afterLoad);
 	afterLoadHelper("countries", this, _countries, &RuleCountry::afterLoad);
 
+	// number the research topics in the order of the research map, so saves can keep them in bit sets
+	{
+		int researchIndex = 0;
+		for (auto& r : _research)
+		{
+			r.second->setIndex(researchIndex++);
+		}
+		// and link each topic to the ones its discovery can make available
+		for (auto& r : _research)
+		{
+			for (const auto* dep : r.second->getDependencies())
+			{
+				getResearch(dep->getName())->addDependent(r.second);
+			}
+			for (const auto* req : r.second->getRequirements())
+			{
+				getResearch(req->getName())->addDependent(r.second);
+			}
+			for (const auto* unl : r.second->getUnlocked())
+			{
+				r.second->addDependent(getResearch(unl->getName()));
+			}
+		}
+	}
+
 	for (auto& a : _armors)
 	{
 		if (a.second->hasInfiniteSupply())
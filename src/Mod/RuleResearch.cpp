@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "RuleResearch.h"
+#include <algorithm>
 #include "../Engine/Exception.h"
 #include "../Engine/Collections.h"
 #include "../Engine/ScriptBind.h"
@@ -25,7 +26,7 @@
 namespace OpenXcom
 {
 
-RuleResearch::RuleResearch(const std::string &name, int listOrder) : _name(name), _spawnedItemCount(1), _cost(0), _points(0), _sequentialGetOneFree(false), _needItem(false), _destroyItem(false), _unlockFinalMission(false), _listOrder(listOrder)
+RuleResearch::RuleResearch(const std::string &name, int listOrder) : _name(name), _spawnedItemCount(1), _cost(0), _points(0), _sequentialGetOneFree(false), _needItem(false), _destroyItem(false), _unlockFinalMission(false), _listOrder(listOrder), _index(-1)
 {
 }
 
@@ -114,6 +115,19 @@ void RuleResearch::afterLoad(const Mod* mod)
 	Collections::removeAll(_getOneFreeProtectedName);
 }
 
+/**
+ * Adds a topic that can become available when this one is discovered,
+ * because this one is among its dependencies or requirements, or unlocks it.
+ * @param research The topic.
+ */
+void RuleResearch::addDependent(RuleResearch *research)
+{
+	if (std::find(_dependents.begin(), _dependents.end(), research) == _dependents.end())
+	{
+		_dependents.push_back(research);
+	}
+}
+
 /**
  * Gets the cost of this ResearchProject.
  * @return The cost of this ResearchProject (in man/day).
@@ -51,11 +51,13 @@ class RuleResearch
 	std::vector<std::string> _dependenciesName, _unlocksName, _disablesName, _reenablesName, _getOneFreeName, _requiresName;
 	RuleBaseFacilityFunctions _requiresBaseFunc;
 	std::vector<const RuleResearch*> _dependencies, _unlocks, _disables, _reenables, _getOneFree, _requires;
+	std::vector<RuleResearch*> _dependents;
 	bool _sequentialGetOneFree;
 	std::vector<std::pair<std::string, std::vector<std::string> > > _getOneFreeProtectedName;
 	std::vector<std::pair<const RuleResearch*, std::vector<const RuleResearch*> > > _getOneFreeProtected;
 	bool _needItem, _destroyItem, _unlockFinalMission;
 	int _listOrder;
+	int _index;
 
 	ScriptValues<RuleResearch> _scriptValues;
 public:
@@ -108,6 +110,14 @@ public:
 	RuleBaseFacilityFunctions getRequireBaseFunc() const { return _requiresBaseFunc; }
 	/// Gets the list weight for this research item.
 	int getListOrder() const;
+	/// Gets the dense index of this research item, see Mod::getResearchMap().
+	int getIndex() const { return _index; }
+	/// Sets the dense index of this research item.
+	void setIndex(int index) { _index = index; }
+	/// Gets the topics that discovering this one can make available.
+	const std::vector<RuleResearch*> &getDependents() const { return _dependents; }
+	/// Adds a topic that discovering this one can make available.
+	void addDependent(RuleResearch *research);
 	/// Gets the cutscene to play when this item is researched
 	const std::string & getCutscene() const;
 	/// Gets the item to spawn in the base stores when this topic is researched.
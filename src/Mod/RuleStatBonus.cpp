@@ -153,6 +153,20 @@ constexpr size_t statDataFuncSize = 4;
 constexpr size_t statMultiper = 1000;
 constexpr const char* statNamePostfix = "BonusStats";
 
+/**
+ * Evaluates the polynomial of a stat, coefficients past the degree are zero.
+ * Skipping the leading zero coefficients gives the same result as going through them.
+ */
+inline float statPolynomial(float stat, const int *pow, int degree)
+{
+	float bonus = 0;
+	for (int j = degree; j > 0; --j)
+	{
+		bonus += pow[j - 1]; bonus *= stat;
+	}
+	return bonus;
+}
+
 template<BonusStatFunc Func>
 struct getBonusStatsScript
 {
@@ -160,13 +174,8 @@ struct getBonusStatsScript
 	{
 		if (bu)
 		{
-			const float stat = Func(bu);
-			float bonus = 0;
-			bonus += pow4; bonus *= stat;
-			bonus += pow3; bonus *= stat;
-			bonus += pow2; bonus *= stat;
-			bonus += pow1; bonus *= stat;
-			ret += bonus / statMultiper;
+			const int pow[statDataFuncSize] = { pow1, pow2, pow3, pow4 };
+			ret += statPolynomial(Func(bu), pow, statDataFuncSize) / statMultiper;
 		}
 		return RetContinue;
 	}
@@ -176,41 +185,53 @@ struct getBonusStatsScript
  * Data describing same functions but with different exponent.
  */
 using BonusStatDataFunc = void (*)(Bind<BattleUnit>& b, const std::string& name);
+/**
+ * Script binding and plain getter of a stat.
+ */
+struct BonusStatGetter
+{
+	BonusStatDataFunc bind;
+	BonusStatFunc stat;
+	bool flat;
+};
 /**
  * Data describing basic stat getter.
  */
 struct BonusStatData
 {
 	std::string name;
-	BonusStatDataFunc func;
+	BonusStatGetter getter;
 };
 
 /**
  * Helper function creating BonusStatData with proper functions.
  */
 template<BonusStatFunc Func>
-BonusStatDataFunc create()
+BonusStatGetter create()
 {
-	return [](Bind<BattleUnit>& b, const std::string& name)
+	BonusStatDataFunc bind = [](Bind<BattleUnit>& b, const std::string& name)
 	{
 		b.addFunc<getBonusStatsScript<Func>>(name + statNamePostfix, "add stat '" + name + "' transformed by polynomial (const arguments are coefficients), final result of polynomial is divided by " + std::to_string(statMultiper));
 	};
+	return { bind, Func, false };
 }
 
 /**
  * Helper function creating BonusStatData with proper functions.
  */
 template<int Val>
-BonusStatDataFunc create0()
+BonusStatGetter create0()
 {
-	return create<&stat0<Val> >();
+	BonusStatGetter getter = create<&stat0<Val> >();
+	getter.flat = true;
+	return getter;
 }
 
 /**
  * Helper function creating BonusStatData with proper functions.
  */
 template<UnitStats::Ptr fieldA>
-BonusStatDataFunc create1()
+BonusStatGetter create1()
 {
 	return create<&stat1<fieldA> >();
 }
@@ -219,7 +240,7 @@ BonusStatDataFunc create1()
  * Helper function creating BonusStatData with proper functions.
  */
 template<UnitStats::Ptr fieldA, UnitStats::Ptr fieldB>
-BonusStatDataFunc create2()
+BonusStatGetter create2()
 {
 	return create<&stat2<fieldA, fieldB> >();
 }
@@ -319,6 +340,8 @@ void RuleStatBonus::load(const std::string& parentName, const YAML::Node& node,
 			else if (stats.IsScalar())
 			{
 				_container.load(parentName, stats.as<std::string>(), parser);
+				_terms.clear();
+				_customScript = true;
 				_refresh = false;
 			}
 			// let's remember that this was modified by a modder (i.e. is not a default value)
@@ -326,11 +349,13 @@ void RuleStatBonus::load(const std::string& parentName, const YAML::Node& node,
 		}
 	}
 
-	//convert bonus vector to script
+	//convert bonus vector to script, and to terms evaluated without it
 	if (_refresh)
 	{
 		auto script = std::string{ };
 		script.reserve(1024);
+		_terms.clear();
+		_customScript = false;
 
 		if (!_bonusOrig.empty())
 		{
@@ -339,6 +364,16 @@ void RuleStatBonus::load(const std::string& parentName, const YAML::Node& node,
 
 			for (const auto& p : _bonusOrig)
 			{
+				RuleStatBonusTerm term = { };
+				for (const auto& stat : statDataMap)
+				{
+					if (stat.name == p.first)
+					{
+						term.stat = stat.getter.stat;
+						break;
+					}
+				}
+
 				script += "unit.";
 				script += p.first;
 				script += statNamePostfix;
@@ -347,15 +382,35 @@ void RuleStatBonus::load(const std::string& parentName, const YAML::Node& node,
 				{
 					if (j < p.second.size())
 					{
-						script += " ";
-						script += std::to_string((int)(p.second[j] * statMultiper * 1000));
+						term.coefficients[j] = (int)(p.second[j] * statMultiper * 1000);
 					}
-					else
+					if (term.coefficients[j] != 0)
 					{
-						script += " 0";
+						term.degree = j + 1;
 					}
+					script += " ";
+					script += std::to_string(term.coefficients[j]);
 				}
 				script += ";\n";
+
+				if (!term.stat)
+				{
+					// unknown stat, the script will complain about it
+					_customScript = true;
+				}
+				else
+				{
+					for (const auto& stat : statDataMap)
+					{
+						if (stat.getter.stat == term.stat && stat.getter.flat)
+						{
+							term.flat = statPolynomial(term.stat(nullptr), term.coefficients, term.degree);
+							term.stat = nullptr;
+							break;
+						}
+					}
+				}
+				_terms.push_back(term);
 			}
 
 			//rounding to the nearest
@@ -511,6 +566,55 @@ void RuleStatBonus::setStunRecovery()
 	);
 }
 
+/**
+ * Checks if the bonus is a plain polynomial of stats and no global
+ * event scripts are hooked to it, so it can be calculated directly.
+ * @return True if the script engine can be skipped.
+ */
+bool RuleStatBonus::isCompiled() const
+{
+	if (_customScript)
+	{
+		return false;
+	}
+	auto events = _container.dataEvents();
+	return !events || (!events[0] && !events[1]);
+}
+
+/**
+ * Calculates the bonus the same way the script generated
+ * from the polynomials does, down to the rounding.
+ * @param unit Unit whose stats are used.
+ * @param externalBonuses Bonus to start with.
+ * @return Final bonus.
+ */
+int RuleStatBonus::evaluate(const BattleUnit* unit, int externalBonuses) const
+{
+	if (_terms.empty())
+	{
+		return externalBonuses;
+	}
+
+	int bonus = externalBonuses * 1000;
+	if (unit)
+	{
+		for (const auto& term : _terms)
+		{
+			const float value = term.stat ? statPolynomial(term.stat(unit), term.coefficients, term.degree) : term.flat;
+			bonus += value / statMultiper;
+		}
+	}
+	if (bonus >= 0)
+	{
+		bonus += 500;
+	}
+	else
+	{
+		bonus -= 500;
+	}
+	return bonus / 1000;
+}
+
 /**
  * Calculate bonus based on attack unit and weapons.
  */
@@ -518,6 +622,11 @@ int RuleStatBonus::getBonus(BattleActionAttack::ReadOnly attack, int externalBon
 {
 	assert(!_refresh && "RuleStatBonus not loaded correctly");
 
+	if (isCompiled())
+	{
+		return evaluate(attack.attacker, externalBonuses);
+	}
+
 	ModScript::BonusStatsCommon::Output arg{ externalBonuses };
 	ModScript::BonusStatsCommon::Worker work{ attack.attacker, externalBonuses, attack.weapon_item, attack.damage_item, attack.type, attack.skill_rules };
 	work.execute(_container, arg);
@@ -532,6 +641,11 @@ int RuleStatBonus::getBonus(const BattleUnit* unit, int externalBonuses) const
 {
 	assert(!_refresh && "RuleStatBonus not loaded correctly");
 
+	if (isCompiled())
+	{
+		return evaluate(unit, externalBonuses);
+	}
+
 	ModScript::BonusStatsCommon::Output arg{ externalBonuses };
 	ModScript::BonusStatsCommon::Worker work{ unit, externalBonuses, nullptr, nullptr, BA_NONE, nullptr };
 	work.execute(_container, arg);
@@ -551,7 +665,7 @@ ModScript::BonusStatsBaseParser::BonusStatsBaseParser(ScriptGlobal* shared, cons
 
 	for (const auto& stat : statDataMap)
 	{
-		stat.func(bu, stat.name);
+		stat.getter.bind(bu, stat.name);
 	}
 }
 
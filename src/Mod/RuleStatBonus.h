@@ -30,6 +30,16 @@ class BattleUnit;
 class BattleItem;
 typedef std::pair<float (*)(const BattleUnit*), float> RuleStatBonusData;
 typedef std::pair<std::string, std::vector<float> > RuleStatBonusDataOrig;
+/**
+ * One stat of a bonus formula with its polynomial, ready to be evaluated without the script engine.
+ */
+struct RuleStatBonusTerm
+{
+	float (*stat)(const BattleUnit*); ///< Null if the stat is a constant.
+	float flat;                       ///< Value of the polynomial for a constant stat.
+	int coefficients[4];
+	int degree;
+};
 /**
  * Helper class used for storing unit stat bonuses.
  */
@@ -37,10 +47,16 @@ class RuleStatBonus
 {
 	ModScript::BonusStatsCommon::Container _container;
 	std::vector<RuleStatBonusDataOrig> _bonusOrig;
+	std::vector<RuleStatBonusTerm> _terms;
 	bool _modded = false;
 	bool _refresh = true;
+	bool _customScript = false;
 
 	void setValues(std::vector<RuleStatBonusDataOrig>&& bonuses);
+	/// Checks if the bonus can skip the script engine.
+	bool isCompiled() const;
+	/// Calculates the bonus from the compiled terms.
+	int evaluate(const BattleUnit* unit, int externalBonuses) const;
 
 public:
 	/// Default constructor.
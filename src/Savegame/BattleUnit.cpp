@@ -63,7 +63,7 @@ namespace OpenXcom
 BattleUnit::BattleUnit(const Mod *mod, Soldier *soldier, int depth, const RuleStartingCondition* sc) :
 	_faction(FACTION_PLAYER), _originalFaction(FACTION_PLAYER), _killedBy(FACTION_PLAYER), _id(0), _tile(0),
 	_lastPos(Position()), _direction(0), _toDirection(0), _directionTurret(0), _toDirectionTurret(0),
-	_verticalDirection(0), _status(STATUS_STANDING), _wantsToSurrender(false), _isSurrendering(false), _hasPanickedLastTurn(false), _walkPhase(0), _fallPhase(0), _kneeled(false), _floating(false),
+	_verticalDirection(0), _status(STATUS_STANDING), _wantsToSurrender(false), _isSurrendering(false), _hasPanickedLastTurn(false), _walkPhase(0), _fallPhase(0), _visibility(0), _visibilitySlot(-1), _kneeled(false), _floating(false),
 	_dontReselect(false), _fire(0), _currentAIState(0), _visible(false),
 	_exp{ }, _expTmp{ },
 	_motionPoints(0), _scannedTurn(-1), _kills(0), _hitByFire(false), _hitByAnything(false), _alreadyExploded(false), _fireMaxHit(0), _smokeMaxHit(0), _moraleRestored(0), _charging(0), _turnsSinceSpotted(255), _turnsLeftSpottedForSnipers(0),
@@ -391,7 +391,7 @@ BattleUnit::BattleUnit(const Mod *mod, Unit *unit, UnitFaction faction, int id,
 	_faction(faction), _originalFaction(faction), _killedBy(faction), _id(id),
 	_tile(0), _lastPos(Position()), _direction(0), _toDirection(0), _directionTurret(0),
 	_toDirectionTurret(0), _verticalDirection(0), _status(STATUS_STANDING), _wantsToSurrender(false), _hasPanickedLastTurn(false), _isSurrendering(false), _walkPhase(0),
-	_fallPhase(0), _kneeled(false), _floating(false), _dontReselect(false), _fire(0), _currentAIState(0),
+	_fallPhase(0), _visibility(0), _visibilitySlot(-1), _kneeled(false), _floating(false), _dontReselect(false), _fire(0), _currentAIState(0),
 	_visible(false), _exp{ }, _expTmp{ },
 	_motionPoints(0), _scannedTurn(-1), _kills(0), _hitByFire(false), _hitByAnything(false), _alreadyExploded(false), _fireMaxHit(0), _smokeMaxHit(0),
 	_moraleRestored(0), _charging(0), _turnsSinceSpotted(255), _turnsLeftSpottedForSnipers(0),
@@ -584,6 +584,10 @@ BattleUnit::~BattleUnit()
 	}
 	delete _statistics;
 	delete _currentAIState;
+	if (_visibility)
+	{
+		_visibility->detach(_visibilitySlot);
+	}
 }
 
 /**
@@ -2275,25 +2279,14 @@ void BattleUnit::resetTimeUnitsAndEnergy()
  */
 bool BattleUnit::addToVisibleUnits(BattleUnit *unit)
 {
-	bool add = true;
-	for (auto* bu : _unitsSpottedThisTurn)
-	{
-		if (bu == unit)
-		{
-			add = false;
-			break;
-		}
-	}
-	if (add)
+	_visibility->attach(unit);
+	if (_visibility->addSpotted(_visibilitySlot, unit->getVisibilitySlot()))
 	{
 		_unitsSpottedThisTurn.push_back(unit);
 	}
-	for (auto* bu : _visibleUnits)
+	if (!_visibility->addUnit(_visibilitySlot, unit->getVisibilitySlot()))
 	{
-		if (bu == unit)
-		{
-			return false;
-		}
+		return false;
 	}
 	_visibleUnits.push_back(unit);
 	return true;
@@ -2306,14 +2299,12 @@ bool BattleUnit::addToVisibleUnits(BattleUnit *unit)
 */
 bool BattleUnit::removeFromVisibleUnits(BattleUnit *unit)
 {
-	if (!_visibleUnits.size()) {
-		return false;
-	}
-	auto i = std::find(_visibleUnits.begin(), _visibleUnits.end(), unit);
-	if (i == _visibleUnits.end())
+	if (!hasUnitInView(unit))
 	{
 		return false;
 	}
+	_visibility->removeUnit(_visibilitySlot, unit->getVisibilitySlot());
+	auto i = std::find(_visibleUnits.begin(), _visibleUnits.end(), unit);
 	//Slow to remove stuff from vector as it shuffles all the following items. Swap in rearmost element before removal.
 	(*i) = *(_visibleUnits.end() - 1);
 	_visibleUnits.pop_back();
@@ -2332,7 +2323,40 @@ bool BattleUnit::hasVisibleUnit(const BattleUnit *unit) const
 		//Units of same faction are always visible, but not stored in the visible unit list
 		return true;
 	}
-	return std::find(_visibleUnits.begin(), _visibleUnits.end(), unit) != _visibleUnits.end();
+	return hasUnitInView(unit);
+}
+
+/**
+ * Checks if the given unit is on the list of visible units,
+ * without counting units of the same faction as visible.
+ * @param unit The unit to check.
+ * @return true if on the visible list.
+ */
+bool BattleUnit::hasUnitInView(const BattleUnit *unit) const
+{
+	return _visibilitySlot >= 0 && unit->getVisibilitySlot() >= 0 && _visibility->hasUnit(_visibilitySlot, unit->getVisibilitySlot());
+}
+
+/**
+ * Checks if the given unit was spotted by this unit during this turn.
+ * @param unit The unit to check.
+ * @return true if on the list of units spotted this turn.
+ */
+bool BattleUnit::hasSpottedThisTurn(const BattleUnit *unit) const
+{
+	return _visibilitySlot >= 0 && unit->getVisibilitySlot() >= 0 && _visibility->hasSpotted(_visibilitySlot, unit->getVisibilitySlot());
+}
+
+/**
+ * Places the unit in the visibility matrix of its battle,
+ * which keeps what the unit sees.
+ * @param visibility Visibility matrix of the battle.
+ * @param slot Slot of the unit in the matrix.
+ */
+void BattleUnit::setVisibility(VisibilityMatrix *visibility, int slot)
+{
+	_visibility = visibility;
+	_visibilitySlot = slot;
 }
 
 /**
@@ -2349,6 +2373,10 @@ std::vector<BattleUnit*> *BattleUnit::getVisibleUnits()
  */
 void BattleUnit::clearVisibleUnits()
 {
+	if (_visibilitySlot >= 0)
+	{
+		_visibility->clearUnits(_visibilitySlot);
+	}
 	_visibleUnits.clear();
 }
 
@@ -2360,7 +2388,7 @@ void BattleUnit::clearVisibleUnits()
 bool BattleUnit::addToVisibleTiles(Tile *tile)
 {
 	//Only add once, otherwise we're going to mess up the visibility value and make trouble for the AI (if sneaky).
-	if (_visibleTilesLookup.insert(tile).second)
+	if (_visibility->addTile(_visibilitySlot, tile))
 	{
 		if (getFaction() == FACTION_PLAYER)
 			tile->setVisible(1);
@@ -2445,7 +2473,10 @@ void BattleUnit::clearVisibleTiles()
 	{
 		tile->setVisible(-1);
 	}
-	_visibleTilesLookup.clear();
+	if (_visibilitySlot >= 0)
+	{
+		_visibility->clearTiles(_visibilitySlot);
+	}
 	_visibleTiles.clear();
 	clearLofTiles();
 }
@@ -2783,6 +2814,10 @@ void BattleUnit::prepareNewTurn(bool fullProcess)
 	}
 
 	_isSurrendering = false;
+	if (_visibilitySlot >= 0)
+	{
+		_visibility->clearSpotted(_visibilitySlot);
+	}
 	_unitsSpottedThisTurn.clear();
 	_meleeAttackedBy.clear();
 
@@ -5731,16 +5766,6 @@ void BattleUnit::checkForReactivation()
 	}
 }
 
-void BattleUnit::setReachablePositions(std::map<Position, int, PositionComparator> reachable)
-{
-	_reachablePositions = reachable;
-}
-
-std::map<Position, int, PositionComparator> BattleUnit::getReachablePositions()
-{
-	return _reachablePositions;
-}
-
 void BattleUnit::setPositionOfUpdate(Position pos)
 {
 	_positionWhenReachableWasUpdated = pos;
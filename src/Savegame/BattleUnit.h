@@ -21,6 +21,7 @@
 #include <string>
 #include <unordered_set>
 #include "../Battlescape/Position.h"
+#include "../Battlescape/VisibilityMatrix.h"
 #include "../Mod/Armor.h"
 #include "../Mod/RuleItem.h"
 #include "Soldier.h"
@@ -93,7 +94,8 @@ private:
 	std::vector<Tile *> _visibleTiles;
 	std::vector<Tile *> _lofTiles;
 	std::vector<Tile *> _noLofTiles;
-	std::unordered_set<Tile *> _visibleTilesLookup;
+	VisibilityMatrix *_visibility;
+	int _visibilitySlot;
 	std::unordered_set<Tile *> _lofTilesLookup;
 	std::unordered_set<Tile *> _noLofTilesLookup;
 	int _tu, _energy, _health, _morale, _stunlevel, _mana;
@@ -170,7 +172,7 @@ private:
 	ArmorMoveCost _moveCostBaseClimb = { 0, 0 };
 	ArmorMoveCost _moveCostBaseNormal = { 0, 0 };
 	std::vector<std::pair<Uint8, Uint8> > _recolor;
-	std::map<Position, int, PositionComparator> _reachablePositions;
+	std::vector<std::pair<int, int> > _reachablePositions;
 	Position _positionWhenReachableWasUpdated = Position(-1, -1, -1);
 	bool _capturable;
 	bool _vip;
@@ -363,6 +365,14 @@ public:
 	bool removeFromVisibleUnits(BattleUnit *unit);
 	/// Is the given unit among this unit's visible units?
 	bool hasVisibleUnit(const BattleUnit *unit) const;
+	/// Checks if the unit is on the list of visible units, whatever its faction.
+	bool hasUnitInView(const BattleUnit *unit) const;
+	/// Checks if the unit was spotted this turn.
+	bool hasSpottedThisTurn(const BattleUnit *unit) const;
+	/// Places the unit in the visibility matrix of the battle.
+	void setVisibility(VisibilityMatrix *visibility, int slot);
+	/// Gets the slot of the unit in the visibility matrix, -1 if it has none.
+	int getVisibilitySlot() const { return _visibilitySlot; }
 	/// Get the list of visible units.
 	std::vector<BattleUnit*> *getVisibleUnits();
 	/// Clear visible units.
@@ -376,7 +386,7 @@ public:
 	/// Has this unit marked this tile as within its view?
 	bool hasVisibleTile(Tile *tile) const
 	{
-		return _visibleTilesLookup.find(tile) != _visibleTilesLookup.end(); //find?
+		return _visibilitySlot >= 0 && _visibility->hasTile(_visibilitySlot, tile);
 	}
 	/// Has this unit marked this tile as within its lof?
 	bool hasLofTile(Tile *tile) const
@@ -871,8 +881,9 @@ public:
 	/// Checks whether it makes sense to reactivate a unit that wanted to end it's turn and do so if it's the case
 	void checkForReactivation();
 	/// Cache inside the unit what positions it can reach for reference by AI
-	void setReachablePositions(std::map<Position, int, PositionComparator> reachable);
-	std::map<Position, int, PositionComparator> getReachablePositions();
+	void setReachablePositions(std::vector<std::pair<int, int> > &&reachable) { _reachablePositions = std::move(reachable); }
+	/// Gets the cached tile indices this unit can reach, with the time units it has left there
+	const std::vector<std::pair<int, int> > &getReachablePositions() const { return _reachablePositions; }
 	/// Remember this value in order to check whether an update is due
 	void setPositionOfUpdate(Position posOfUpdate);
 	Position getPositionOfUpdate();
@@ -20,6 +20,7 @@
 #include <yaml-cpp/yaml.h>
 #include <map>
 #include <string>
+#include <vector>
 #include <sstream>
 #include "GameTime.h"
 #include "../Engine/Language.h"
@@ -184,4 +185,27 @@ struct MissionStatistics
 	~MissionStatistics() { }
 };
 
+/**
+ * Finds the statistics of a mission by id. Missions are numbered
+ * in the order they were added, so this is normally a direct lookup.
+ * @param missionStatistics List of all mission statistics.
+ * @param id Mission id.
+ * @return The mission statistics, or null if there are none.
+ */
+inline MissionStatistics *findMissionStatistics(const std::vector<MissionStatistics*> &missionStatistics, int id)
+{
+	if (id >= 0 && id < (int)missionStatistics.size() && missionStatistics[id]->id == id)
+	{
+		return missionStatistics[id];
+	}
+	for (auto* ms : missionStatistics)
+	{
+		if (ms->id == id)
+		{
+			return ms;
+		}
+	}
+	return nullptr;
+}
+
 }
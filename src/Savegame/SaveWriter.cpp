@@ -0,0 +1,158 @@
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SaveWriter.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates the writer thread, which waits for saves.
+ */
+SaveWriter::SaveWriter() : _busy(false), _quit(false)
+{
+	_thread = std::thread(&SaveWriter::work, this);
+}
+
+/**
+ * Lets the save in progress finish, so quitting doesn't leave
+ * a half written file behind, and stops the thread.
+ */
+SaveWriter::~SaveWriter()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [this]{ return !_busy; });
+		_quit = true;
+	}
+	_wake.notify_all();
+	_thread.join();
+}
+
+/**
+ * Hands a save over to be written. If the previous one is
+ * still being written, waits for it first.
+ * @param filename Save filename, relative to the user folder.
+ * @param snapshot The saved game's contents.
+ */
+void SaveWriter::save(const std::string &filename, SaveSnapshot &&snapshot)
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_done.wait(lock, [this]{ return !_busy; });
+		_filename = filename;
+		_snapshot = std::move(snapshot);
+		_busy = true;
+	}
+	_wake.notify_all();
+}
+
+/**
+ * Waits until the save in progress, if any, is written.
+ */
+void SaveWriter::wait()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this]{ return !_busy; });
+}
+
+/**
+ * Gets the errors of the saves that failed since the last call,
+ * and clears them. Each one names the save it belongs to, since
+ * it may not be the save the caller just handed over.
+ * @return Error messages one per line, or empty if all went fine.
+ */
+std::string SaveWriter::takeError()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::string error;
+	for (const auto& e : _errors)
+	{
+		if (!error.empty())
+		{
+			error += '\n';
+		}
+		error += e;
+	}
+	_errors.clear();
+	return error;
+}
+
+/**
+ * Writes saves as they come in, until told to quit.
+ */
+void SaveWriter::work()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true)
+	{
+		_wake.wait(lock, [this]{ return _busy || _quit; });
+		if (_quit)
+		{
+			break;
+		}
+		lock.unlock();
+		std::string error;
+		try
+		{
+			write(_filename, _snapshot);
+		}
+		catch (Exception &e)
+		{
+			error = e.what();
+		}
+		catch (YAML::Exception &e)
+		{
+			error = e.what();
+		}
+		lock.lock();
+		if (!error.empty())
+		{
+			error = _filename + ": " + error;
+			Log(LOG_ERROR) << error;
+			_errors.push_back(error);
+		}
+		_snapshot = SaveSnapshot();
+		_busy = false;
+		_done.notify_all();
+	}
+}
+
+/**
+ * Writes a save to a backup file first and then moves it
+ * over the old one, so a failed save doesn't destroy it.
+ * @param filename Save filename, relative to the user folder.
+ * @param snapshot The saved game's contents.
+ */
+void SaveWriter::write(const std::string &filename, const SaveSnapshot &snapshot)
+{
+	std::string backup = filename + ".bak";
+	SavedGame::writeSnapshot(backup, snapshot);
+	std::string fullPath = Options::getMasterUserFolder() + filename;
+	std::string bakPath = Options::getMasterUserFolder() + backup;
+	if (!CrossPlatform::moveFile(bakPath, fullPath))
+	{
+		throw Exception("Save backed up in " + backup);
+	}
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * Copyright 2010-2024 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SavedGame.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Writes saved games out on a thread of its own, so the game
+ * only stalls for as long as it takes to copy its contents.
+ * One save is written at a time, asking for another one
+ * waits until the previous one is done.
+ */
+class SaveWriter
+{
+private:
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _wake, _done;
+	SaveSnapshot _snapshot;
+	std::string _filename;
+	std::vector<std::string> _errors;
+	bool _busy, _quit;
+	/// Writes saves as they come in.
+	void work();
+	/// Writes a save to a backup file and moves it in place.
+	static void write(const std::string &filename, const SaveSnapshot &snapshot);
+public:
+	/// Creates the writer thread.
+	SaveWriter();
+	/// Finishes the save in progress and stops the thread.
+	~SaveWriter();
+	/// Hands a save over to be written.
+	void save(const std::string &filename, SaveSnapshot &&snapshot);
+	/// Waits until the save in progress, if any, is written.
+	void wait();
+	/// Gets and clears the errors of the saves that failed.
+	std::string takeError();
+};
+
+}
@@ -29,6 +29,7 @@
 #include "Node.h"
 #include "../Mod/MapDataSet.h"
 #include "../Battlescape/Pathfinding.h"
+#include "../Battlescape/TerrainPrefetcher.h"
 #include "../Battlescape/TileEngine.h"
 #include "../Battlescape/BattlescapeState.h"
 #include "../Battlescape/BattlescapeGame.h"
@@ -523,9 +524,15 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
  */
 void SavedBattleGame::loadMapResources(Mod *mod)
 {
-	for (auto* mds : _mapDataSets)
 	{
-		mds->loadData(mod->getMCDPatch(mds->getName()));
+		// decode the sets in parallel, loadData() below waits for the ones in progress
+		TerrainPrefetcher prefetch(mod);
+		prefetch.add(_mapDataSets);
+		prefetch.start();
+		for (auto* mds : _mapDataSets)
+		{
+			mds->loadData(mod->getMCDPatch(mds->getName()));
+		}
 	}
 
 	int mdsID, mdID;
@@ -745,7 +752,7 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	{
 		_tiles.push_back(Tile(getTileCoords(i), this));
 	}
-
+	_visibility.reset(_tiles.data(), _tiles.size());
 }
 
 /**
@@ -2699,16 +2706,8 @@ bool SavedBattleGame::setUnitPosition(BattleUnit *bu, Position position, bool te
  */
 bool SavedBattleGame::eyesOnTarget(UnitFaction faction, BattleUnit* unit)
 {
-	for (auto* bu : *getUnits())
-	{
-		if (bu->getFaction() != faction) continue;
-
-		auto* vis = bu->getVisibleUnits();
-		if (std::find(vis->begin(), vis->end(), unit) != vis->end()) return true;
-		// aliens know the location of all XCom agents sighted by all other aliens due to sharing locations over their space-walkie-talkies
-	}
-
-	return false;
+	// aliens know the location of all XCom agents sighted by all other aliens due to sharing locations over their space-walkie-talkies
+	return unit->getVisibilitySlot() >= 0 && _visibility.isSeenByFaction(faction, unit->getVisibilitySlot());
 }
 
 /**
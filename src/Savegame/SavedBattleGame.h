@@ -21,6 +21,8 @@
 #include <string>
 #include <yaml-cpp/yaml.h>
 #include "Tile.h"
+#include "../Battlescape/TileField.h"
+#include "../Battlescape/VisibilityMatrix.h"
 #include "../Mod/AlienDeployment.h"
 #include "../Mod/RuleCraft.h"
 
@@ -79,6 +81,8 @@ private:
 	std::vector<BattleItem*> _items, _deleted;
 	Pathfinding *_pathfinding;
 	TileEngine *_tileEngine;
+	TileFieldPool<int> _tileFields;
+	VisibilityMatrix _visibility;
 	std::string _missionType, _strTarget, _strCraftOrBase, _alienCustomDeploy, _alienCustomMission;
 	std::string _lastUsedMapScript;
 	int _alienItemLevel = 0;
@@ -378,6 +382,10 @@ public:
 	Pathfinding *getPathfinding() const;
 	/// Gets a pointer to the tile engine.
 	TileEngine *getTileEngine() const;
+	/// Gets the pool of per-tile scratch fields shared by the AI.
+	TileFieldPool<int> &getTileFields() { return _tileFields; }
+	/// Gets who sees what in the battle.
+	VisibilityMatrix &getVisibility() { return _visibility; }
 	/// Gets the playing side.
 	UnitFaction getSide() const;
 	/// Can unit use that weapon?
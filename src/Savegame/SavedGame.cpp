@@ -127,18 +127,32 @@ void sortReserchVector(std::vector<T> &vec)
 	std::sort(vec.begin(), vec.end(), researchLess);
 }
 
-bool haveReserchVector(const std::vector<const RuleResearch*> &vec, const RuleResearch *res)
-{
-	auto find = std::lower_bound(vec.begin(), vec.end(), res, researchLess);
-	return find != vec.end() && *find == res;
-}
-
 bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::string &res)
 {
 	auto find = std::find_if(vec.begin(), vec.end(), [&](const RuleResearch* r){ return r->getName() == res; });
 	return find != vec.end();
 }
 
+bool haveReserchIndex(const std::vector<bool> &index, const RuleResearch *res)
+{
+	size_t i = res->getIndex();
+	return i < index.size() && index[i];
+}
+
+void setReserchIndex(std::vector<bool> &index, const RuleResearch *res, bool value)
+{
+	if (res->getIndex() < 0)
+	{
+		return;
+	}
+	size_t i = res->getIndex();
+	if (i >= index.size())
+	{
+		index.resize(i + 1, false);
+	}
+	index[i] = value;
+}
+
 }
 
 /**
@@ -146,7 +160,7 @@ bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::
  */
 SavedGame::SavedGame() :
 	_difficulty(DIFF_BEGINNER), _end(END_NONE), _ironman(false), _globeLon(0.0), _globeLat(0.0), _globeZoom(0),
-	_battleGame(0), _previewBase(nullptr), _debug(false), _warned(false),
+	_battleGame(0), _unlockedIndexValid(false), _researchFrontierValid(false), _previewBase(nullptr), _debug(false), _warned(false),
 	_togglePersonalLight(true), _toggleNightVision(false), _toggleBrightness(0),
 	_monthsPassed(-1), _selectedBase(0), _visibleBasesIndex(0), _autosales(), _disableSoldierEquipment(false), _alienContainmentChecked(false)
 {
@@ -598,6 +612,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		if (mod->getResearch(research))
 		{
 			_discovered.push_back(mod->getResearch(research));
+			setReserchIndex(_discoveredIndex, _discovered.back(), true);
 		}
 		else
 		{
@@ -605,6 +620,8 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		}
 	}
 	sortReserchVector(_discovered);
+	_unlockedIndexValid = false;
+	_researchFrontierValid = false;
 
 	_generatedEvents = doc["generatedEvents"].as< std::map<std::string, int> >(_generatedEvents);
 	_ufopediaRuleStatus = doc["ufopediaRuleStatus"].as< std::map<std::string, int> >(_ufopediaRuleStatus);
@@ -801,15 +818,16 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 }
 
 /**
- * Saves a saved game's contents to a YAML file.
- * @param filename YAML filename.
+ * Copies a saved game's contents into YAML nodes that no longer
+ * refer to the game, so they can be written out while it goes on.
+ * @return The brief and full game data.
  */
-void SavedGame::save(const std::string &filename, Mod *mod) const
+SaveSnapshot SavedGame::snapshot(Mod *mod) const
 {
-	YAML::Emitter out;
+	SaveSnapshot snapshot;
 
 	// Saves the brief game info used in the saves list
-	YAML::Node brief;
+	YAML::Node &brief = snapshot.brief;
 	brief["name"] = _name;
 	brief["version"] = OPENXCOM_VERSION_SHORT;
 	brief["engine"] = OPENXCOM_VERSION_ENGINE;
@@ -837,10 +855,8 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	brief["mods"] = modsList;
 	if (_ironman)
 		brief["ironman"] = _ironman;
-	out << brief;
 	// Saves the full game data to the save
-	out << YAML::BeginDoc;
-	YAML::Node node;
+	YAML::Node &node = snapshot.node;
 	node["difficulty"] = (int)_difficulty;
 	node["end"] = (int)_end;
 	node["monthsPassed"] = _monthsPassed;
@@ -1003,8 +1019,21 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	}
 	_scriptValues.save(node, mod->getScriptGlobal());
 
-	out << node;
+	return snapshot;
+}
 
+/**
+ * Writes a copy of a saved game's contents to a YAML file.
+ * Doesn't touch the game, so it's safe to call from any thread.
+ * @param filename YAML filename.
+ * @param snapshot The saved game's contents.
+ */
+void SavedGame::writeSnapshot(const std::string &filename, const SaveSnapshot &snapshot)
+{
+	YAML::Emitter out;
+	out << snapshot.brief;
+	out << YAML::BeginDoc;
+	out << snapshot.node;
 
 	std::string filepath = Options::getMasterUserFolder() + filename;
 	if (!CrossPlatform::writeFile(filepath, out.c_str()))
@@ -1616,7 +1645,95 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
 	if (r != _discovered.end())
 	{
 		_discovered.erase(r);
+		setReserchIndex(_discoveredIndex, research, false);
+		// other discovered topics may unlock the same ones, rebuild from scratch when needed
+		_unlockedIndexValid = false;
+		_researchFrontierValid = false;
+	}
+}
+
+/**
+ * Adds a research to the sorted list of discovered research
+ * and keeps the discovered and unlocked indices up to date.
+ * @param research The newly found ResearchProject
+ */
+void SavedGame::markDiscoveredResearch(const RuleResearch * research)
+{
+	_discovered.insert(std::upper_bound(_discovered.begin(), _discovered.end(), research, researchLess), research);
+	setReserchIndex(_discoveredIndex, research, true);
+	if (_unlockedIndexValid)
+	{
+		for (const auto* unl : research->getUnlocked())
+		{
+			setReserchIndex(_unlockedIndex, unl, true);
+		}
+	}
+	if (_researchFrontierValid)
+	{
+		_researchFrontierPending.push_back(research);
+	}
+}
+
+/**
+ * Gets the topics that can be researched without their dependencies,
+ * because some discovered topic unlocks them (e.g. STR_ALIEN_ORIGINS).
+ * Kept up to date as topics are discovered, rebuilt after one gets disabled.
+ * @return The unlocked topics, indexed by RuleResearch::getIndex().
+ */
+const std::vector<bool> &SavedGame::getUnlockedResearchIndex() const
+{
+	if (!_unlockedIndexValid)
+	{
+		_unlockedIndex.clear();
+		for (const auto* research : _discovered)
+		{
+			for (const auto* unl : research->getUnlocked())
+			{
+				setReserchIndex(_unlockedIndex, unl, true);
+			}
+		}
+		_unlockedIndexValid = true;
+	}
+	return _unlockedIndex;
+}
+
+/**
+ * Rebuilds the research indices from the list of discovered research
+ * and compares them with the ones that were kept up to date on the way.
+ * @return True if they match.
+ */
+bool SavedGame::checkResearchIndex() const
+{
+	std::vector<bool> discovered, unlocked;
+	for (const auto* research : _discovered)
+	{
+		setReserchIndex(discovered, research, true);
+		for (const auto* unl : research->getUnlocked())
+		{
+			setReserchIndex(unlocked, unl, true);
+		}
+	}
+	bool valid = true;
+	for (size_t i = 0; i < std::max(discovered.size(), _discoveredIndex.size()); ++i)
+	{
+		if ((i < discovered.size() && discovered[i]) != (i < _discoveredIndex.size() && _discoveredIndex[i]))
+		{
+			Log(LOG_ERROR) << "Research index " << i << " is out of sync with the discovered research.";
+			valid = false;
+		}
 	}
+	if (_unlockedIndexValid)
+	{
+		for (size_t i = 0; i < std::max(unlocked.size(), _unlockedIndex.size()); ++i)
+		{
+			if ((i < unlocked.size() && unlocked[i]) != (i < _unlockedIndex.size() && _unlockedIndex[i]))
+			{
+				Log(LOG_ERROR) << "Research index " << i << " is out of sync with the unlocked research.";
+				valid = false;
+			}
+		}
+	}
+	return valid;
 }
 
 /**
@@ -1625,8 +1742,7 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
  */
 void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
 {
-	_discovered.push_back(research);
-	sortReserchVector(_discovered);
+	markDiscoveredResearch(research);
 }
 
 /**
@@ -1669,8 +1785,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		bool checkRelatedZeroCostTopics = true;
 		if (!isResearched(currentQueueItem, false))
 		{
-			_discovered.push_back(currentQueueItem);
-			sortReserchVector(_discovered);
+			markDiscoveredResearch(currentQueueItem);
 			if (!hasUndiscoveredProtectedUnlocks && !hasAnyUndiscoveredGetOneFrees)
 			{
 				// If the currentQueueItem can't tell you anything anymore, remove it from popped research
@@ -1763,6 +1878,11 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		// 4. process remaining items in the queue
 		++currentQueueIndex;
 	}
+
+	if (Options::debug && !checkResearchIndex())
+	{
+		Log(LOG_ERROR) << "Research index check failed after finishing " << research->getName();
+	}
 }
 
 /**
@@ -1775,111 +1895,216 @@ const std::vector<const RuleResearch *> & SavedGame::getDiscoveredResearch() con
 }
 
 /**
- * Get the list of RuleResearch which can be researched in a Base.
- * @param projects the list of ResearchProject which are available.
+ * Checks if a research topic could be researched as far as other topics
+ * go: its requirements are discovered, and so are its dependencies
+ * unless a discovered topic unlocks it. Debug mode is not considered.
+ * @param research The topic.
+ * @return True if it's a candidate.
+ */
+bool SavedGame::isResearchCandidate(const RuleResearch *research) const
+{
+	// Unlocked topics can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
+	// Note: all requirements of such topics *have to* be discovered though!
+	if (!haveReserchIndex(getUnlockedResearchIndex(), research) && !isResearched(research->getDependencies(), false))
+	{
+		return false;
+	}
+	return isResearched(research->getRequirements(), false);
+}
+
+/**
+ * Gets the research topics whose dependencies and requirements are met,
+ * in the order of the research map. Built once by checking every topic,
+ * then only the dependents of newly discovered topics are checked, since
+ * discovering a topic can't take another one out. Rebuilt from scratch
+ * after a topic gets disabled.
  * @param mod the game Mod
- * @param base a pointer to a Base
- * @param considerDebugMode Should debug mode be considered or not.
+ * @return The candidate topics.
  */
-void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base, bool considerDebugMode) const
+const std::vector<RuleResearch *> &SavedGame::getResearchFrontier(const Mod *mod) const
 {
-	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
-	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
-	std::vector<const RuleResearch *> unlocked;
-	for (const auto* research : _discovered)
+	if (!_researchFrontierValid)
 	{
-		for (const auto* unl : research->getUnlocked())
+		_researchFrontier.clear();
+		_researchFrontierIndex.clear();
+		for (const auto& pair : mod->getResearchMap())
 		{
-			unlocked.push_back(unl);
+			if (isResearchCandidate(pair.second))
+			{
+				_researchFrontier.push_back(pair.second);
+				setReserchIndex(_researchFrontierIndex, pair.second, true);
+			}
 		}
-		sortReserchVector(unlocked);
+		_researchFrontierPending.clear();
+		_researchFrontierValid = true;
 	}
-
-	// Create a list of research topics available for research in the given base
-	for (const auto& pair : mod->getResearchMap())
+	else if (!_researchFrontierPending.empty())
 	{
-		// This research topic is permanently disabled, ignore it!
-		if (isResearchRuleStatusDisabled(pair.first))
+		for (const auto* discovered : _researchFrontierPending)
 		{
-			continue;
+			for (auto* research : discovered->getDependents())
+			{
+				if (!haveReserchIndex(_researchFrontierIndex, research) && isResearchCandidate(research))
+				{
+					auto pos = std::upper_bound(_researchFrontier.begin(), _researchFrontier.end(), research,
+						[](const RuleResearch *a, const RuleResearch *b) { return a->getIndex() < b->getIndex(); });
+					_researchFrontier.insert(pos, research);
+					setReserchIndex(_researchFrontierIndex, research, true);
+				}
+			}
 		}
+		_researchFrontierPending.clear();
+	}
+	return _researchFrontier;
+}
 
-		RuleResearch *research = pair.second;
+/**
+ * Checks if a candidate research topic can be researched in a base,
+ * with all the checks that don't depend on its dependencies.
+ * @param research The topic.
+ * @param mod the game Mod
+ * @param base a pointer to a Base, null for the vanilla save converter.
+ * @return True if it's available.
+ */
+bool SavedGame::isResearchAvailable(RuleResearch *research, const Mod *mod, Base *base) const
+{
+	// This research topic is permanently disabled, ignore it!
+	if (isResearchRuleStatusDisabled(research->getName()))
+	{
+		return false;
+	}
 
-		if ((considerDebugMode && _debug) || haveReserchVector(unlocked, research))
+	// Remove the already researched topics from the list *UNLESS* they can still give you something more
+	if (isResearched(research, false))
+	{
+		if (hasUndiscoveredGetOneFree(research, true))
 		{
-			// Empty, these research topics are on the "unlocked list", *don't* check the dependencies!
+			// This research topic still has some more undiscovered non-disabled and *AVAILABLE* "getOneFree" topics, keep it!
+		}
+		else if (hasUndiscoveredProtectedUnlock(research, mod))
+		{
+			// This research topic still has one or more undiscovered non-disabled "protected unlocks", keep it!
 		}
 		else
 		{
-			// These items are not on the "unlocked list", we must check if "dependencies" are satisfied!
-			if (!isResearched(research->getDependencies(), considerDebugMode))
-			{
-				continue;
-			}
+			// This topic can't give you anything else anymore, ignore it!
+			return false;
 		}
+	}
 
-		// Check if "requires" are satisfied
-		// IMPORTANT: research topics with "requires" will NEVER be directly visible to the player anyway
-		//   - there is an additional filter in NewResearchListState::fillProjectList(), see comments there for more info
-		//   - there is an additional filter in NewPossibleResearchState::NewPossibleResearchState()
-		//   - we do this check for other functionality using this method, namely SavedGame::addFinishedResearch()
-		//     - Note: when called from there, parameter considerDebugMode = false
-		if (!isResearched(research->getRequirements(), considerDebugMode))
+	if (base)
+	{
+		// Check if this topic is already being researched in the given base
+		const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
+		if (std::find_if(baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
 		{
-			continue;
+			return false;
 		}
 
-		// Remove the already researched topics from the list *UNLESS* they can still give you something more
-		if (isResearched(research->getName(), false))
+		// Check for needed item in the given base
+		if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
 		{
-			if (hasUndiscoveredGetOneFree(research, true))
-			{
-				// This research topic still has some more undiscovered non-disabled and *AVAILABLE* "getOneFree" topics, keep it!
-			}
-			else if (hasUndiscoveredProtectedUnlock(research, mod))
-			{
-				// This research topic still has one or more undiscovered non-disabled "protected unlocks", keep it!
-			}
-			else
-			{
-				// This topic can't give you anything else anymore, ignore it!
-				continue;
-			}
+			return false;
 		}
 
-		if (base)
+		// Check for required buildings/functions in the given base
+		if ((~base->getProvidedBaseFunc({}) & research->getRequireBaseFunc()).any())
 		{
-			// Check if this topic is already being researched in the given base
-			const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
-			if (std::find_if(baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
-			{
-				continue;
-			}
+			return false;
+		}
+	}
+	else
+	{
+		// Used in vanilla save converter only
+		if (research->needItem() && research->getCost() == 0)
+		{
+			return false;
+		}
+	}
 
-			// Check for needed item in the given base
-			if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
-			{
-				continue;
-			}
+	return true;
+}
 
-			// Check for required buildings/functions in the given base
-			if ((~base->getProvidedBaseFunc({}) & research->getRequireBaseFunc()).any())
+/**
+ * Get the list of RuleResearch which can be researched in a Base.
+ * @param projects the list of ResearchProject which are available.
+ * @param mod the game Mod
+ * @param base a pointer to a Base
+ * @param considerDebugMode Should debug mode be considered or not.
+ */
+void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base, bool considerDebugMode) const
+{
+	if (considerDebugMode && _debug)
+	{
+		// debug mode ignores dependencies and requirements, every topic is a candidate
+		for (const auto& pair : mod->getResearchMap())
+		{
+			if (isResearchAvailable(pair.second, mod, base))
 			{
-				continue;
+				projects.push_back(pair.second);
 			}
 		}
-		else
+		return;
+	}
+
+	// IMPORTANT: research topics with "requires" will NEVER be directly visible to the player anyway
+	//   - there is an additional filter in NewResearchListState::fillProjectList(), see comments there for more info
+	//   - there is an additional filter in NewPossibleResearchState::NewPossibleResearchState()
+	//   - the frontier includes them for other functionality using this method, namely SavedGame::addFinishedResearch()
+	size_t first = projects.size();
+	for (auto* research : getResearchFrontier(mod))
+	{
+		if (isResearchAvailable(research, mod, base))
 		{
-			// Used in vanilla save converter only
-			if (research->needItem() && research->getCost() == 0)
-			{
-				continue;
-			}
+			projects.push_back(research);
 		}
+	}
 
-		// Hallelujah, all checks passed, add the research topic to the list
-		projects.push_back(research);
+	if (Options::debug)
+	{
+		std::vector<RuleResearch *> scanned;
+		scanAvailableResearchProjects(scanned, mod, base);
+		if (!std::equal(projects.begin() + first, projects.end(), scanned.begin(), scanned.end()))
+		{
+			Log(LOG_ERROR) << "Available research differs from a full scan: " << projects.size() - first << " topics instead of " << scanned.size() << ".";
+		}
+	}
+}
+
+/**
+ * Get the list of RuleResearch which can be researched in a Base
+ * by checking the dependencies of every topic against the discovered
+ * list, as it was done before the frontier. Only used to check it.
+ * @param projects the list of ResearchProject which are available.
+ * @param mod the game Mod
+ * @param base a pointer to a Base
+ */
+void SavedGame::scanAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base) const
+{
+	std::vector<const RuleResearch *> unlocked;
+	for (const auto* research : _discovered)
+	{
+		for (const auto* unl : research->getUnlocked())
+		{
+			unlocked.push_back(unl);
+		}
+	}
+
+	for (const auto& pair : mod->getResearchMap())
+	{
+		RuleResearch *research = pair.second;
+		if (std::find(unlocked.begin(), unlocked.end(), research) == unlocked.end() && !isResearched(research->getDependencies(), false))
+		{
+			continue;
+		}
+		if (!isResearched(research->getRequirements(), false))
+		{
+			continue;
+		}
+		if (isResearchAvailable(research, mod, base))
+		{
+			projects.push_back(research);
+		}
 	}
 }
 
@@ -2211,7 +2436,7 @@ bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMod
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return haveReserchIndex(_discoveredIndex, research);
 }
 
 bool SavedGame::isResearched(const std::vector<std::string> &research, bool considerDebugMode) const
@@ -2245,27 +2470,16 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
 		return true;
 	if (considerDebugMode && _debug)
 		return true;
-	std::vector<const RuleResearch *> matches = research;
-	if (skipDisabled)
+
+	for (const auto* res : research)
 	{
-		// ignore all disabled topics (as if they didn't exist)
-		for (auto iter = matches.begin(); iter != matches.end();)
+		if (!haveReserchIndex(_discoveredIndex, res))
 		{
-			if (isResearchRuleStatusDisabled((*iter)->getName()))
-			{
-				iter = matches.erase(iter);
-			}
-			else
+			// ignore all disabled topics (as if they didn't exist)
+			if (skipDisabled && isResearchRuleStatusDisabled(res->getName()))
 			{
-				++iter;
+				continue;
 			}
-		}
-	}
-
-	for (const auto* res : matches)
-	{
-		if (!haveReserchVector(_discovered, res))
-		{
 			return false;
 		}
 	}
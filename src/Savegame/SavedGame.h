@@ -95,6 +95,16 @@ struct SaveInfo
 	bool reserved;
 };
 
+/**
+ * Copy of a saved game's contents, taken on the main thread
+ * so it can be written out on another one.
+ */
+struct SaveSnapshot
+{
+	YAML::Node brief;
+	YAML::Node node;
+};
+
 /**
  * The game data that gets written to disk when the game is saved.
  * A saved game holds all the variable info in a game like funds,
@@ -141,6 +151,13 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	std::vector<bool> _discoveredIndex;
+	mutable std::vector<bool> _unlockedIndex;
+	mutable bool _unlockedIndexValid;
+	mutable std::vector<RuleResearch*> _researchFrontier;
+	mutable std::vector<bool> _researchFrontierIndex;
+	mutable std::vector<const RuleResearch*> _researchFrontierPending;
+	mutable bool _researchFrontierValid;
 	std::map<std::string, int> _generatedEvents;
 	std::map<std::string, int> _ufopediaRuleStatus;
 	std::map<std::string, int> _manufactureRuleStatus;
@@ -188,8 +205,10 @@ public:
 	static std::vector<SaveInfo> getList(Language *lang, bool autoquick);
 	/// Loads a saved game from YAML.
 	void load(const std::string &filename, Mod *mod, Language *lang);
-	/// Saves a saved game to YAML.
-	void save(const std::string &filename, Mod *mod) const;
+	/// Copies the saved game's contents, ready to be written.
+	SaveSnapshot snapshot(Mod *mod) const;
+	/// Writes a copy of a saved game's contents to a YAML file.
+	static void writeSnapshot(const std::string &filename, const SaveSnapshot &snapshot);
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
@@ -286,6 +305,20 @@ public:
 	void setHiddenPurchaseItemsStatus(const std::string &itemName, bool hidden);
 	/// Selects a "getOneFree" topic for the given research rule.
 	const RuleResearch* selectGetOneFree(const RuleResearch* research);
+	/// Adds a research to the "already discovered" list and the index.
+	void markDiscoveredResearch(const RuleResearch *research);
+	/// Gets the topics unlocked by the discovered research, indexed by RuleResearch::getIndex().
+	const std::vector<bool> &getUnlockedResearchIndex() const;
+	/// Checks that the research indices match the "already discovered" list.
+	bool checkResearchIndex() const;
+	/// Checks if the dependencies and requirements of a research are met.
+	bool isResearchCandidate(const RuleResearch *research) const;
+	/// Gets the topics whose dependencies and requirements are met.
+	const std::vector<RuleResearch*> &getResearchFrontier(const Mod *mod) const;
+	/// Checks if a candidate research can be researched in a base.
+	bool isResearchAvailable(RuleResearch *research, const Mod *mod, Base *base) const;
+	/// Gets the available research by checking every topic, the way it was done before the frontier.
+	void scanAvailableResearchProjects(std::vector<RuleResearch*> & projects, const Mod *mod, Base *base) const;
 	/// Remove a research from the "already discovered" list
 	void removeDiscoveredResearch(const RuleResearch *research);
 	/// Add a finished ResearchProject
@@ -36,7 +36,7 @@ SoldierDiary::SoldierDiary() : _daysWoundedTotal(0), _totalShotByFriendlyCounter
 	_timesWoundedTotal(0), _KIA(0), _allAliensKilledTotal(0), _allAliensStunnedTotal(0), _woundsHealedTotal(0), _allUFOs(0), _allMissionTypes(0),
 	_statGainTotal(0), _revivedUnitTotal(0), _wholeMedikitTotal(0), _braveryGainTotal(0), _bestOfRank(0),
 	_MIA(0), _martyrKillsTotal(0), _postMortemKills(0), _slaveKillsTotal(0), _bestSoldier(false),
-	_revivedSoldierTotal(0), _revivedHostileTotal(0), _revivedNeutralTotal(0), _globeTrotter(false)
+	_revivedSoldierTotal(0), _revivedHostileTotal(0), _revivedNeutralTotal(0), _globeTrotter(false), _missionTotalsCount(0), _missionTotalsStatistics(0), _missionTotalsMissing(false)
 {
 }
 
@@ -83,6 +83,9 @@ void SoldierDiary::load(const YAML::Node& node, const Mod *mod)
 			_killList.push_back(new BattleUnitKills(*i));
 	}
 	_missionIdList = node["missionIdList"].as<std::vector<int> >(_missionIdList);
+	_missionTotals = MissionTotals();
+	_missionTotalsCount = 0;
+	_missionTotalsMissing = false;
 	_daysWoundedTotal = node["daysWoundedTotal"].as<int>(_daysWoundedTotal);
 	_totalShotByFriendlyCounter = node["totalShotByFriendlyCounter"].as<int>(_totalShotByFriendlyCounter);
 	_totalShotFriendlyCounter = node["totalShotFriendlyCounter"].as<int>(_totalShotFriendlyCounter);
@@ -706,25 +709,84 @@ std::map<std::string, int> SoldierDiary::getWeaponAmmoTotal() const
 }
 
 /**
- *  Get a map of the amount of missions done in each region.
- *  @param MissionStatistics
+ * Gets the totals over all the missions in the diary.
+ * The missions are added to the totals once, as they come in,
+ * so commendations don't have to go through the whole history every time.
+ * If a mission had no statistics yet, the totals are counted again
+ * once the statistics list grows.
+ * @param missionStatistics List of all mission statistics.
+ * @return The mission totals.
  */
-std::map<std::string, int> SoldierDiary::getRegionTotal(std::vector<MissionStatistics*> *missionStatistics) const
+const SoldierDiary::MissionTotals &SoldierDiary::getMissionTotals(const std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> regionTotal;
-
-	for (const auto* ms : *missionStatistics)
+	if (_missionTotalsCount > _missionIdList.size() || (_missionTotalsMissing && _missionTotalsStatistics != missionStatistics->size()))
 	{
-		for (int missionId : _missionIdList)
+		_missionTotals = MissionTotals();
+		_missionTotalsCount = 0;
+		_missionTotalsMissing = false;
+	}
+	for (; _missionTotalsCount < _missionIdList.size(); ++_missionTotalsCount)
+	{
+		const MissionStatistics *ms = findMissionStatistics(*missionStatistics, _missionIdList[_missionTotalsCount]);
+		if (!ms)
+		{
+			_missionTotalsStatistics = missionStatistics->size();
+			_missionTotalsMissing = true;
+			continue;
+		}
+		bool unique = _missionTotals.ids.insert(ms->id).second;
+		_missionTotals.region[ms->region]++;
+		_missionTotals.country[ms->country]++;
+		_missionTotals.type[ms->type]++;
+		_missionTotals.ufo[ms->ufo]++;
+		_missionTotals.score += ms->score;
+		_missionTotals.lootValue += ms->lootValue;
+		if (ms->valiantCrux)
+		{
+			_missionTotals.valiantCrux++;
+		}
+		if (ms->success)
 		{
-			if (missionId == ms->id)
+			_missionTotals.win++;
+			if (unique)
+			{
+				_missionTotals.successType[ms->type]++;
+				_missionTotals.successMarker[ms->markerName]++;
+			}
+			if (!ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
+			{
+				_missionTotals.terror++;
+				_missionTotals.nightTerrorByDaylight[ms->daylight]++;
+			}
+			if (!ms->isBaseDefense() && !ms->isAlienBase())
+			{
+				// darkness depends on the mod, sorted out when asked
+				_missionTotals.nightByDaylight[ms->daylight]++;
+			}
+			if (ms->isBaseDefense())
+			{
+				_missionTotals.baseDefense++;
+			}
+			if (ms->isAlienBase())
 			{
-				regionTotal[ms->region]++;
+				_missionTotals.alienBase++;
+			}
+			if (ms->type != "STR_UFO_CRASH_RECOVERY")
+			{
+				_missionTotals.important++;
 			}
 		}
 	}
+	return _missionTotals;
+}
 
-	return regionTotal;
+/**
+ *  Get a map of the amount of missions done in each region.
+ *  @param MissionStatistics
+ */
+std::map<std::string, int> SoldierDiary::getRegionTotal(std::vector<MissionStatistics*> *missionStatistics) const
+{
+	return getMissionTotals(missionStatistics).region;
 }
 
 /**
@@ -733,20 +795,7 @@ std::map<std::string, int> SoldierDiary::getRegionTotal(std::vector<MissionStati
  */
 std::map<std::string, int> SoldierDiary::getCountryTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> countryTotal;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				countryTotal[ms->country]++;
-			}
-		}
-	}
-
-	return countryTotal;
+	return getMissionTotals(missionStatistics).country;
 }
 
 /**
@@ -755,20 +804,7 @@ std::map<std::string, int> SoldierDiary::getCountryTotal(std::vector<MissionStat
  */
 std::map<std::string, int> SoldierDiary::getTypeTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> typeTotal;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				typeTotal[ms->type]++;
-			}
-		}
-	}
-
-	return typeTotal;
+	return getMissionTotals(missionStatistics).type;
 }
 
 /**
@@ -777,20 +813,7 @@ std::map<std::string, int> SoldierDiary::getTypeTotal(std::vector<MissionStatist
  */
 std::map<std::string, int> SoldierDiary::getUFOTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> ufoTotal;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				ufoTotal[ms->ufo]++;
-			}
-		}
-	}
-
-	return ufoTotal;
+	return getMissionTotals(missionStatistics).ufo;
 }
 
 /**
@@ -827,17 +850,11 @@ int SoldierDiary::getMissionTotalFiltered(std::vector<MissionStatistics*>* missi
 	if (!rule->getMissionTypeNames().empty())
 	{
 		int total = 0;
-		for (const auto* ms : *missionStatistics)
+		for (const auto& pair : getMissionTotals(missionStatistics).successType)
 		{
-			if (ms->success)
+			if (std::find(rule->getMissionTypeNames().begin(), rule->getMissionTypeNames().end(), pair.first) != rule->getMissionTypeNames().end())
 			{
-				if (std::find(_missionIdList.begin(), _missionIdList.end(), ms->id) != _missionIdList.end())
-				{
-					if (std::find(rule->getMissionTypeNames().begin(), rule->getMissionTypeNames().end(), ms->type) != rule->getMissionTypeNames().end())
-					{
-						++total;
-					}
-				}
+				total += pair.second;
 			}
 		}
 		return total;
@@ -845,17 +862,11 @@ int SoldierDiary::getMissionTotalFiltered(std::vector<MissionStatistics*>* missi
 	else if (!rule->getMissionMarkerNames().empty())
 	{
 		int total = 0;
-		for (const auto* ms : *missionStatistics)
+		for (const auto& pair : getMissionTotals(missionStatistics).successMarker)
 		{
-			if (ms->success)
+			if (std::find(rule->getMissionMarkerNames().begin(), rule->getMissionMarkerNames().end(), pair.first) != rule->getMissionMarkerNames().end())
 			{
-				if (std::find(_missionIdList.begin(), _missionIdList.end(), ms->id) != _missionIdList.end())
-				{
-					if (std::find(rule->getMissionMarkerNames().begin(), rule->getMissionMarkerNames().end(), ms->markerName) != rule->getMissionMarkerNames().end())
-					{
-						++total;
-					}
-				}
+				total += pair.second;
 			}
 		}
 		return total;
@@ -870,23 +881,7 @@ int SoldierDiary::getMissionTotalFiltered(std::vector<MissionStatistics*>* missi
  */
 int SoldierDiary::getWinTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int winTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int missionId : _missionIdList)
-		{
-			if (missionId == ms->id)
-			{
-				if (ms->success)
-				{
-					winTotal++;
-				}
-			}
-		}
-	}
-
-	return winTotal;
+	return getMissionTotals(missionStatistics).win;
 }
 
 /**
@@ -1071,23 +1066,7 @@ int SoldierDiary::getTrapKillTotal(Mod *mod) const
 int SoldierDiary::getTerrorMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
 	/// Not a UFO, not the base, not the alien base or colony
-	int terrorMissionTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && !ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
-				{
-					terrorMissionTotal++;
-				}
-			}
-		}
-	}
-
-	return terrorMissionTotal;
+	return getMissionTotals(missionStatistics).terror;
 }
 
 /**
@@ -1098,17 +1077,11 @@ int SoldierDiary::getNightMissionTotal(std::vector<MissionStatistics*> *missionS
 {
 	int nightMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto& pair : getMissionTotals(missionStatistics).nightByDaylight)
 	{
-		for (int misionId : _missionIdList)
+		if (pair.first > mod->getMaxDarknessToSeeUnits())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isDarkness(mod) && !ms->isBaseDefense() && !ms->isAlienBase())
-				{
-					nightMissionTotal++;
-				}
-			}
+			nightMissionTotal += pair.second;
 		}
 	}
 
@@ -1123,17 +1096,11 @@ int SoldierDiary::getNightTerrorMissionTotal(std::vector<MissionStatistics*> *mi
 {
 	int nightTerrorMissionTotal = 0;
 
-	for (const auto* ms : *missionStatistics)
+	for (const auto& pair : getMissionTotals(missionStatistics).nightTerrorByDaylight)
 	{
-		for (int misionId : _missionIdList)
+		if (pair.first > mod->getMaxDarknessToSeeUnits())
 		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isDarkness(mod) && !ms->isBaseDefense() && !ms->isUfoMission() && !ms->isAlienBase())
-				{
-					nightTerrorMissionTotal++;
-				}
-			}
+			nightTerrorMissionTotal += pair.second;
 		}
 	}
 
@@ -1146,23 +1113,7 @@ int SoldierDiary::getNightTerrorMissionTotal(std::vector<MissionStatistics*> *mi
  */
 int SoldierDiary::getBaseDefenseMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int baseDefenseMissionTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isBaseDefense())
-				{
-					baseDefenseMissionTotal++;
-				}
-			}
-		}
-	}
-
-	return baseDefenseMissionTotal;
+	return getMissionTotals(missionStatistics).baseDefense;
 }
 
 /**
@@ -1171,23 +1122,7 @@ int SoldierDiary::getBaseDefenseMissionTotal(std::vector<MissionStatistics*> *mi
  */
 int SoldierDiary::getAlienBaseAssaultTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int alienBaseAssaultTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->isAlienBase())
-				{
-					alienBaseAssaultTotal++;
-				}
-			}
-		}
-	}
-
-	return alienBaseAssaultTotal;
+	return getMissionTotals(missionStatistics).alienBase;
 }
 
 /**
@@ -1196,23 +1131,7 @@ int SoldierDiary::getAlienBaseAssaultTotal(std::vector<MissionStatistics*> *miss
  */
 int SoldierDiary::getImportantMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int importantMissionTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				if (ms->success && ms->type != "STR_UFO_CRASH_RECOVERY")
-				{
-					importantMissionTotal++;
-				}
-			}
-		}
-	}
-
-	return importantMissionTotal;
+	return getMissionTotals(missionStatistics).important;
 }
 
 /**
@@ -1221,20 +1140,7 @@ int SoldierDiary::getImportantMissionTotal(std::vector<MissionStatistics*> *miss
  */
 int SoldierDiary::getScoreTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int scoreTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				scoreTotal += ms->score;
-			}
-		}
-	}
-
-	return scoreTotal;
+	return getMissionTotals(missionStatistics).score;
 }
 
 /**
@@ -1243,20 +1149,7 @@ int SoldierDiary::getScoreTotal(std::vector<MissionStatistics*> *missionStatisti
  */
 int SoldierDiary::getValiantCruxTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int valiantCruxTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id && ms->valiantCrux)
-			{
-				valiantCruxTotal++;
-			}
-		}
-	}
-
-	return valiantCruxTotal;
+	return getMissionTotals(missionStatistics).valiantCrux;
 }
 
 /**
@@ -1265,20 +1158,7 @@ int SoldierDiary::getValiantCruxTotal(std::vector<MissionStatistics*> *missionSt
  */
 int SoldierDiary::getLootValueTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int lootValueTotal = 0;
-
-	for (const auto* ms : *missionStatistics)
-	{
-		for (int misionId : _missionIdList)
-		{
-			if (misionId == ms->id)
-			{
-				lootValueTotal += ms->lootValue;
-			}
-		}
-	}
-
-	return lootValueTotal;
+	return getMissionTotals(missionStatistics).lootValue;
 }
 
 /**
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <set>
 #include <yaml-cpp/yaml.h>
 #include "BattleUnit.h"
 #include "SavedGame.h"
@@ -85,6 +86,26 @@ private:
 		_woundsHealedTotal, _allUFOs, _allMissionTypes, _statGainTotal, _revivedUnitTotal, _wholeMedikitTotal, _braveryGainTotal, _bestOfRank, _MIA,
 		_martyrKillsTotal, _postMortemKills, _slaveKillsTotal, _bestSoldier, _revivedSoldierTotal, _revivedHostileTotal, _revivedNeutralTotal;
 	bool _globeTrotter;
+
+	/// Running totals over the missions in the mission id list.
+	struct MissionTotals
+	{
+		std::map<std::string, int> region, country, type, ufo;
+		/// Won missions by type and by marker, counting a mission listed twice only once.
+		std::map<std::string, int> successType, successMarker;
+		std::map<int, int> nightByDaylight, nightTerrorByDaylight;
+		/// Missions already counted in successType and successMarker.
+		std::set<int> ids;
+		int win, score, terror, baseDefense, alienBase, important, valiantCrux, lootValue;
+		MissionTotals() : win(0), score(0), terror(0), baseDefense(0), alienBase(0), important(0), valiantCrux(0), lootValue(0) { }
+	};
+	mutable MissionTotals _missionTotals;
+	mutable size_t _missionTotalsCount;
+	/// Size of the statistics list when a mission was missing from it.
+	mutable size_t _missionTotalsStatistics;
+	mutable bool _missionTotalsMissing;
+	/// Adds the missions that are not in the running totals yet, and gets the totals.
+	const MissionTotals &getMissionTotals(const std::vector<MissionStatistics*> *missionStatistics) const;
 public:
 	/// Construct a diary.
 	SoldierDiary();
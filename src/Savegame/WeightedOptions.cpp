@@ -18,32 +18,93 @@
  */
 #include "WeightedOptions.h"
 #include "../Engine/RNG.h"
+#include "../Engine/Options.h"
+#include <algorithm>
 
 namespace OpenXcom
 {
 
+/**
+ * Builds the lookup tables of choose() from the current weights.
+ * The alias tables are made with Vose's method, in integers, so that
+ * every column holds exactly _totalWeight units of probability.
+ */
+void WeightedOptions::build() const
+{
+	const size_t n = _choices.size();
+	_sampler.reset();
+	_sampler.ids.reserve(n);
+	_sampler.cumulative.reserve(n);
+	size_t sum = 0;
+	for (const auto& pair : _choices)
+	{
+		sum += pair.second;
+		_sampler.ids.push_back(&pair.first);
+		_sampler.cumulative.push_back(sum);
+	}
+
+	std::vector<size_t> scaled;
+	std::vector<size_t> small, large;
+	scaled.reserve(n);
+	size_t i = 0;
+	for (const auto& pair : _choices)
+	{
+		scaled.push_back(pair.second * n);
+		(scaled.back() < _totalWeight ? small : large).push_back(i);
+		++i;
+	}
+	_sampler.threshold.assign(n, _totalWeight);
+	_sampler.alias.resize(n);
+	for (size_t j = 0; j < n; ++j)
+	{
+		_sampler.alias[j] = j;
+	}
+	while (!small.empty() && !large.empty())
+	{
+		size_t s = small.back();
+		size_t l = large.back();
+		small.pop_back();
+		large.pop_back();
+		_sampler.threshold[s] = scaled[s];
+		_sampler.alias[s] = l;
+		scaled[l] = scaled[l] + scaled[s] - _totalWeight;
+		(scaled[l] < _totalWeight ? small : large).push_back(l);
+	}
+	// whatever is left holds a full column
+}
+
 /**
  * Select a random choice from among the contents.
  * This MUST be called on non-empty objects.
  * Each time this is called, the returned value can be different.
- * @return The key of the selected choice.
+ * By default the choice takes one random number and gives the same
+ * results as the original linear walk over the options (found by binary
+ * search now). With the oxceAliasWeightedChoice option the alias method
+ * is used instead, constant time but a different random sequence.
+ * @return The key of the selected choice, valid until the options change.
  */
-std::string WeightedOptions::choose() const
+const std::string &WeightedOptions::choose() const
 {
+	static const std::string none;
 	if (_totalWeight == 0)
 	{
-		return "";
+		return none;
 	}
-	size_t var = RNG::generate(0, _totalWeight);
-	auto ii = _choices.begin();
-	for (; ii != _choices.end(); ++ii)
+	if (_sampler.ids.empty())
 	{
-		if (var <= ii->second)
-			break;
-		var -= ii->second;
+		build();
 	}
+	if (Options::oxceAliasWeightedChoice)
+	{
+		size_t column = RNG::generate(0, (int)_sampler.ids.size() - 1);
+		size_t var = RNG::generate(0, (int)_totalWeight - 1);
+		return *_sampler.ids[var < _sampler.threshold[column] ? column : _sampler.alias[column]];
+	}
+	size_t var = RNG::generate(0, _totalWeight);
+	// first option whose running total reaches var, like walking the list and subtracting
+	auto ii = std::lower_bound(_sampler.cumulative.begin(), _sampler.cumulative.end(), var);
 	// We always have a valid iterator here.
-	return ii->first;
+	return *_sampler.ids[ii - _sampler.cumulative.begin()];
 }
 
 /**
@@ -56,6 +117,7 @@ std::string WeightedOptions::choose() const
  */
 void WeightedOptions::set(const std::string &id, size_t weight)
 {
+	_sampler.reset();
 	auto option = _choices.find(id);
 	if (option != _choices.end())
 	{
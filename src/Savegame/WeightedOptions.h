@@ -36,13 +36,13 @@ public:
 	/// Create an empty set.
 	WeightedOptions() : _totalWeight(0) { /* Empty by design. */ }
 	/// Select from among the items.
-	std::string choose() const;
+	const std::string &choose() const;
 	/// Set an option's weight.
 	void set(const std::string &id, size_t weight);
 	/// Is this empty?
 	bool empty() const { return 0 == _totalWeight; }
 	/// Remove all entries.
-	void clear() { _totalWeight = 0; _choices.clear(); }
+	void clear() { _totalWeight = 0; _choices.clear(); _sampler.reset(); }
 	/// Update our list with data from YAML.
 	void load(const YAML::Node &node);
 	/// Store our list in YAML.
@@ -50,8 +50,30 @@ public:
 	/// Get the list of strings associated with these weights.
 	std::vector<std::string> getNames();
 private:
+	/**
+	 * Lookup tables for choose(), built on first use after the weights change.
+	 * Copies start empty, the tables point into the map of their owner.
+	 */
+	struct Sampler
+	{
+		std::vector<const std::string*> ids; //!< Options in map order.
+		std::vector<size_t> cumulative; //!< Running total of the weights, for the compatible choice.
+		std::vector<size_t> threshold; //!< Alias method: keep the column below this value...
+		std::vector<size_t> alias; //!< ...otherwise take this option.
+
+		Sampler() = default;
+		Sampler(const Sampler&) { }
+		Sampler &operator=(const Sampler&) { reset(); return *this; }
+		/// Forget the tables.
+		void reset() { ids.clear(); cumulative.clear(); threshold.clear(); alias.clear(); }
+	};
+
 	std::map<std::string, size_t> _choices; //!< Options and weights
 	size_t _totalWeight; //!< The total weight of all options.
+	mutable Sampler _sampler; //!< Lookup tables for choose().
+
+	/// Builds the lookup tables.
+	void build() const;
 };
 
 }
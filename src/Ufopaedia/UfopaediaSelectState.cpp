@@ -218,7 +218,6 @@ namespace OpenXcom
 		Ufopaedia::list(_game->getSavedGame(), _game->getMod(), _section, _article_list);
 		_filtered_article_list.clear();
 
-		int row = 0;
 		bool hasUnseen = false;
 		for (auto* articleDef : _article_list)
 		{
@@ -253,7 +252,6 @@ namespace OpenXcom
 			}
 
 			_filtered_article_list.push_back(articleDef);
-			_lstSelection->addRow(1, tr(articleDef->getMainTitle()).c_str());
 
 			if (markAllAsSeen)
 			{
@@ -262,13 +260,22 @@ namespace OpenXcom
 			}
 			else if (_game->getSavedGame()->getUfopediaRuleStatus(articleDef->id) == ArticleDefinition::PEDIA_STATUS_NEW)
 			{
-				// highlight as new
-				_lstSelection->setCellColor(row, 0, _colorNew);
 				hasUnseen = true;
 			}
-			row++;
 		}
 
+		// mods can have thousands of articles, only create the visible rows
+		_lstSelection->setVirtualRows(_filtered_article_list.size(), [this](size_t row, TextListRow &out)
+		{
+			ArticleDefinition *articleDef = _filtered_article_list[row];
+			out.cells = { tr(articleDef->getMainTitle()) };
+			if (_game->getSavedGame()->getUfopediaRuleStatus(articleDef->id) == ArticleDefinition::PEDIA_STATUS_NEW)
+			{
+				// highlight as new
+				out.color = _colorNew;
+			}
+		});
+
 		if (isCommendationsSection)
 		{
 			_btnShowOnlyNew->setText(tr("STR_NOT_AWARDED_YET"));